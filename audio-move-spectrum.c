@@ -0,0 +1,158 @@
+#include "audio-move-spectrum.h"
+#include <graphics/math-defs.h>
+#include <util/threading.h>
+#include <string.h>
+
+struct audio_move_spectrum *audio_move_spectrum_create(size_t size, size_t channels, uint32_t sample_rate)
+{
+	struct audio_move_spectrum *spectrum = bzalloc(sizeof(struct audio_move_spectrum));
+	spectrum->size = size;
+	spectrum->half = size / 2;
+	spectrum->bins_num = spectrum->half + 1;
+	spectrum->channels = channels;
+	spectrum->sample_rate = sample_rate;
+
+	// one block for all float arrays so the fft walks memory that was allocated together
+	const size_t half = spectrum->half;
+	const size_t bins_num = spectrum->bins_num;
+	float *block = bzalloc(sizeof(float) * (size * 3 + half * 3 + bins_num * 4));
+	spectrum->ring = block;
+	spectrum->window = spectrum->ring + size;
+	spectrum->frame = spectrum->window + size;
+	spectrum->tw_re = spectrum->frame + size;
+	spectrum->tw_im = spectrum->tw_re + half / 2;
+	spectrum->re = spectrum->tw_im + half / 2;
+	spectrum->im = spectrum->re + half;
+	spectrum->split_re = spectrum->im + half;
+	spectrum->split_im = spectrum->split_re + bins_num;
+	spectrum->power = spectrum->split_im + bins_num;
+	spectrum->bins = spectrum->power + bins_num;
+	spectrum->rev = bzalloc(sizeof(uint32_t) * half);
+
+	for (size_t i = 0; i < size; i++)
+		spectrum->window[i] = (float)(0.5 - 0.5 * cos(2.0 * M_PI * (double)i / (double)size));
+	for (size_t i = 0; i < half / 2; i++) {
+		spectrum->tw_re[i] = (float)cos(-2.0 * M_PI * (double)i / (double)half);
+		spectrum->tw_im[i] = (float)sin(-2.0 * M_PI * (double)i / (double)half);
+	}
+	for (size_t k = 0; k < bins_num; k++) {
+		spectrum->split_re[k] = (float)cos(-2.0 * M_PI * (double)k / (double)size);
+		spectrum->split_im[k] = (float)sin(-2.0 * M_PI * (double)k / (double)size);
+	}
+	size_t bits = 0;
+	while (((size_t)1 << bits) < half)
+		bits++;
+	for (size_t i = 0; i < half; i++) {
+		size_t r = 0;
+		for (size_t b = 0; b < bits; b++) {
+			if (i & ((size_t)1 << b))
+				r |= (size_t)1 << (bits - 1 - b);
+		}
+		spectrum->rev[i] = (uint32_t)r;
+	}
+	return spectrum;
+}
+
+void audio_move_spectrum_destroy(struct audio_move_spectrum *spectrum)
+{
+	if (!spectrum)
+		return;
+	bfree(spectrum->ring);
+	bfree(spectrum->rev);
+	bfree(spectrum);
+}
+
+// real fft of the windowed frame, packed as a half size complex fft
+static void audio_move_spectrum_analyze(struct audio_move_spectrum *spectrum)
+{
+	const size_t size = spectrum->size;
+	const size_t half = spectrum->half;
+	for (size_t n = 0; n < size; n++)
+		spectrum->frame[n] = spectrum->ring[(spectrum->ring_pos + n) % size] * spectrum->window[n];
+
+	for (size_t n = 0; n < half; n++) {
+		const size_t r = spectrum->rev[n];
+		spectrum->re[r] = spectrum->frame[2 * n];
+		spectrum->im[r] = spectrum->frame[2 * n + 1];
+	}
+	for (size_t len = 2; len <= half; len <<= 1) {
+		const size_t half_len = len / 2;
+		const size_t step = half / len;
+		for (size_t i = 0; i < half; i += len) {
+			for (size_t j = 0; j < half_len; j++) {
+				const float wr = spectrum->tw_re[j * step];
+				const float wi = spectrum->tw_im[j * step];
+				const size_t a = i + j;
+				const size_t b = a + half_len;
+				const float tr = spectrum->re[b] * wr - spectrum->im[b] * wi;
+				const float ti = spectrum->re[b] * wi + spectrum->im[b] * wr;
+				spectrum->re[b] = spectrum->re[a] - tr;
+				spectrum->im[b] = spectrum->im[a] - ti;
+				spectrum->re[a] += tr;
+				spectrum->im[a] += ti;
+			}
+		}
+	}
+	// scaled so the square root of a band sum is the amplitude of a sine in that band
+	const float scale = 16.0f / (1.5f * (float)size * (float)size);
+	for (size_t k = 0; k < spectrum->bins_num; k++) {
+		const size_t k1 = k % half;
+		const size_t k2 = (half - k) % half;
+		const float er = 0.5f * (spectrum->re[k1] + spectrum->re[k2]);
+		const float ei = 0.5f * (spectrum->im[k1] - spectrum->im[k2]);
+		const float or = 0.5f * (spectrum->im[k1] + spectrum->im[k2]);
+		const float oi = -0.5f * (spectrum->re[k1] - spectrum->re[k2]);
+		const float xr = er + or * spectrum->split_re[k] - oi * spectrum->split_im[k];
+		const float xi = ei + or * spectrum->split_im[k] + oi * spectrum->split_re[k];
+		spectrum->power[k] = (xr * xr + xi * xi) * scale;
+	}
+
+	os_atomic_inc_long(&spectrum->sequence);
+	memcpy(spectrum->bins, spectrum->power, sizeof(float) * spectrum->bins_num);
+	spectrum->updates++;
+	os_atomic_inc_long(&spectrum->sequence);
+}
+
+void audio_move_spectrum_capture(struct audio_move_spectrum *spectrum, const struct audio_data *audio_data, bool muted)
+{
+	const size_t channels = spectrum->channels ? spectrum->channels : 1;
+	for (uint32_t i = 0; i < audio_data->frames; i++) {
+		float v = 0.0f;
+		if (!muted) {
+			for (size_t ch = 0; ch < channels && ch < MAX_AUDIO_CHANNELS; ch++) {
+				if (audio_data->data[ch])
+					v += ((const float *)audio_data->data[ch])[i];
+			}
+			v /= (float)channels;
+		}
+		spectrum->ring[spectrum->ring_pos] = v;
+		spectrum->ring_pos = (spectrum->ring_pos + 1) % spectrum->size;
+		if (++spectrum->ring_new >= spectrum->half) {
+			spectrum->ring_new = 0;
+			audio_move_spectrum_analyze(spectrum);
+		}
+	}
+}
+
+float audio_move_spectrum_band(struct audio_move_spectrum *spectrum, double from, double to, uint64_t *updates)
+{
+	const double bin_width = (double)spectrum->sample_rate / (double)spectrum->size;
+	size_t k_from = bin_width > 0.0 && from > 0.0 ? (size_t)(from / bin_width + 0.5) : 1;
+	size_t k_to = bin_width > 0.0 && to > 0.0 ? (size_t)(to / bin_width + 0.5) : spectrum->bins_num - 1;
+	if (k_from < 1)
+		k_from = 1;
+	if (k_to >= spectrum->bins_num)
+		k_to = spectrum->bins_num - 1;
+	long sequence;
+	float sum;
+	do {
+		sequence = os_atomic_load_long(&spectrum->sequence);
+		if (sequence & 1)
+			continue;
+		sum = 0.0f;
+		for (size_t k = k_from; k <= k_to; k++)
+			sum += spectrum->bins[k];
+		*updates = spectrum->updates;
+	} while ((sequence & 1) || os_atomic_load_long(&spectrum->sequence) != sequence);
+	return sqrtf(sum);
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <obs.h>
+
+// mono mix of the captured audio in a ring, a Hann-windowed real fft runs every half window
+struct audio_move_spectrum {
+	size_t size;
+	size_t half;
+	size_t bins_num;
+	float *ring;
+	size_t ring_pos;
+	size_t ring_new;
+	size_t channels;
+	uint32_t sample_rate;
+
+	float *window;
+	float *tw_re;
+	float *tw_im;
+	float *split_re;
+	float *split_im;
+	uint32_t *rev;
+	float *frame;
+	float *re;
+	float *im;
+	float *power;
+
+	volatile long sequence;
+	float *bins;
+	uint64_t updates;
+};
+
+// size is a power of two, everything the audio thread needs is allocated here
+struct audio_move_spectrum *audio_move_spectrum_create(size_t size, size_t channels, uint32_t sample_rate);
+void audio_move_spectrum_destroy(struct audio_move_spectrum *spectrum);
+void audio_move_spectrum_capture(struct audio_move_spectrum *spectrum, const struct audio_data *audio_data, bool muted);
+// square root of the power summed over the bins from..to Hz, the amplitude of a sine in that band
+float audio_move_spectrum_band(struct audio_move_spectrum *spectrum, double from, double to, uint64_t *updates);
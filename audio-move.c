@@ -1,14 +1,26 @@
 #include "move-transition.h"
+#include "audio-move-spectrum.h"
 
 #include <float.h>
+#include <stdio.h>
 #include <obs-module.h>
 #include <obs-frontend-api.h>
+#include <util/threading.h>
 
 #define METER_TYPE_MAGNITUDE 0
 #define METER_TYPE_PEAK_SAMPLE 1
 #define METER_TYPE_PEAK_TRUE 2
 #define METER_TYPE_INPUT_PEAK_SAMPLE 3
 #define METER_TYPE_INPUT_PEAK_TRUE 4
+#define METER_TYPE_BAND_BASS 5
+#define METER_TYPE_BAND_MID 6
+#define METER_TYPE_BAND_TREBLE 7
+#define METER_TYPE_BAND_CUSTOM 8
+
+#define AUDIO_FFT_SIZE 1024
+
+#define CHANNEL_MAX -1
+#define CHANNEL_AVERAGE -2
 
 #define VALUE_ACTION_TRANSFORM 0
 #define VALUE_ACTION_SETTING 1
@@ -39,21 +51,66 @@
 #define TRANSFORM_CROP_HORIZONTAL 12
 #define TRANSFORM_CROP_VERTICAL 13
 
+struct audio_move_features {
+	float magnitude[MAX_AUDIO_CHANNELS];
+	float peak[MAX_AUDIO_CHANNELS];
+	float input_peak[MAX_AUDIO_CHANNELS];
+	uint64_t updates;
+};
+
+// one volmeter per source and peak meter type, shared by all audio move filters on it
+struct audio_move_analysis {
+	obs_weak_source_t *source;
+	enum obs_peak_meter_type peak_meter_type;
+	obs_volmeter_t *volmeter;
+	long refs;
+	volatile long sequence;
+	struct audio_move_features features;
+	struct audio_move_spectrum *spectrum;
+};
+
+static DARRAY(struct audio_move_analysis *) audio_move_analyses;
+static pthread_mutex_t audio_move_analyses_mutex;
+
 struct audio_move_info {
 	obs_source_t *source;
-	double easing;
+	// swapped by update on the UI thread under analysis_mutex, which the tick holds while reading it
+	pthread_mutex_t analysis_mutex;
+	struct audio_move_analysis *analysis;
+	uint64_t analysis_updates;
+	long long channel;
+	double band_from;
+	double band_to;
+	double attack;
+	double release;
+	double audio_target;
 	double audio_value;
 	double base_value;
 	double factor;
 	long long action;
 	long long threshold_action;
 	double threshold;
+	double hysteresis;
+	float hold;
+	float threshold_time;
+	bool threshold_over;
+	bool threshold_known;
 
 	obs_sceneitem_t *sceneitem;
 	obs_weak_source_t *target_source;
+	obs_weak_source_t *pending_source;
+	volatile bool resolve;
+	bool pending;
 	char *setting_name;
+	bool setting_resolved;
+	bool setting_number;
+	enum obs_data_number_type setting_type;
+	bool setting_pushed;
+	double setting_value;
+	double setting_epsilon;
+	float setting_interval;
+	float setting_elapsed;
 
-	obs_volmeter_t *volmeter;
 	long long meter_type;
 	long long transform;
 };
@@ -64,20 +121,170 @@ static const char *audio_move_get_name(void *type_data)
 	return obs_module_text("AudioMoveFilter");
 }
 
-void audio_move_volmeter_updated(void *data, const float magnitude[MAX_AUDIO_CHANNELS], const float peak[MAX_AUDIO_CHANNELS],
-				 const float input_peak[MAX_AUDIO_CHANNELS])
+static void audio_move_volmeter_updated(void *data, const float magnitude[MAX_AUDIO_CHANNELS],
+					const float peak[MAX_AUDIO_CHANNELS], const float input_peak[MAX_AUDIO_CHANNELS])
 {
-	struct audio_move_info *audio_move = data;
+	struct audio_move_analysis *analysis = data;
+	// seqlock, odd while the audio thread is writing
+	os_atomic_inc_long(&analysis->sequence);
+	memcpy(analysis->features.magnitude, magnitude, sizeof(analysis->features.magnitude));
+	memcpy(analysis->features.peak, peak, sizeof(analysis->features.peak));
+	memcpy(analysis->features.input_peak, input_peak, sizeof(analysis->features.input_peak));
+	analysis->features.updates++;
+	os_atomic_inc_long(&analysis->sequence);
+}
+
+static void audio_move_analysis_read(struct audio_move_analysis *analysis, struct audio_move_features *features)
+{
+	long sequence;
+	do {
+		sequence = os_atomic_load_long(&analysis->sequence);
+		if (sequence & 1)
+			continue;
+		memcpy(features, &analysis->features, sizeof(struct audio_move_features));
+	} while ((sequence & 1) || os_atomic_load_long(&analysis->sequence) != sequence);
+}
+
+static void audio_move_audio_captured(void *param, obs_source_t *source, const struct audio_data *audio_data, bool muted)
+{
+	UNUSED_PARAMETER(source);
+	audio_move_spectrum_capture(param, audio_data, muted);
+}
+
+static struct audio_move_analysis *audio_move_analysis_get(obs_source_t *source, enum obs_peak_meter_type peak_meter_type,
+							   bool spectrum)
+{
+	struct audio_move_analysis *analysis = NULL;
+	pthread_mutex_lock(&audio_move_analyses_mutex);
+	for (size_t i = 0; i < audio_move_analyses.num; i++) {
+		struct audio_move_analysis *a = audio_move_analyses.array[i];
+		if (a->peak_meter_type == peak_meter_type && obs_weak_source_references_source(a->source, source)) {
+			analysis = a;
+			break;
+		}
+	}
+	if (!analysis) {
+		analysis = bzalloc(sizeof(struct audio_move_analysis));
+		analysis->source = obs_source_get_weak_source(source);
+		analysis->peak_meter_type = peak_meter_type;
+		analysis->volmeter = obs_volmeter_create(OBS_FADER_LOG);
+		obs_volmeter_set_peak_meter_type(analysis->volmeter, peak_meter_type);
+		obs_volmeter_add_callback(analysis->volmeter, audio_move_volmeter_updated, analysis);
+		obs_volmeter_attach_source(analysis->volmeter, source);
+		da_push_back(audio_move_analyses, &analysis);
+	}
+	if (spectrum && !analysis->spectrum) {
+		audio_t *audio = obs_get_audio();
+		analysis->spectrum = audio_move_spectrum_create(AUDIO_FFT_SIZE, audio_output_get_channels(audio),
+								audio_output_get_sample_rate(audio));
+		obs_source_add_audio_capture_callback(source, audio_move_audio_captured, analysis->spectrum);
+	}
+	analysis->refs++;
+	pthread_mutex_unlock(&audio_move_analyses_mutex);
+	return analysis;
+}
+
+static void audio_move_analysis_release(struct audio_move_analysis *analysis)
+{
+	if (!analysis)
+		return;
+	pthread_mutex_lock(&audio_move_analyses_mutex);
+	if (--analysis->refs > 0) {
+		pthread_mutex_unlock(&audio_move_analyses_mutex);
+		return;
+	}
+	da_erase_item(audio_move_analyses, &analysis);
+	pthread_mutex_unlock(&audio_move_analyses_mutex);
+	obs_volmeter_remove_callback(analysis->volmeter, audio_move_volmeter_updated, analysis);
+	obs_volmeter_detach_source(analysis->volmeter);
+	obs_volmeter_destroy(analysis->volmeter);
+	if (analysis->spectrum) {
+		obs_source_t *source = obs_weak_source_get_source(analysis->source);
+		if (source) {
+			obs_source_remove_audio_capture_callback(source, audio_move_audio_captured, analysis->spectrum);
+			obs_source_release(source);
+		}
+		audio_move_spectrum_destroy(analysis->spectrum);
+	}
+	obs_weak_source_release(analysis->source);
+	bfree(analysis);
+}
+
+static float audio_move_channel_value(const float *db, long long channel, uint32_t channels)
+{
+	if (channel >= 0)
+		return obs_db_to_mul(db[channel < MAX_AUDIO_CHANNELS ? channel : 0]);
+	if (!channels)
+		channels = 1;
+	if (channels > MAX_AUDIO_CHANNELS)
+		channels = MAX_AUDIO_CHANNELS;
+	float v = 0.0f;
+	for (uint32_t i = 0; i < channels; i++) {
+		const float mul = obs_db_to_mul(db[i]);
+		if (channel == CHANNEL_AVERAGE)
+			v += mul / (float)channels;
+		else if (mul > v)
+			v = mul;
+	}
+	return v;
+}
+
+static void audio_move_analysis_update(struct audio_move_info *audio_move)
+{
+	if (!audio_move->analysis)
+		return;
+	if (audio_move->meter_type >= METER_TYPE_BAND_BASS) {
+		if (!audio_move->analysis->spectrum)
+			return;
+		uint64_t spectrum_updates = 0;
+		const float v = audio_move_spectrum_band(audio_move->analysis->spectrum, audio_move->band_from,
+							 audio_move->band_to, &spectrum_updates);
+		if (spectrum_updates == audio_move->analysis_updates)
+			return;
+		audio_move->analysis_updates = spectrum_updates;
+		audio_move->audio_target = v;
+		return;
+	}
+	struct audio_move_features features;
+	audio_move_analysis_read(audio_move->analysis, &features);
+	if (features.updates == audio_move->analysis_updates)
+		return;
+	audio_move->analysis_updates = features.updates;
+
+	const uint32_t channels = (uint32_t)obs_volmeter_get_nr_channels(audio_move->analysis->volmeter);
 	float v = 0.0f;
 	if (audio_move->meter_type == METER_TYPE_MAGNITUDE) {
-		v = magnitude[0];
+		v = audio_move_channel_value(features.magnitude, audio_move->channel, channels);
 	} else if (audio_move->meter_type == METER_TYPE_INPUT_PEAK_SAMPLE || audio_move->meter_type == METER_TYPE_INPUT_PEAK_TRUE) {
-		v = input_peak[0];
+		v = audio_move_channel_value(features.input_peak, audio_move->channel, channels);
 	} else if (audio_move->meter_type == METER_TYPE_PEAK_SAMPLE || audio_move->meter_type == METER_TYPE_PEAK_TRUE) {
-		v = peak[0];
+		v = audio_move_channel_value(features.peak, audio_move->channel, channels);
+	}
+	audio_move->audio_target = v;
+}
+
+static void audio_move_envelope(struct audio_move_info *audio_move, float seconds)
+{
+	const double time_constant = audio_move->audio_target > audio_move->audio_value ? audio_move->attack
+											 : audio_move->release;
+	if (time_constant <= 0.0 || seconds <= 0.0f) {
+		audio_move->audio_value = audio_move->audio_target;
+	} else {
+		const double coefficient = 1.0 - exp(-(double)seconds / time_constant);
+		audio_move->audio_value += coefficient * (audio_move->audio_target - audio_move->audio_value);
+	}
+
+	// hysteresis and minimum hold time, so the threshold state only flips on real changes
+	audio_move->threshold_time += seconds;
+	const bool over = audio_move->threshold_over ? audio_move->audio_value >= audio_move->threshold - audio_move->hysteresis
+						     : audio_move->audio_value >= audio_move->threshold;
+	if (!audio_move->threshold_known) {
+		audio_move->threshold_over = audio_move->audio_value >= audio_move->threshold;
+		audio_move->threshold_time = 0.0f;
+	} else if (over != audio_move->threshold_over && audio_move->threshold_time >= audio_move->hold) {
+		audio_move->threshold_over = over;
+		audio_move->threshold_time = 0.0f;
 	}
-	v = obs_db_to_mul(v);
-	audio_move->audio_value = audio_move->easing * audio_move->audio_value + (1.0 - audio_move->easing) * v;
 }
 
 void audio_move_source_destroy(void *data, calldata_t *call_data)
@@ -86,6 +293,7 @@ void audio_move_source_destroy(void *data, calldata_t *call_data)
 	struct audio_move_info *audio_move = data;
 	audio_move->target_source = NULL;
 	audio_move->sceneitem = NULL;
+	os_atomic_set_bool(&audio_move->resolve, true);
 }
 
 void audio_move_item_remove(void *data, calldata_t *call_data);
@@ -125,6 +333,7 @@ void audio_move_source_remove(void *data, calldata_t *call_data)
 		}
 	}
 	audio_move->sceneitem = NULL;
+	os_atomic_set_bool(&audio_move->resolve, true);
 }
 
 void audio_move_item_remove(void *data, calldata_t *call_data)
@@ -136,6 +345,7 @@ void audio_move_item_remove(void *data, calldata_t *call_data)
 	calldata_get_ptr(call_data, "item", &item);
 	if (item == audio_move->sceneitem) {
 		audio_move->sceneitem = NULL;
+		os_atomic_set_bool(&audio_move->resolve, true);
 		obs_source_t *parent = obs_scene_get_source(scene);
 		if (parent) {
 			signal_handler_t *sh = obs_source_get_signal_handler(parent);
@@ -148,24 +358,80 @@ void audio_move_item_remove(void *data, calldata_t *call_data)
 	}
 }
 
+static void audio_move_target_changed(void *data, calldata_t *call_data)
+{
+	UNUSED_PARAMETER(call_data);
+	struct audio_move_info *audio_move = data;
+	if (audio_move->pending)
+		os_atomic_set_bool(&audio_move->resolve, true);
+}
+
+static void audio_move_pending_source_clear(struct audio_move_info *audio_move)
+{
+	if (!audio_move->pending_source)
+		return;
+	obs_source_t *source = obs_weak_source_get_source(audio_move->pending_source);
+	if (source) {
+		signal_handler_t *sh = obs_source_get_signal_handler(source);
+		signal_handler_disconnect(sh, "item_add", audio_move_target_changed, audio_move);
+		signal_handler_disconnect(sh, "filter_add", audio_move_target_changed, audio_move);
+		obs_source_release(source);
+	}
+	obs_weak_source_release(audio_move->pending_source);
+	audio_move->pending_source = NULL;
+}
+
 void audio_move_update(void *data, obs_data_t *settings)
 {
 	struct audio_move_info *audio_move = data;
 
+	const long long meter_type = obs_data_get_int(settings, "meter_type");
+	const enum obs_peak_meter_type peak_meter_type =
+		meter_type == METER_TYPE_INPUT_PEAK_TRUE || meter_type == METER_TYPE_PEAK_TRUE ? TRUE_PEAK_METER
+											       : SAMPLE_PEAK_METER;
+	const bool spectrum = meter_type >= METER_TYPE_BAND_BASS;
 	obs_source_t *parent = obs_filter_get_parent(audio_move->source);
-	if (parent)
-		obs_volmeter_attach_source(audio_move->volmeter, parent);
+	struct audio_move_analysis *analysis = NULL;
+	if (parent && (!audio_move->analysis || audio_move->analysis->peak_meter_type != peak_meter_type ||
+		       (spectrum && !audio_move->analysis->spectrum) ||
+		       !obs_weak_source_references_source(audio_move->analysis->source, parent)))
+		analysis = audio_move_analysis_get(parent, peak_meter_type, spectrum);
 
-	const long long meter_type = obs_data_get_int(settings, "meter_type");
-	if (meter_type != audio_move->meter_type) {
-		audio_move->meter_type = meter_type;
-		if (meter_type == METER_TYPE_INPUT_PEAK_SAMPLE || meter_type == METER_TYPE_PEAK_SAMPLE) {
-			obs_volmeter_set_peak_meter_type(audio_move->volmeter, SAMPLE_PEAK_METER);
-		} else if (meter_type == METER_TYPE_INPUT_PEAK_TRUE || meter_type == METER_TYPE_PEAK_TRUE) {
-			obs_volmeter_set_peak_meter_type(audio_move->volmeter, TRUE_PEAK_METER);
-		}
+	pthread_mutex_lock(&audio_move->analysis_mutex);
+	audio_move->meter_type = meter_type;
+	audio_move->channel = obs_data_get_int(settings, "channel");
+	if (meter_type == METER_TYPE_BAND_BASS) {
+		audio_move->band_from = 20.0;
+		audio_move->band_to = 250.0;
+	} else if (meter_type == METER_TYPE_BAND_MID) {
+		audio_move->band_from = 250.0;
+		audio_move->band_to = 4000.0;
+	} else if (meter_type == METER_TYPE_BAND_TREBLE) {
+		audio_move->band_from = 4000.0;
+		audio_move->band_to = 20000.0;
+	} else {
+		audio_move->band_from = obs_data_get_double(settings, "band_from");
+		audio_move->band_to = obs_data_get_double(settings, "band_to");
+	}
+	if (analysis) {
+		struct audio_move_analysis *old_analysis = audio_move->analysis;
+		audio_move->analysis = analysis;
+		audio_move->analysis_updates = 0;
+		analysis = old_analysis;
 	}
-	audio_move->easing = obs_data_get_double(settings, "easing") / 100.0;
+	pthread_mutex_unlock(&audio_move->analysis_mutex);
+	// released once the tick can no longer be reading it
+	audio_move_analysis_release(analysis);
+	if (obs_data_has_user_value(settings, "easing")) {
+		// the old easing was applied per volmeter update, about every 1024 samples
+		const double easing = obs_data_get_double(settings, "easing") / 100.0;
+		const double time_constant = easing > 0.0 ? -1000.0 * 1024.0 / 48000.0 / log(easing) : 0.0;
+		obs_data_set_double(settings, "attack", time_constant);
+		obs_data_set_double(settings, "release", time_constant);
+		obs_data_unset_user_value(settings, "easing");
+	}
+	audio_move->attack = obs_data_get_double(settings, "attack") / 1000.0;
+	audio_move->release = obs_data_get_double(settings, "release") / 1000.0;
 	audio_move->action = obs_data_get_int(settings, "value_action");
 	audio_move->transform = obs_data_get_int(settings, "transform");
 	audio_move->base_value = obs_data_get_double(settings, "base_value");
@@ -202,11 +468,21 @@ void audio_move_update(void *data, obs_data_t *settings)
 			signal_handler_disconnect(sh, "destroy", audio_move_source_destroy, audio_move);
 		}
 	}
-	audio_move->sceneitem = scene ? obs_scene_find_source_recursive(scene, sceneitem_name) : NULL;
+	audio_move->sceneitem = scene ? move_scene_find_item(scene, sceneitem_name) : NULL;
+	if (!audio_move->sceneitem && scene)
+		audio_move->sceneitem = obs_scene_find_source_recursive(scene, sceneitem_name);
 	if (audio_move->sceneitem && obs_source_removed(obs_sceneitem_get_source(audio_move->sceneitem))) {
 		audio_move->sceneitem = NULL;
 	}
 
+	audio_move_pending_source_clear(audio_move);
+	if (!audio_move->sceneitem && scene &&
+	    (audio_move->action == VALUE_ACTION_TRANSFORM || audio_move->action == VALUE_ACTION_SOURCE_VISIBILITY)) {
+		// wait for the item to be added instead of searching the scene every frame
+		audio_move->pending_source = obs_source_get_weak_source(source);
+		signal_handler_connect(obs_source_get_signal_handler(source), "item_add", audio_move_target_changed, audio_move);
+	}
+
 	if (audio_move->sceneitem && source) {
 		signal_handler_t *sh = obs_source_get_signal_handler(source);
 		if (sh) {
@@ -240,6 +516,10 @@ void audio_move_update(void *data, obs_data_t *settings)
 			obs_source_t *filter = obs_source_get_filter_by_name(source, obs_data_get_string(settings, "filter"));
 			if (filter) {
 				target_source = filter;
+			} else if (!audio_move->pending_source) {
+				audio_move->pending_source = obs_source_get_weak_source(source);
+				signal_handler_connect(obs_source_get_signal_handler(source), "filter_add", audio_move_target_changed,
+						       audio_move);
 			}
 			obs_source_release(source);
 		}
@@ -272,19 +552,49 @@ void audio_move_update(void *data, obs_data_t *settings)
 	}
 	audio_move->threshold_action = obs_data_get_int(settings, "threshold_action");
 	audio_move->threshold = obs_data_get_double(settings, "threshold") / 100.0;
+	audio_move->hysteresis = obs_data_get_double(settings, "hysteresis") / 100.0;
+	audio_move->hold = (float)obs_data_get_int(settings, "hold") / 1000.0f;
+	audio_move->threshold_known = false;
 	const char *setting_name = obs_data_get_string(settings, "setting");
 	if (!audio_move->setting_name || strcmp(audio_move->setting_name, setting_name) != 0) {
 		bfree(audio_move->setting_name);
 		audio_move->setting_name = bstrdup(setting_name);
 	}
+	audio_move->setting_epsilon = obs_data_get_double(settings, "setting_epsilon");
+	const double rate = obs_data_get_double(settings, "setting_rate");
+	audio_move->setting_interval = rate > 0.0 ? (float)(1.0 / rate) : 0.0f;
+	audio_move->setting_resolved = false;
+	audio_move->setting_pushed = false;
+
+	if (audio_move->action == VALUE_ACTION_TRANSFORM || audio_move->action == VALUE_ACTION_SOURCE_VISIBILITY) {
+		audio_move->pending = !audio_move->sceneitem;
+	} else if (audio_move->action == VALUE_ACTION_FILTER_ENABLE) {
+		audio_move->pending = !audio_move->target_source;
+	} else if (audio_move->action == VALUE_ACTION_SETTING) {
+		audio_move->pending = !audio_move->target_source && audio_move->setting_name && strlen(audio_move->setting_name);
+	} else {
+		audio_move->pending = false;
+	}
+	os_atomic_set_bool(&audio_move->resolve, false);
+}
+
+static void audio_move_resolve(struct audio_move_info *audio_move)
+{
+	if (!os_atomic_set_bool(&audio_move->resolve, false))
+		return;
+	obs_data_t *settings = obs_source_get_settings(audio_move->source);
+	audio_move_update(audio_move, settings);
+	obs_data_release(settings);
 }
 
 static void *audio_move_create(obs_data_t *settings, obs_source_t *source)
 {
 	struct audio_move_info *audio_move = bzalloc(sizeof(struct audio_move_info));
 	audio_move->source = source;
-	audio_move->volmeter = obs_volmeter_create(OBS_FADER_LOG);
-	obs_volmeter_add_callback(audio_move->volmeter, audio_move_volmeter_updated, audio_move);
+	pthread_mutex_init(&audio_move->analysis_mutex, NULL);
+	signal_handler_t *sh = obs_get_signal_handler();
+	signal_handler_connect(sh, "source_create", audio_move_target_changed, audio_move);
+	signal_handler_connect(sh, "source_rename", audio_move_target_changed, audio_move);
 	audio_move_update(audio_move, settings);
 
 	return audio_move;
@@ -293,10 +603,13 @@ static void *audio_move_create(obs_data_t *settings, obs_source_t *source)
 static void audio_move_destroy(void *data)
 {
 	struct audio_move_info *audio_move = data;
-	obs_volmeter_detach_source(audio_move->volmeter);
-	obs_volmeter_remove_callback(audio_move->volmeter, audio_move_volmeter_updated, audio_move);
-	obs_volmeter_destroy(audio_move->volmeter);
-	audio_move->volmeter = NULL;
+	signal_handler_t *sh = obs_get_signal_handler();
+	signal_handler_disconnect(sh, "source_create", audio_move_target_changed, audio_move);
+	signal_handler_disconnect(sh, "source_rename", audio_move_target_changed, audio_move);
+	audio_move_pending_source_clear(audio_move);
+	audio_move_analysis_release(audio_move->analysis);
+	audio_move->analysis = NULL;
+	pthread_mutex_destroy(&audio_move->analysis_mutex);
 	if (audio_move->target_source) {
 		obs_source_t *source = obs_weak_source_get_source(audio_move->target_source);
 		if (source) {
@@ -423,10 +736,16 @@ static bool audio_move_action_changed(obs_properties_t *props, obs_property_t *p
 		obs_property_set_visible(transform, false);
 	}
 	obs_property_t *setting = obs_properties_get(props, "setting");
+	obs_property_t *setting_epsilon = obs_properties_get(props, "setting_epsilon");
+	obs_property_t *setting_rate = obs_properties_get(props, "setting_rate");
 	if (action == VALUE_ACTION_SETTING) {
 		obs_property_set_visible(setting, true);
+		obs_property_set_visible(setting_epsilon, true);
+		obs_property_set_visible(setting_rate, true);
 	} else {
 		obs_property_set_visible(setting, false);
+		obs_property_set_visible(setting_epsilon, false);
+		obs_property_set_visible(setting_rate, false);
 	}
 	return true;
 }
@@ -553,11 +872,26 @@ static bool audio_move_source_changed(void *data, obs_properties_t *props, obs_p
 	return true;
 }
 
+static bool audio_move_meter_type_changed(obs_properties_t *props, obs_property_t *property, obs_data_t *settings)
+{
+	UNUSED_PARAMETER(property);
+	const long long meter_type = obs_data_get_int(settings, "meter_type");
+	obs_property_set_visible(obs_properties_get(props, "band_from"), meter_type == METER_TYPE_BAND_CUSTOM);
+	obs_property_set_visible(obs_properties_get(props, "band_to"), meter_type == METER_TYPE_BAND_CUSTOM);
+	obs_property_set_visible(obs_properties_get(props, "channel"), meter_type < METER_TYPE_BAND_BASS);
+	return true;
+}
+
 static obs_properties_t *audio_move_properties(void *data)
 {
-	UNUSED_PARAMETER(data);
+	struct audio_move_info *audio_move = data;
 	obs_properties_t *ppts = obs_properties_create();
 
+	if (audio_move && audio_move->pending) {
+		obs_property_t *w = obs_properties_add_text(ppts, "pending", obs_module_text("TargetPending"), OBS_TEXT_INFO);
+		obs_property_text_set_info_type(w, OBS_TEXT_INFO_WARNING);
+	}
+
 	obs_property_t *p = obs_properties_add_list(ppts, "meter_type", obs_module_text("MeterType"), OBS_COMBO_TYPE_LIST,
 						    OBS_COMBO_FORMAT_INT);
 	obs_property_list_add_int(p, obs_module_text("MeterType.Magnitude"), METER_TYPE_MAGNITUDE);
@@ -565,8 +899,30 @@ static obs_properties_t *audio_move_properties(void *data)
 	obs_property_list_add_int(p, obs_module_text("MeterType.PeakTrue"), METER_TYPE_PEAK_TRUE);
 	obs_property_list_add_int(p, obs_module_text("MeterType.InputPeakSample"), METER_TYPE_INPUT_PEAK_SAMPLE);
 	obs_property_list_add_int(p, obs_module_text("MeterType.InputPeakTrue"), METER_TYPE_INPUT_PEAK_TRUE);
+	obs_property_list_add_int(p, obs_module_text("MeterType.BandBass"), METER_TYPE_BAND_BASS);
+	obs_property_list_add_int(p, obs_module_text("MeterType.BandMid"), METER_TYPE_BAND_MID);
+	obs_property_list_add_int(p, obs_module_text("MeterType.BandTreble"), METER_TYPE_BAND_TREBLE);
+	obs_property_list_add_int(p, obs_module_text("MeterType.BandCustom"), METER_TYPE_BAND_CUSTOM);
+	obs_property_set_modified_callback(p, audio_move_meter_type_changed);
 
-	p = obs_properties_add_float_slider(ppts, "easing", obs_module_text("Easing"), 0.0, 99.99, 0.01);
+	p = obs_properties_add_float(ppts, "band_from", obs_module_text("BandFrom"), 0.0, 24000.0, 1.0);
+	obs_property_float_set_suffix(p, " Hz");
+	p = obs_properties_add_float(ppts, "band_to", obs_module_text("BandTo"), 0.0, 24000.0, 1.0);
+	obs_property_float_set_suffix(p, " Hz");
+
+	p = obs_properties_add_list(ppts, "channel", obs_module_text("Channel"), OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
+	obs_property_list_add_int(p, obs_module_text("Channel.Max"), CHANNEL_MAX);
+	obs_property_list_add_int(p, obs_module_text("Channel.Average"), CHANNEL_AVERAGE);
+	for (long long i = 0; i < MAX_AUDIO_CHANNELS; i++) {
+		char name[64];
+		snprintf(name, sizeof(name), "%s %lld", obs_module_text("Channel"), i + 1);
+		obs_property_list_add_int(p, name, i);
+	}
+
+	p = obs_properties_add_float(ppts, "attack", obs_module_text("Attack"), 0.0, 10000.0, 1.0);
+	obs_property_float_set_suffix(p, " ms");
+	p = obs_properties_add_float(ppts, "release", obs_module_text("Release"), 0.0, 10000.0, 1.0);
+	obs_property_float_set_suffix(p, " ms");
 
 	p = obs_properties_add_list(ppts, "value_action", obs_module_text("ValueAction"), OBS_COMBO_TYPE_LIST,
 				    OBS_COMBO_FORMAT_INT);
@@ -612,6 +968,9 @@ static obs_properties_t *audio_move_properties(void *data)
 
 	p = obs_properties_add_float(ppts, "base_value", obs_module_text("BaseValue"), -DBL_MAX, DBL_MAX, 0.01);
 	p = obs_properties_add_float(ppts, "factor", obs_module_text("Factor"), -DBL_MAX, DBL_MAX, 0.01);
+	p = obs_properties_add_float(ppts, "setting_epsilon", obs_module_text("SettingEpsilon"), 0.0, DBL_MAX, 0.001);
+	p = obs_properties_add_float(ppts, "setting_rate", obs_module_text("SettingRate"), 0.0, 1000.0, 1.0);
+	obs_property_float_set_suffix(p, " Hz");
 	p = obs_properties_add_list(ppts, "threshold_action", obs_module_text("ThresholdAction"), OBS_COMBO_TYPE_LIST,
 				    OBS_COMBO_FORMAT_INT);
 	obs_property_list_add_int(p, obs_module_text("ThresholdAction.None"), THRESHOLD_NONE);
@@ -624,6 +983,9 @@ static obs_properties_t *audio_move_properties(void *data)
 	obs_property_list_add_int(p, obs_module_text("ThresholdAction.EnableUnderDisableOver"),
 				  THRESHOLD_ENABLE_UNDER_DISABLE_OVER);
 	p = obs_properties_add_float_slider(ppts, "threshold", obs_module_text("Threshold"), 0.0, 100.0, 0.01);
+	p = obs_properties_add_float_slider(ppts, "hysteresis", obs_module_text("Hysteresis"), 0.0, 100.0, 0.01);
+	p = obs_properties_add_int(ppts, "hold", obs_module_text("HoldTime"), 0, 10000, 1);
+	obs_property_int_set_suffix(p, " ms");
 	obs_properties_add_text(ppts, "plugin_info", PLUGIN_INFO, OBS_TEXT_INFO);
 	return ppts;
 }
@@ -631,20 +993,27 @@ static obs_properties_t *audio_move_properties(void *data)
 void audio_move_defaults(obs_data_t *settings)
 {
 	obs_data_set_default_double(settings, "factor", 1000.0);
+	obs_data_set_default_double(settings, "band_from", 20.0);
+	obs_data_set_default_double(settings, "band_to", 250.0);
+	obs_data_set_default_int(settings, "hold", 100);
 }
 
-void audio_move_tick(void *data, float seconds)
+static void audio_move_tick_internal(void *data, float seconds)
 {
-	UNUSED_PARAMETER(seconds);
 	struct audio_move_info *filter = data;
 	if (!obs_source_enabled(filter->source))
 		return;
+	pthread_mutex_lock(&filter->analysis_mutex);
+	audio_move_analysis_update(filter);
+	pthread_mutex_unlock(&filter->analysis_mutex);
+	const bool threshold_over = filter->threshold_over;
+	const bool threshold_known = filter->threshold_known;
+	audio_move_envelope(filter, seconds);
+	filter->threshold_known = true;
+	const bool threshold_changed = !threshold_known || threshold_over != filter->threshold_over;
 	if (filter->action == VALUE_ACTION_TRANSFORM) {
-		if (!filter->sceneitem) {
-			obs_data_t *settings = obs_source_get_settings(filter->source);
-			audio_move_update(filter, settings);
-			obs_data_release(settings);
-		}
+		if (!filter->sceneitem)
+			audio_move_resolve(filter);
 		if (!filter->sceneitem)
 			return;
 		double val = filter->factor * filter->audio_value + filter->base_value;
@@ -722,37 +1091,31 @@ void audio_move_tick(void *data, float seconds)
 		}
 
 	} else if (filter->action == VALUE_ACTION_SOURCE_VISIBILITY) {
-		if (!filter->sceneitem) {
-			obs_data_t *settings = obs_source_get_settings(filter->source);
-			audio_move_update(filter, settings);
-			obs_data_release(settings);
-		}
 		if (!filter->sceneitem)
+			audio_move_resolve(filter);
+		if (!filter->sceneitem || !threshold_changed)
 			return;
 		if ((filter->threshold_action == THRESHOLD_ENABLE_OVER ||
 		     filter->threshold_action == THRESHOLD_ENABLE_OVER_DISABLE_UNDER) &&
-		    filter->audio_value >= filter->threshold) {
+		    filter->threshold_over) {
 			obs_sceneitem_set_visible(filter->sceneitem, true);
 		} else if ((filter->threshold_action == THRESHOLD_ENABLE_UNDER ||
 			    filter->threshold_action == THRESHOLD_ENABLE_UNDER_DISABLE_OVER) &&
-			   filter->audio_value < filter->threshold) {
+			   !filter->threshold_over) {
 			obs_sceneitem_set_visible(filter->sceneitem, true);
 		} else if ((filter->threshold_action == THRESHOLD_DISABLE_OVER ||
 			    filter->threshold_action == THRESHOLD_ENABLE_UNDER_DISABLE_OVER) &&
-			   filter->audio_value >= filter->threshold) {
+			   filter->threshold_over) {
 			obs_sceneitem_set_visible(filter->sceneitem, false);
 		} else if ((filter->threshold_action == THRESHOLD_DISABLE_UNDER ||
 			    filter->threshold_action == THRESHOLD_ENABLE_OVER_DISABLE_UNDER) &&
-			   filter->audio_value < filter->threshold) {
+			   !filter->threshold_over) {
 			obs_sceneitem_set_visible(filter->sceneitem, false);
 		}
 	} else if (filter->action == VALUE_ACTION_FILTER_ENABLE) {
-		if (!filter->target_source) {
-			obs_data_t *settings = obs_source_get_settings(filter->source);
-			audio_move_update(filter, settings);
-			obs_data_release(settings);
-		}
 		if (!filter->target_source)
+			audio_move_resolve(filter);
+		if (!filter->target_source || !threshold_changed)
 			return;
 		obs_source_t *source = obs_weak_source_get_source(filter->target_source);
 		if (!source)
@@ -760,55 +1123,72 @@ void audio_move_tick(void *data, float seconds)
 
 		if ((filter->threshold_action == THRESHOLD_ENABLE_OVER ||
 		     filter->threshold_action == THRESHOLD_ENABLE_OVER_DISABLE_UNDER) &&
-		    filter->audio_value >= filter->threshold && !obs_source_enabled(source)) {
+		    filter->threshold_over && !obs_source_enabled(source)) {
 			obs_source_set_enabled(source, true);
 		} else if ((filter->threshold_action == THRESHOLD_ENABLE_UNDER ||
 			    filter->threshold_action == THRESHOLD_ENABLE_UNDER_DISABLE_OVER) &&
-			   filter->audio_value < filter->threshold && !obs_source_enabled(source)) {
+			   !filter->threshold_over && !obs_source_enabled(source)) {
 			obs_source_set_enabled(source, true);
 		} else if ((filter->threshold_action == THRESHOLD_DISABLE_OVER ||
 			    filter->threshold_action == THRESHOLD_ENABLE_UNDER_DISABLE_OVER) &&
-			   filter->audio_value >= filter->threshold && obs_source_enabled(source)) {
+			   filter->threshold_over && obs_source_enabled(source)) {
 			obs_source_set_enabled(source, false);
 		} else if ((filter->threshold_action == THRESHOLD_DISABLE_UNDER ||
 			    filter->threshold_action == THRESHOLD_ENABLE_OVER_DISABLE_UNDER) &&
-			   filter->audio_value < filter->threshold && obs_source_enabled(source)) {
+			   !filter->threshold_over && obs_source_enabled(source)) {
 			obs_source_set_enabled(source, false);
 		}
 		obs_source_release(source);
 	} else if (filter->action == VALUE_ACTION_SETTING && filter->setting_name && strlen(filter->setting_name)) {
-		if (!filter->target_source) {
-			obs_data_t *settings = obs_source_get_settings(filter->source);
-			audio_move_update(filter, settings);
-			obs_data_release(settings);
-		}
 		if (!filter->target_source)
+			audio_move_resolve(filter);
+		if (!filter->target_source)
+			return;
+		double val = filter->factor * filter->audio_value + filter->base_value;
+		if (filter->audio_value < filter->threshold)
+			val = filter->factor * filter->threshold + filter->base_value;
+		filter->setting_elapsed += seconds;
+		if (filter->setting_resolved && filter->setting_type == OBS_DATA_NUM_INT)
+			val = (double)(long long)val;
+		if (filter->setting_pushed &&
+		    (fabs(val - filter->setting_value) <= filter->setting_epsilon || filter->setting_elapsed < filter->setting_interval))
 			return;
 		obs_source_t *source = obs_weak_source_get_source(filter->target_source);
 		if (!source)
 			return;
 		obs_data_t *settings = obs_source_get_settings(source);
-		double val = filter->factor * filter->audio_value + filter->base_value;
-		if (filter->audio_value < filter->threshold)
-			val = filter->factor * filter->threshold + filter->base_value;
-		obs_data_item_t *setting = obs_data_item_byname(settings, filter->setting_name);
-		if (setting) {
-			const enum obs_data_number_type num_type = obs_data_item_numtype(setting);
-			if (num_type == OBS_DATA_NUM_INT) {
-				obs_data_item_set_int(&setting, (long long)val);
-			} else if (num_type == OBS_DATA_NUM_DOUBLE) {
-				obs_data_item_set_double(&setting, val);
-			}
+		if (!filter->setting_resolved) {
+			obs_data_item_t *setting = obs_data_item_byname(settings, filter->setting_name);
+			filter->setting_number = !setting || obs_data_item_gettype(setting) == OBS_DATA_NUMBER;
+			filter->setting_type = setting ? obs_data_item_numtype(setting) : OBS_DATA_NUM_DOUBLE;
 			obs_data_item_release(&setting);
-		} else {
-			obs_data_set_double(settings, filter->setting_name, val);
+			filter->setting_resolved = true;
+			if (filter->setting_type == OBS_DATA_NUM_INT)
+				val = (double)(long long)val;
+		}
+		if (filter->setting_number) {
+			if (filter->setting_type == OBS_DATA_NUM_INT) {
+				obs_data_set_int(settings, filter->setting_name, (long long)val);
+			} else {
+				obs_data_set_double(settings, filter->setting_name, val);
+			}
+			obs_source_update(source, settings);
 		}
-		obs_source_update(source, settings);
+		filter->setting_pushed = true;
+		filter->setting_value = val;
+		filter->setting_elapsed = 0.0f;
 		obs_data_release(settings);
 		obs_source_release(source);
 	}
 }
 
+void audio_move_tick(void *data, float seconds)
+{
+	MOVE_PERF_BEGIN(tick_start);
+	audio_move_tick_internal(data, seconds);
+	MOVE_PERF_END(MOVE_PERF_AUDIO_TICK, tick_start);
+}
+
 void audio_move_remove(void *data, obs_source_t *source)
 {
 	struct audio_move_info *audio_move = data;
@@ -856,3 +1236,15 @@ struct obs_source_info audio_move_filter = {
 	.video_tick = audio_move_tick,
 	.filter_remove = audio_move_remove,
 };
+
+void audio_move_load(void)
+{
+	da_init(audio_move_analyses);
+	pthread_mutex_init(&audio_move_analyses_mutex, NULL);
+}
+
+void audio_move_unload(void)
+{
+	da_free(audio_move_analyses);
+	pthread_mutex_destroy(&audio_move_analyses_mutex);
+}
@@ -1,19 +1,8 @@
 #include "move-transition.h"
 #include "obs-frontend-api.h"
 #include "obs-websocket-api.h"
-
-#ifdef _WIN32
-#include <winsock2.h>
-#include <ws2tcpip.h>
-#include <Mstcpip.h>
-#else
-#include <sys/socket.h>
-#include <netinet/in.h>
-#include <unistd.h>
-#include <netdb.h>
-#define SOCKET int
-#define closesocket(s) close(s)
-#endif
+#include <util/threading.h>
+#include <util/platform.h>
 
 #define MOVE_ACTION_NONE 0
 #define MOVE_ACTION_FRONTEND 1
@@ -46,6 +35,7 @@ struct move_action_action {
 	char *setting_name;
 	char *hotkey_name;
 	char *request_name;
+	bool request_capture;
 	char *event_name;
 	obs_hotkey_id hotkey_id;
 	enum obs_property_type setting_type;
@@ -62,6 +52,11 @@ struct move_action_action {
 	int udp_port;
 	char *udp_packet;
 	obs_data_t *data;
+
+	obs_weak_source_t *source;
+	obs_weak_source_t *filter;
+	obs_weak_source_t *scene;
+	struct move_udp_target *udp_target;
 };
 
 struct move_action_info {
@@ -72,6 +67,12 @@ struct move_action_info {
 	struct move_action_action start_action;
 	struct move_action_action end_action;
 	bool start;
+
+	pthread_mutex_t targets_mutex;
+	volatile bool resolve_queued;
+
+	bool end_request_waiting;
+	volatile long end_request_result;
 };
 
 bool move_action_load_hotkey(void *data, obs_hotkey_id id, obs_hotkey_t *key)
@@ -99,6 +100,142 @@ bool move_action_load_hotkey(void *data, obs_hotkey_id id, obs_hotkey_t *key)
 	return true;
 }
 
+static bool move_action_needs_hotkey(const struct move_action_action *action)
+{
+	if (action->hotkey_id != OBS_INVALID_HOTKEY_ID || !action->hotkey_name || !strlen(action->hotkey_name))
+		return false;
+	if (action->action == MOVE_ACTION_SOURCE_HOTKEY)
+		return action->source_name && strlen(action->source_name);
+	return action->action == MOVE_ACTION_FRONTEND_HOTKEY;
+}
+
+static void move_action_resolve_action(struct move_action_info *move_action, struct move_action_action *action)
+{
+	obs_source_t *source = NULL;
+	obs_source_t *filter = NULL;
+	obs_source_t *scene = NULL;
+	if (action->source_name && strlen(action->source_name))
+		source = obs_get_source_by_name(action->source_name);
+	if (source && action->filter_name && strlen(action->filter_name))
+		filter = obs_source_get_filter_by_name(source, action->filter_name);
+	if (action->scene_name && strlen(action->scene_name)) {
+		obs_canvas_t *canvas = action->canvas_name && action->canvas_name[0] != '\0'
+					       ? obs_get_canvas_by_name(action->canvas_name)
+					       : obs_get_main_canvas();
+		if (canvas) {
+			scene = obs_canvas_get_source_by_name(canvas, action->scene_name);
+			obs_canvas_release(canvas);
+		}
+		if (!scene)
+			scene = obs_get_source_by_name(action->scene_name);
+	}
+	obs_weak_source_t *weak_source = obs_source_get_weak_source(source);
+	obs_weak_source_t *weak_filter = obs_source_get_weak_source(filter);
+	obs_weak_source_t *weak_scene = obs_source_get_weak_source(scene);
+	obs_source_release(source);
+	obs_source_release(filter);
+	obs_source_release(scene);
+
+	pthread_mutex_lock(&move_action->targets_mutex);
+	obs_weak_source_t *prev_source = action->source;
+	obs_weak_source_t *prev_filter = action->filter;
+	obs_weak_source_t *prev_scene = action->scene;
+	action->source = weak_source;
+	action->filter = weak_filter;
+	action->scene = weak_scene;
+	pthread_mutex_unlock(&move_action->targets_mutex);
+	obs_weak_source_release(prev_source);
+	obs_weak_source_release(prev_filter);
+	obs_weak_source_release(prev_scene);
+
+	if (move_action_needs_hotkey(action))
+		obs_enum_hotkeys(move_action_load_hotkey, action);
+}
+
+static void move_action_resolve(void *data)
+{
+	struct move_action_info *move_action = data;
+	os_atomic_set_bool(&move_action->resolve_queued, false);
+	move_action_resolve_action(move_action, &move_action->start_action);
+	move_action_resolve_action(move_action, &move_action->end_action);
+}
+
+// targets are resolved by name on the ui thread, so firing an action only dereferences weak references
+static void move_action_queue_resolve(struct move_action_info *move_action)
+{
+	if (!os_atomic_set_bool(&move_action->resolve_queued, true))
+		obs_queue_task(OBS_TASK_UI, move_action_resolve, move_action, false);
+}
+
+static bool move_action_targets_name(const struct move_action_info *move_action, const char *name)
+{
+	const struct move_action_action *actions[] = {&move_action->start_action, &move_action->end_action};
+	for (size_t i = 0; i < 2; i++) {
+		const struct move_action_action *action = actions[i];
+		if ((action->source_name && strcmp(action->source_name, name) == 0) ||
+		    (action->filter_name && strcmp(action->filter_name, name) == 0) ||
+		    (action->scene_name && strcmp(action->scene_name, name) == 0))
+			return true;
+	}
+	return false;
+}
+
+static bool move_action_targets_source(struct move_action_info *move_action, obs_source_t *source)
+{
+	const struct move_action_action *actions[] = {&move_action->start_action, &move_action->end_action};
+	bool found = false;
+	pthread_mutex_lock(&move_action->targets_mutex);
+	for (size_t i = 0; i < 2 && !found; i++) {
+		const struct move_action_action *action = actions[i];
+		found = (action->source && obs_weak_source_references_source(action->source, source)) ||
+			(action->filter && obs_weak_source_references_source(action->filter, source)) ||
+			(action->scene && obs_weak_source_references_source(action->scene, source));
+	}
+	pthread_mutex_unlock(&move_action->targets_mutex);
+	return found;
+}
+
+static void move_action_source_create(void *data, calldata_t *call_data)
+{
+	struct move_action_info *move_action = data;
+	const char *name = obs_source_get_name(calldata_ptr(call_data, "source"));
+	if (name && move_action_targets_name(move_action, name))
+		move_action_queue_resolve(move_action);
+}
+
+static void move_action_source_remove(void *data, calldata_t *call_data)
+{
+	struct move_action_info *move_action = data;
+	obs_source_t *source = calldata_ptr(call_data, "source");
+	if (source && move_action_targets_source(move_action, source))
+		move_action_queue_resolve(move_action);
+}
+
+static void move_action_hotkey_register(void *data, calldata_t *call_data)
+{
+	struct move_action_info *move_action = data;
+	obs_hotkey_t *key = calldata_ptr(call_data, "key");
+	if (!key)
+		return;
+	if (move_action_needs_hotkey(&move_action->start_action))
+		move_action_load_hotkey(&move_action->start_action, obs_hotkey_get_id(key), key);
+	if (move_action_needs_hotkey(&move_action->end_action))
+		move_action_load_hotkey(&move_action->end_action, obs_hotkey_get_id(key), key);
+}
+
+static void move_action_hotkey_unregister(void *data, calldata_t *call_data)
+{
+	struct move_action_info *move_action = data;
+	obs_hotkey_t *key = calldata_ptr(call_data, "key");
+	if (!key)
+		return;
+	obs_hotkey_id id = obs_hotkey_get_id(key);
+	if (move_action->start_action.hotkey_id == id)
+		move_action->start_action.hotkey_id = OBS_INVALID_HOTKEY_ID;
+	if (move_action->end_action.hotkey_id == id)
+		move_action->end_action.hotkey_id = OBS_INVALID_HOTKEY_ID;
+}
+
 void move_action_update(void *data, obs_data_t *settings)
 {
 	struct move_action_info *move_action = data;
@@ -198,21 +335,7 @@ void move_action_update(void *data, obs_data_t *settings)
 
 	if (changed) {
 		move_action->start_action.hotkey_id = OBS_INVALID_HOTKEY_ID;
-		if (move_action->start_action.hotkey_name && strlen(move_action->start_action.hotkey_name)) {
-			if (move_action->start_action.action == MOVE_ACTION_SOURCE_HOTKEY &&
-			    move_action->start_action.source_name && strlen(move_action->start_action.source_name))
-				obs_enum_hotkeys(move_action_load_hotkey, &move_action->start_action);
-			else if (start_action == MOVE_ACTION_FRONTEND_HOTKEY)
-				obs_enum_hotkeys(move_action_load_hotkey, &move_action->start_action);
-		}
 		move_action->end_action.hotkey_id = OBS_INVALID_HOTKEY_ID;
-		if (move_action->end_action.hotkey_name && strlen(move_action->end_action.hotkey_name)) {
-			if (move_action->end_action.action == MOVE_ACTION_SOURCE_HOTKEY && move_action->end_action.source_name &&
-			    strlen(move_action->end_action.source_name))
-				obs_enum_hotkeys(move_action_load_hotkey, &move_action->end_action);
-			else if (end_action == MOVE_ACTION_FRONTEND_HOTKEY)
-				obs_enum_hotkeys(move_action_load_hotkey, &move_action->end_action);
-		}
 	}
 
 	if (start_action == MOVE_ACTION_UDP_PACKET) {
@@ -259,12 +382,30 @@ void move_action_update(void *data, obs_data_t *settings)
 		changed = true;
 	}
 
+	struct move_udp_target *start_udp_target =
+		start_action == MOVE_ACTION_UDP_PACKET
+			? move_udp_target_get(move_action->start_action.udp_host, move_action->start_action.udp_port)
+			: NULL;
+	struct move_udp_target *end_udp_target =
+		end_action == MOVE_ACTION_UDP_PACKET
+			? move_udp_target_get(move_action->end_action.udp_host, move_action->end_action.udp_port)
+			: NULL;
+	pthread_mutex_lock(&move_action->targets_mutex);
+	struct move_udp_target *prev_start_udp_target = move_action->start_action.udp_target;
+	struct move_udp_target *prev_end_udp_target = move_action->end_action.udp_target;
+	move_action->start_action.udp_target = start_udp_target;
+	move_action->end_action.udp_target = end_udp_target;
+	pthread_mutex_unlock(&move_action->targets_mutex);
+	move_udp_target_release(prev_start_udp_target);
+	move_udp_target_release(prev_end_udp_target);
+
 	if (start_action == MOVE_ACTION_WEBSOCKET_REQUEST) {
 		const char *request_name = obs_data_get_string(settings, "request");
 		if (!move_action->start_action.request_name || strcmp(request_name, move_action->start_action.request_name) != 0) {
 			bfree(move_action->start_action.request_name);
 			move_action->start_action.request_name = bstrdup(request_name);
 		}
+		move_action->start_action.request_capture = obs_data_get_bool(settings, "request_capture");
 	} else if (move_action->start_action.request_name) {
 		bfree(move_action->start_action.request_name);
 		move_action->start_action.request_name = NULL;
@@ -276,6 +417,7 @@ void move_action_update(void *data, obs_data_t *settings)
 			bfree(move_action->end_action.request_name);
 			move_action->end_action.request_name = bstrdup(request_name);
 		}
+		move_action->end_action.request_capture = obs_data_get_bool(settings, "end_request_capture");
 	} else if (move_action->end_action.request_name) {
 		bfree(move_action->end_action.request_name);
 		move_action->end_action.request_name = NULL;
@@ -467,6 +609,8 @@ void move_action_update(void *data, obs_data_t *settings)
 
 	move_action->start_action.enable = obs_data_get_int(settings, "enable");
 	move_action->end_action.enable = obs_data_get_int(settings, "end_enable");
+
+	move_action_queue_resolve(move_action);
 }
 
 static const char *move_action_get_name(void *type_data)
@@ -482,6 +626,7 @@ void move_action_start(void *data)
 	if (!move_filter_start_internal(&move_action->move_filter))
 		return;
 
+	move_action->end_request_waiting = false;
 	move_action->start = true;
 }
 
@@ -523,13 +668,36 @@ static void move_action_source_rename(void *data, calldata_t *call_data)
 		move_action->end_action.source_name = bstrdup(new_name);
 		obs_data_set_string(settings, "end_source", new_name);
 	}
+	obs_source_t *source = calldata_ptr(call_data, "source");
+	pthread_mutex_lock(&move_action->targets_mutex);
+	const bool start_filter = move_action->start_action.filter &&
+				  obs_weak_source_references_source(move_action->start_action.filter, source);
+	const bool end_filter = move_action->end_action.filter &&
+				obs_weak_source_references_source(move_action->end_action.filter, source);
+	pthread_mutex_unlock(&move_action->targets_mutex);
+	if (start_filter) {
+		bfree(move_action->start_action.filter_name);
+		move_action->start_action.filter_name = bstrdup(new_name);
+		obs_data_set_string(settings, "filter", new_name);
+	}
+	if (end_filter) {
+		bfree(move_action->end_action.filter_name);
+		move_action->end_action.filter_name = bstrdup(new_name);
+		obs_data_set_string(settings, "end_filter", new_name);
+	}
 	obs_data_release(settings);
+	if (move_action_targets_name(move_action, new_name))
+		move_action_queue_resolve(move_action);
 }
 
+static void move_action_enable_stopped(void *data);
+
 static void *move_action_create(obs_data_t *settings, obs_source_t *source)
 {
 	struct move_action_info *move_action = bzalloc(sizeof(struct move_action_info));
+	pthread_mutex_init(&move_action->targets_mutex, NULL);
 	move_filter_init(&move_action->move_filter, source, move_action_start);
+	move_action->move_filter.enable_stopped = move_action_enable_stopped;
 	move_action->start_action.hotkey_id = OBS_INVALID_HOTKEY_ID;
 	move_action->end_action.hotkey_id = OBS_INVALID_HOTKEY_ID;
 	move_action->start_action.reverse = &move_action->move_filter.reverse;
@@ -541,14 +709,27 @@ static void *move_action_create(obs_data_t *settings, obs_source_t *source)
 	}
 	signal_handler_t *sh = obs_get_signal_handler();
 	signal_handler_connect(sh, "source_rename", move_action_source_rename, move_action);
+	signal_handler_connect(sh, "source_create", move_action_source_create, move_action);
+	signal_handler_connect(sh, "source_remove", move_action_source_remove, move_action);
+	signal_handler_connect(sh, "hotkey_register", move_action_hotkey_register, move_action);
+	signal_handler_connect(sh, "hotkey_unregister", move_action_hotkey_unregister, move_action);
 	return move_action;
 }
 
-static void move_action_actual_destroy(void *data)
+static void move_action_disconnect(struct move_action_info *move_action)
 {
-	struct move_action_info *move_action = data;
 	signal_handler_t *sh = obs_get_signal_handler();
 	signal_handler_disconnect(sh, "source_rename", move_action_source_rename, move_action);
+	signal_handler_disconnect(sh, "source_create", move_action_source_create, move_action);
+	signal_handler_disconnect(sh, "source_remove", move_action_source_remove, move_action);
+	signal_handler_disconnect(sh, "hotkey_register", move_action_hotkey_register, move_action);
+	signal_handler_disconnect(sh, "hotkey_unregister", move_action_hotkey_unregister, move_action);
+}
+
+static void move_action_actual_destroy(void *data)
+{
+	struct move_action_info *move_action = data;
+	move_action_disconnect(move_action);
 	move_filter_destroy(&move_action->move_filter);
 	bfree(move_action->start_action.source_name);
 	bfree(move_action->start_action.hotkey_name);
@@ -576,14 +757,22 @@ static void move_action_actual_destroy(void *data)
 	bfree(move_action->end_action.udp_host);
 	bfree(move_action->end_action.udp_packet);
 	obs_data_release(move_action->end_action.data);
+	obs_weak_source_release(move_action->start_action.source);
+	obs_weak_source_release(move_action->start_action.filter);
+	obs_weak_source_release(move_action->start_action.scene);
+	obs_weak_source_release(move_action->end_action.source);
+	obs_weak_source_release(move_action->end_action.filter);
+	obs_weak_source_release(move_action->end_action.scene);
+	move_udp_target_release(move_action->start_action.udp_target);
+	move_udp_target_release(move_action->end_action.udp_target);
+	pthread_mutex_destroy(&move_action->targets_mutex);
 
 	bfree(move_action);
 }
 
 static void move_action_destroy(void *data)
 {
-	signal_handler_t *sh = obs_get_signal_handler();
-	signal_handler_disconnect(sh, "source_rename", move_action_source_rename, data);
+	move_action_disconnect(data);
 	obs_queue_task(OBS_TASK_UI, move_action_actual_destroy, data, false);
 }
 
@@ -993,6 +1182,11 @@ static bool move_action_action_changed(obs_properties_t *props, obs_property_t *
 	obs_property_set_visible(udp_packet, action == MOVE_ACTION_UDP_PACKET);
 	obs_property_t *request_name = obs_properties_get(props, "request");
 	obs_property_set_visible(request_name, action == MOVE_ACTION_WEBSOCKET_REQUEST);
+	obs_property_t *request_capture = obs_properties_get(props, "request_capture");
+	obs_property_set_visible(request_capture, action == MOVE_ACTION_WEBSOCKET_REQUEST);
+	obs_property_t *request_response = obs_properties_get(props, "request_response");
+	obs_property_set_visible(request_response, action == MOVE_ACTION_WEBSOCKET_REQUEST &&
+							   obs_data_get_bool(settings, "request_capture"));
 	obs_property_t *event_name = obs_properties_get(props, "event");
 	obs_property_set_visible(event_name, action == MOVE_ACTION_WEBSOCKET_EVENT);
 	obs_property_t *data = obs_properties_get(props, "data");
@@ -1066,6 +1260,11 @@ static bool move_action_end_action_changed(obs_properties_t *props, obs_property
 	obs_property_set_visible(udp_packet, action == MOVE_ACTION_UDP_PACKET);
 	obs_property_t *request_name = obs_properties_get(props, "end_request");
 	obs_property_set_visible(request_name, action == MOVE_ACTION_WEBSOCKET_REQUEST);
+	obs_property_t *request_capture = obs_properties_get(props, "end_request_capture");
+	obs_property_set_visible(request_capture, action == MOVE_ACTION_WEBSOCKET_REQUEST);
+	obs_property_t *request_response = obs_properties_get(props, "end_request_response");
+	obs_property_set_visible(request_response, action == MOVE_ACTION_WEBSOCKET_REQUEST &&
+							   obs_data_get_bool(settings, "end_request_capture"));
 	obs_property_t *event_name = obs_properties_get(props, "end_event");
 	obs_property_set_visible(event_name, action == MOVE_ACTION_WEBSOCKET_EVENT);
 	obs_property_t *data = obs_properties_get(props, "end_data");
@@ -1233,6 +1432,9 @@ static obs_properties_t *move_action_properties(void *data)
 	obs_properties_add_int(start_action, "udp_port", obs_module_text("UdpPort"), 1, 65535, 1);
 	obs_properties_add_text(start_action, "udp_packet", obs_module_text("UdpPacket"), OBS_TEXT_DEFAULT);
 	obs_properties_add_text(start_action, "request", obs_module_text("WebsocketRequest"), OBS_TEXT_DEFAULT);
+	p = obs_properties_add_bool(start_action, "request_capture", obs_module_text("WebsocketCapture"));
+	obs_property_set_modified_callback(p, move_action_action_changed);
+	obs_properties_add_text(start_action, "request_response", obs_module_text("WebsocketResponse"), OBS_TEXT_INFO);
 	obs_properties_add_text(start_action, "event", obs_module_text("WebsocketEvent"), OBS_TEXT_DEFAULT);
 	obs_properties_add_text(start_action, "data", obs_module_text("WebsocketData"), OBS_TEXT_MULTILINE);
 
@@ -1351,6 +1553,9 @@ static obs_properties_t *move_action_properties(void *data)
 	obs_properties_add_int(end_action, "end_udp_port", obs_module_text("UdpPort"), 1, 65535, 1);
 	obs_properties_add_text(end_action, "end_udp_packet", obs_module_text("UdpPacket"), OBS_TEXT_DEFAULT);
 	obs_properties_add_text(end_action, "end_request", obs_module_text("WebsocketRequest"), OBS_TEXT_DEFAULT);
+	p = obs_properties_add_bool(end_action, "end_request_capture", obs_module_text("WebsocketCapture"));
+	obs_property_set_modified_callback(p, move_action_end_action_changed);
+	obs_properties_add_text(end_action, "end_request_response", obs_module_text("WebsocketResponse"), OBS_TEXT_INFO);
 	obs_properties_add_text(end_action, "end_event", obs_module_text("WebsocketEvent"), OBS_TEXT_DEFAULT);
 	obs_properties_add_text(end_action, "end_data", obs_module_text("WebsocketData"), OBS_TEXT_MULTILINE);
 
@@ -1458,21 +1663,199 @@ static obs_properties_t *move_action_properties(void *data)
 
 extern obs_websocket_vendor vendor;
 
-void move_action_execute(void *data)
+// obs-websocket RequestStatus::Success
+#define MOVE_ACTION_REQUEST_SUCCESS 100
+#define MOVE_ACTION_REQUEST_QUEUE_MAX 64
+
+#define MOVE_ACTION_REQUEST_RESULT_NONE 0
+#define MOVE_ACTION_REQUEST_RESULT_SUCCESS 1
+#define MOVE_ACTION_REQUEST_RESULT_FAILED 2
+
+struct move_action_request {
+	obs_weak_source_t *filter;
+	char *request_name;
+	obs_data_t *data;
+	bool capture;
+	bool end;
+	uint64_t queued;
+};
+
+struct move_action_request_stats {
+	char *request_name;
+	uint64_t count;
+	uint64_t failed;
+	uint64_t total_ns;
+	uint64_t max_ns;
+	uint64_t wait_ns;
+};
+
+static DARRAY(struct move_action_request) move_action_requests;
+static pthread_mutex_t move_action_requests_mutex;
+static os_event_t *move_action_requests_event = NULL;
+static pthread_t move_action_requests_thread;
+static bool move_action_requests_active = false;
+static volatile bool move_action_requests_stopping = false;
+// only touched by the request thread, logged on unload
+static DARRAY(struct move_action_request_stats) move_action_request_stats;
+
+static void move_action_request_free(struct move_action_request *request)
 {
-	struct move_action_action *move_action = data;
-	if (move_action->action == MOVE_ACTION_SOURCE_HOTKEY) {
-		if (move_action->hotkey_id == OBS_INVALID_HOTKEY_ID && move_action->hotkey_name &&
-		    strlen(move_action->hotkey_name) && move_action->source_name && strlen(move_action->source_name)) {
-			obs_enum_hotkeys(move_action_load_hotkey, move_action);
+	obs_weak_source_release(request->filter);
+	obs_data_release(request->data);
+	bfree(request->request_name);
+}
+
+static void move_action_request_stats_add(const char *request_name, bool success, uint64_t duration, uint64_t wait)
+{
+	struct move_action_request_stats *stats = NULL;
+	for (size_t i = 0; i < move_action_request_stats.num; i++) {
+		if (strcmp(move_action_request_stats.array[i].request_name, request_name) == 0) {
+			stats = move_action_request_stats.array + i;
+			break;
+		}
+	}
+	if (!stats) {
+		stats = da_push_back_new(move_action_request_stats);
+		stats->request_name = bstrdup(request_name);
+	}
+	stats->count++;
+	if (!success)
+		stats->failed++;
+	stats->total_ns += duration;
+	stats->wait_ns += wait;
+	if (duration > stats->max_ns)
+		stats->max_ns = duration;
+}
+
+struct move_action_request_response {
+	obs_weak_source_t *filter;
+	char *response;
+	bool end;
+};
+
+// the response is shown in the filter settings, which only the ui thread writes
+static void move_action_request_response_apply(void *data)
+{
+	struct move_action_request_response *response = data;
+	obs_source_t *filter = obs_weak_source_get_source(response->filter);
+	if (filter) {
+		obs_data_t *settings = obs_source_get_settings(filter);
+		obs_data_set_string(settings, response->end ? "end_request_response" : "request_response", response->response);
+		obs_data_release(settings);
+		obs_source_release(filter);
+	}
+	obs_weak_source_release(response->filter);
+	bfree(response->response);
+	bfree(response);
+}
+
+static void move_action_request_finish(struct move_action_request *request, struct obs_websocket_request_response *response)
+{
+	const bool success = response && response->status_code == MOVE_ACTION_REQUEST_SUCCESS;
+	if (!request->capture)
+		return;
+	obs_source_t *filter = obs_weak_source_get_source(request->filter);
+	if (!filter)
+		return;
+	struct move_action_request_response *apply = bzalloc(sizeof(struct move_action_request_response));
+	apply->filter = obs_source_get_weak_source(filter);
+	const char *result = response && response->response_data ? response->response_data
+				  : response && response->comment ? response->comment
+								  : "";
+	apply->response = bstrdup(result);
+	apply->end = request->end;
+	obs_queue_task(OBS_TASK_UI, move_action_request_response_apply, apply, false);
+	if (request->end) {
+		struct move_action_info *move_action = obs_obj_get_data(filter);
+		os_atomic_set_long(&move_action->end_request_result,
+				   success ? MOVE_ACTION_REQUEST_RESULT_SUCCESS : MOVE_ACTION_REQUEST_RESULT_FAILED);
+	}
+	obs_source_release(filter);
+}
+
+static void *move_action_requests_thread_run(void *data)
+{
+	UNUSED_PARAMETER(data);
+	os_set_thread_name("move_action_requests_thread");
+	while (os_event_wait(move_action_requests_event) == 0 && !move_action_requests_stopping) {
+		for (;;) {
+			struct move_action_request request;
+			pthread_mutex_lock(&move_action_requests_mutex);
+			if (!move_action_requests.num || move_action_requests_stopping) {
+				pthread_mutex_unlock(&move_action_requests_mutex);
+				break;
+			}
+			request = move_action_requests.array[0];
+			da_erase(move_action_requests, 0);
+			pthread_mutex_unlock(&move_action_requests_mutex);
+
+			const uint64_t start = os_gettime_ns();
+			struct obs_websocket_request_response *response =
+				obs_websocket_call_request(request.request_name, request.data);
+			const uint64_t end = os_gettime_ns();
+			const bool success = response && response->status_code == MOVE_ACTION_REQUEST_SUCCESS;
+			if (!success)
+				blog(LOG_WARNING, "[Move Transition] Websocket request %s failed: %s", request.request_name,
+				     response && response->comment ? response->comment : "no response");
+			move_action_request_stats_add(request.request_name, success, end - start, start - request.queued);
+			move_action_request_finish(&request, response);
+			obs_websocket_request_response_free(response);
+			move_action_request_free(&request);
 		}
+	}
+	return NULL;
+}
+
+// websocket requests can be slow, so they run in order on their own thread instead of the ui thread
+static void move_action_request_queue(struct move_action_info *move_action, struct move_action_action *action)
+{
+	const bool end = action == &move_action->end_action;
+	if (!action->request_name || !strlen(action->request_name)) {
+		if (end && action->request_capture)
+			os_atomic_set_long(&move_action->end_request_result, MOVE_ACTION_REQUEST_RESULT_FAILED);
+		return;
+	}
+	struct move_action_request request;
+	request.filter = obs_source_get_weak_source(move_action->move_filter.source);
+	request.request_name = bstrdup(action->request_name);
+	request.data = action->data;
+	obs_data_addref(request.data);
+	request.capture = action->request_capture;
+	request.end = end;
+	request.queued = os_gettime_ns();
+
+	pthread_mutex_lock(&move_action_requests_mutex);
+	const bool full = move_action_requests.num >= MOVE_ACTION_REQUEST_QUEUE_MAX;
+	if (!full) {
+		da_push_back(move_action_requests, &request);
+		if (!move_action_requests_active)
+			move_action_requests_active = pthread_create(&move_action_requests_thread, NULL,
+								     move_action_requests_thread_run, NULL) == 0;
+	}
+	pthread_mutex_unlock(&move_action_requests_mutex);
+	if (!full) {
+		os_event_signal(move_action_requests_event);
+		return;
+	}
+	blog(LOG_WARNING, "[Move Transition] Websocket request queue full, dropped %s", request.request_name);
+	move_action_request_finish(&request, NULL);
+	move_action_request_free(&request);
+}
+
+static obs_source_t *move_action_get_target(struct move_action_info *move_action, obs_weak_source_t *const *target)
+{
+	pthread_mutex_lock(&move_action->targets_mutex);
+	obs_source_t *source = obs_weak_source_get_source(*target);
+	pthread_mutex_unlock(&move_action->targets_mutex);
+	return source;
+}
+
+static void move_action_execute(struct move_action_info *info, struct move_action_action *move_action)
+{
+	if (move_action->action == MOVE_ACTION_SOURCE_HOTKEY) {
 		if (move_action->hotkey_id != OBS_INVALID_HOTKEY_ID)
 			obs_hotkey_trigger_routed_callback(move_action->hotkey_id, !*move_action->reverse);
 	} else if (move_action->action == MOVE_ACTION_FRONTEND_HOTKEY) {
-		if (move_action->hotkey_id == OBS_INVALID_HOTKEY_ID && move_action->hotkey_name &&
-		    strlen(move_action->hotkey_name)) {
-			obs_enum_hotkeys(move_action_load_hotkey, move_action);
-		}
 		if (move_action->hotkey_id != OBS_INVALID_HOTKEY_ID)
 			obs_hotkey_trigger_routed_callback(move_action->hotkey_id, !*move_action->reverse);
 	} else if (move_action->action == MOVE_ACTION_FRONTEND) {
@@ -1509,20 +1892,13 @@ void move_action_execute(void *data)
 		if (move_action->scene_name && move_action->sceneitem_name && strlen(move_action->scene_name) &&
 		    strlen(move_action->sceneitem_name)) {
 
-			obs_canvas_t *canvas = move_action->canvas_name && move_action->canvas_name[0] != '\0'
-						       ? obs_get_canvas_by_name(move_action->canvas_name)
-						       : obs_get_main_canvas();
-			obs_source_t *scene_source = NULL;
-			if (canvas) {
-				scene_source = obs_canvas_get_source_by_name(canvas, move_action->scene_name);
-				obs_canvas_release(canvas);
-			}
-			if (!scene_source)
-				scene_source = obs_get_source_by_name(move_action->scene_name);
+			obs_source_t *scene_source = move_action_get_target(info, &move_action->scene);
 			obs_scene_t *scene = obs_scene_from_source(scene_source);
 			if (!scene)
 				scene = obs_group_from_source(scene_source);
-			obs_sceneitem_t *item = obs_scene_find_source_recursive(scene, move_action->sceneitem_name);
+			obs_sceneitem_t *item = move_scene_find_item(scene, move_action->sceneitem_name);
+			if (!item)
+				item = obs_scene_find_source_recursive(scene, move_action->sceneitem_name);
 			if (item) {
 
 				if (move_action->enable == MOVE_ACTION_TOGGLE) {
@@ -1540,8 +1916,7 @@ void move_action_execute(void *data)
 	} else if (move_action->action == MOVE_ACTION_FILTER_ENABLE) {
 		if (move_action->source_name && move_action->filter_name && strlen(move_action->source_name) &&
 		    strlen(move_action->filter_name)) {
-			obs_source_t *source = obs_get_source_by_name(move_action->source_name);
-			obs_source_t *filter = source ? obs_source_get_filter_by_name(source, move_action->filter_name) : NULL;
+			obs_source_t *filter = move_action_get_target(info, &move_action->filter);
 			if (filter) {
 
 				if (move_action->enable == MOVE_ACTION_TOGGLE) {
@@ -1555,11 +1930,10 @@ void move_action_execute(void *data)
 				}
 				obs_source_release(filter);
 			}
-			obs_source_release(source);
 		}
 	} else if (move_action->action == MOVE_ACTION_SOURCE_MUTE) {
 		if (move_action->source_name && strlen(move_action->source_name)) {
-			obs_source_t *source = obs_get_source_by_name(move_action->source_name);
+			obs_source_t *source = move_action_get_target(info, &move_action->source);
 			if (source) {
 				if (move_action->enable == MOVE_ACTION_TOGGLE) {
 					obs_source_set_muted(source, !obs_source_muted(source));
@@ -1575,7 +1949,7 @@ void move_action_execute(void *data)
 		}
 	} else if (move_action->action == MOVE_ACTION_SOURCE_AUDIO_TRACK) {
 		if (move_action->audio_track != 0 && move_action->source_name && strlen(move_action->source_name)) {
-			obs_source_t *source = obs_get_source_by_name(move_action->source_name);
+			obs_source_t *source = move_action_get_target(info, &move_action->source);
 			if (source) {
 				uint32_t mixers = obs_source_get_audio_mixers(source);
 				if (move_action->audio_track < 0) {
@@ -1620,13 +1994,9 @@ void move_action_execute(void *data)
 		}
 	} else if (move_action->action == MOVE_ACTION_SETTING) {
 		if (move_action->source_name && strlen(move_action->source_name)) {
-			obs_source_t *source = obs_get_source_by_name(move_action->source_name);
-			obs_source_t *target = source && move_action->filter_name && strlen(move_action->filter_name)
-						       ? obs_source_get_filter_by_name(source, move_action->filter_name)
-						       : NULL;
-			obs_source_release(target);
-			if (!target)
-				target = source;
+			obs_source_t *source = move_action_get_target(info, &move_action->source);
+			obs_source_t *filter = move_action_get_target(info, &move_action->filter);
+			obs_source_t *target = filter ? filter : source;
 			if (target) {
 				obs_data_t *settings = obs_source_get_settings(target);
 				if (move_action->setting_type == OBS_PROPERTY_BOOL) {
@@ -1674,88 +2044,170 @@ void move_action_execute(void *data)
 				}
 				obs_data_release(settings);
 			}
+			obs_source_release(filter);
 			obs_source_release(source);
 		}
 	} else if (move_action->action == MOVE_ACTION_UDP_PACKET) {
-		SOCKET sockfd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-		if (sockfd >= 0) {
-			struct hostent *host = gethostbyname(
-				move_action->udp_host && strlen(move_action->udp_host) ? move_action->udp_host : "127.0.0.1");
-			if (host) {
-				struct sockaddr_in server;
-				memset(&server, 0, sizeof(server));
-				server.sin_family = AF_INET;
-				server.sin_addr = *((struct in_addr *)host->h_addr);
-				server.sin_port = htons(move_action->udp_port ? move_action->udp_port : 3000);
-				char *packet = move_action->udp_packet && strlen(move_action->udp_packet) ? move_action->udp_packet
-													  : "move-action";
-				sendto(sockfd, packet, (int)strlen(packet), 0, (const struct sockaddr *)&server, sizeof(server));
-				closesocket(sockfd);
-			}
-		}
+		pthread_mutex_lock(&info->targets_mutex);
+		move_udp_send(move_action->udp_target,
+			      move_action->udp_packet && strlen(move_action->udp_packet) ? move_action->udp_packet : "move-action");
+		pthread_mutex_unlock(&info->targets_mutex);
 	} else if (move_action->action == MOVE_ACTION_WEBSOCKET_REQUEST) {
-		struct obs_websocket_request_response *response =
-			obs_websocket_call_request(move_action->request_name, move_action->data);
-		obs_websocket_request_response_free(response);
+		move_action_request_queue(info, move_action);
 	} else if (move_action->action == MOVE_ACTION_WEBSOCKET_EVENT) {
 		obs_websocket_vendor_emit_event(vendor, move_action->event_name, move_action->data);
 	}
 }
 
-void move_action_hotkey_end(void *data)
+static void move_action_hotkey_end(struct move_action_info *move_action)
 {
-	struct move_action_info *move_action = data;
 	obs_hotkey_trigger_routed_callback(move_action->start_action.hotkey_id, move_action->move_filter.reverse);
 }
 
-void move_action_tick(void *data, float seconds)
+struct move_action_batch_entry {
+	struct move_action_info *move_action;
+	// NULL releases the start hotkey
+	struct move_action_action *action;
+};
+
+static DARRAY(struct move_action_batch_entry) move_action_batch;
+static pthread_mutex_t move_action_batch_mutex;
+
+static void move_action_batch_execute(void *data)
+{
+	UNUSED_PARAMETER(data);
+	DARRAY(struct move_action_batch_entry) batch;
+	da_init(batch);
+	pthread_mutex_lock(&move_action_batch_mutex);
+	da_move(batch, move_action_batch);
+	pthread_mutex_unlock(&move_action_batch_mutex);
+
+	for (size_t i = 0; i < batch.num; i++) {
+		struct move_action_batch_entry *entry = batch.array + i;
+		if (entry->action)
+			move_action_execute(entry->move_action, entry->action);
+		else
+			move_action_hotkey_end(entry->move_action);
+	}
+	da_free(batch);
+	move_udp_flush();
+}
+
+// actions triggered during a frame run in trigger order from a single ui task
+static void move_action_batch_add(struct move_action_info *move_action, struct move_action_action *action)
+{
+	struct move_action_batch_entry entry = {move_action, action};
+	pthread_mutex_lock(&move_action_batch_mutex);
+	const bool queue = !move_action_batch.num;
+	da_push_back(move_action_batch, &entry);
+	pthread_mutex_unlock(&move_action_batch_mutex);
+	if (queue)
+		obs_queue_task(OBS_TASK_UI, move_action_batch_execute, NULL, false);
+}
+
+void move_action_load(void)
+{
+	da_init(move_action_batch);
+	pthread_mutex_init(&move_action_batch_mutex, NULL);
+	da_init(move_action_requests);
+	da_init(move_action_request_stats);
+	pthread_mutex_init(&move_action_requests_mutex, NULL);
+	os_event_init(&move_action_requests_event, OS_EVENT_TYPE_AUTO);
+}
+
+void move_action_unload(void)
+{
+	da_free(move_action_batch);
+	pthread_mutex_destroy(&move_action_batch_mutex);
+
+	if (move_action_requests_active) {
+		move_action_requests_stopping = true;
+		os_event_signal(move_action_requests_event);
+		pthread_join(move_action_requests_thread, NULL);
+		move_action_requests_active = false;
+	}
+	for (size_t i = 0; i < move_action_requests.num; i++)
+		move_action_request_free(move_action_requests.array + i);
+	da_free(move_action_requests);
+	for (size_t i = 0; i < move_action_request_stats.num; i++) {
+		struct move_action_request_stats *stats = move_action_request_stats.array + i;
+		blog(LOG_INFO, "[Move Transition] Websocket request %s: %llu calls, %llu failed, avg %.2f ms, max %.2f ms, avg wait %.2f ms",
+		     stats->request_name, (unsigned long long)stats->count, (unsigned long long)stats->failed,
+		     (double)stats->total_ns / (double)stats->count / 1000000.0, (double)stats->max_ns / 1000000.0,
+		     (double)stats->wait_ns / (double)stats->count / 1000000.0);
+		bfree(stats->request_name);
+	}
+	da_free(move_action_request_stats);
+	os_event_destroy(move_action_requests_event);
+	move_action_requests_event = NULL;
+	pthread_mutex_destroy(&move_action_requests_mutex);
+}
+
+// a captured end request holds back the next move until its response is in
+static void move_action_end(struct move_action_info *move_action)
+{
+	// arm the wait before queueing, the result can be reported before batch_add returns
+	if (move_action->end_action.action == MOVE_ACTION_WEBSOCKET_REQUEST && move_action->end_action.request_capture) {
+		os_atomic_set_long(&move_action->end_request_result, MOVE_ACTION_REQUEST_RESULT_NONE);
+		move_action->end_request_waiting = true;
+		move_action_batch_add(move_action, &move_action->end_action);
+		return;
+	}
+	move_action_batch_add(move_action, &move_action->end_action);
+	move_filter_ended(&move_action->move_filter);
+}
+
+// an infinite action has no end of its own, disabling the filter ends it
+static void move_action_enable_stopped(void *data)
 {
 	struct move_action_info *move_action = data;
-	float t;
-	if (move_action->duration_type == DURATION_TYPE_INFINITE) {
-		const bool enabled = obs_source_enabled(move_action->move_filter.source);
-		if (move_action->move_filter.enabled != enabled) {
-			if (enabled && (move_action->move_filter.start_trigger == START_TRIGGER_ENABLE ||
-					(move_action->move_filter.enabled_match_moving && !move_action->move_filter.moving)))
-				move_filter_start(&move_action->move_filter);
-			if (enabled && move_action->move_filter.stop_trigger == START_TRIGGER_ENABLE) {
-				move_filter_stop(&move_action->move_filter);
-				obs_queue_task(OBS_TASK_UI, move_action_execute, &move_action->end_action, false);
-				move_filter_ended(&move_action->move_filter);
-			}
+	if (move_action->duration_type == DURATION_TYPE_INFINITE)
+		move_action_end(move_action);
+}
 
-			move_action->move_filter.enabled = enabled;
-		}
-		if (move_action->move_filter.enabled_match_moving && enabled != move_action->move_filter.moving) {
-			if (enabled) {
-				move_filter_start(&move_action->move_filter);
-			} else {
-				move_filter_stop(&move_action->move_filter);
-				obs_queue_task(OBS_TASK_UI, move_action_execute, &move_action->end_action, false);
-				move_filter_ended(&move_action->move_filter);
-			}
+static void move_action_tick_internal(void *data, float seconds)
+{
+	struct move_action_info *move_action = data;
+	float t;
+	if (move_action->end_request_waiting) {
+		const long result = os_atomic_load_long(&move_action->end_request_result);
+		if (result == MOVE_ACTION_REQUEST_RESULT_SUCCESS) {
+			move_action->end_request_waiting = false;
+			move_filter_ended(&move_action->move_filter);
+		} else if (result == MOVE_ACTION_REQUEST_RESULT_FAILED) {
+			move_action->end_request_waiting = false;
+			if (move_action->move_filter.enabled_match_moving && obs_source_enabled(move_action->move_filter.source))
+				obs_source_set_enabled(move_action->move_filter.source, false);
 		}
-		move_action->move_filter.running_duration =
-			(float)(move_action->move_filter.start_delay + move_action->move_filter.duration / 2) / 1000.0f;
+	}
+	if (move_action->duration_type == DURATION_TYPE_INFINITE && move_action->move_filter.moving) {
+		const uint64_t midpoint = move_action->move_filter.start_delay + move_action->move_filter.duration / 2;
+		move_filter_set_elapsed(&move_action->move_filter, midpoint * 1000000ULL);
 		seconds = 0.0f;
 	}
 	if (!move_filter_tick(&move_action->move_filter, seconds, &t))
 		return;
 	if (move_action->start) {
 		move_action->start = false;
-		obs_queue_task(OBS_TASK_UI, move_action_execute, &move_action->start_action, false);
+		move_action_batch_add(move_action, &move_action->start_action);
 	}
 
 	if (!move_action->move_filter.moving) {
 		if ((move_action->start_action.action == MOVE_ACTION_SOURCE_HOTKEY ||
 		     move_action->start_action.action == MOVE_ACTION_FRONTEND_HOTKEY) &&
 		    move_action->start_action.hotkey_id != OBS_INVALID_HOTKEY_ID)
-			obs_queue_task(OBS_TASK_UI, move_action_hotkey_end, data, false);
-		obs_queue_task(OBS_TASK_UI, move_action_execute, &move_action->end_action, false);
-		move_filter_ended(&move_action->move_filter);
+			move_action_batch_add(move_action, NULL);
+		move_action_end(move_action);
 	}
 }
 
+void move_action_tick(void *data, float seconds)
+{
+	MOVE_PERF_BEGIN(tick_start);
+	move_action_tick_internal(data, seconds);
+	MOVE_PERF_END(MOVE_PERF_ACTION_TICK, tick_start);
+}
+
 void move_action_render(void *data, gs_effect_t *effect)
 {
 	UNUSED_PARAMETER(effect);
@@ -1776,6 +2228,8 @@ struct obs_source_info move_action_filter = {
 	.load = move_action_update,
 	.video_tick = move_action_tick,
 	.video_render = move_action_render,
+	.filter_add = move_filter_add,
+	.filter_remove = move_filter_remove,
 	.activate = move_filter_activate,
 	.deactivate = move_filter_deactivate,
 	.show = move_filter_show,
@@ -1794,6 +2248,8 @@ struct obs_source_info move_audio_action_filter = {
 	.update = move_action_update,
 	.load = move_action_update,
 	.video_tick = move_action_tick,
+	.filter_add = move_filter_add,
+	.filter_remove = move_filter_remove,
 	.activate = move_filter_activate,
 	.deactivate = move_filter_deactivate,
 	.show = move_filter_show,
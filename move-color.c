@@ -0,0 +1,73 @@
+#include "move-color.h"
+#include <graphics/math-defs.h>
+#include <math.h>
+
+void linear_to_oklab(struct vec4 *dst, const struct vec4 *src)
+{
+	const float l = cbrtf(0.4122214708f * src->x + 0.5363325363f * src->y + 0.0514459929f * src->z);
+	const float m = cbrtf(0.2119034982f * src->x + 0.6806995451f * src->y + 0.1073969566f * src->z);
+	const float s = cbrtf(0.0883024619f * src->x + 0.2817188376f * src->y + 0.6299787005f * src->z);
+	dst->x = 0.2104542553f * l + 0.7936177850f * m - 0.0040720468f * s;
+	dst->y = 1.9779984951f * l - 2.4285922050f * m + 0.4505937099f * s;
+	dst->z = 0.0259040371f * l + 0.7827717662f * m - 0.8086757660f * s;
+	dst->w = src->w;
+}
+
+void oklab_to_linear(struct vec4 *dst, const struct vec4 *src)
+{
+	float l = src->x + 0.3963377774f * src->y + 0.2158037573f * src->z;
+	float m = src->x - 0.1055613458f * src->y - 0.0638541728f * src->z;
+	float s = src->x - 0.0894841775f * src->y - 1.2914855480f * src->z;
+	l = l * l * l;
+	m = m * m * m;
+	s = s * s * s;
+	dst->x = 4.0767416621f * l - 3.3077115913f * m + 0.2309699292f * s;
+	dst->y = -1.2684380046f * l + 2.6097574011f * m - 0.3413193965f * s;
+	dst->z = -0.0041960863f * l - 0.7034186147f * m + 1.7076147010f * s;
+	dst->w = src->w;
+}
+
+void color_mix(struct vec4 *dst, const struct vec4 *from, const struct vec4 *to, float t, long long color_space)
+{
+	if (color_space != MOVE_VALUE_COLOR_SPACE_OKLAB && color_space != MOVE_VALUE_COLOR_SPACE_OKLCH) {
+		dst->x = (1.0f - t) * from->x + t * to->x;
+		dst->y = (1.0f - t) * from->y + t * to->y;
+		dst->z = (1.0f - t) * from->z + t * to->z;
+		dst->w = (1.0f - t) * from->w + t * to->w;
+		return;
+	}
+	struct vec4 lab_from;
+	struct vec4 lab_to;
+	struct vec4 lab;
+	linear_to_oklab(&lab_from, from);
+	linear_to_oklab(&lab_to, to);
+	lab.x = (1.0f - t) * lab_from.x + t * lab_to.x;
+	lab.w = (1.0f - t) * lab_from.w + t * lab_to.w;
+	if (color_space == MOVE_VALUE_COLOR_SPACE_OKLCH) {
+		const float c_from = sqrtf(lab_from.y * lab_from.y + lab_from.z * lab_from.z);
+		const float c_to = sqrtf(lab_to.y * lab_to.y + lab_to.z * lab_to.z);
+		float h_from = atan2f(lab_from.z, lab_from.y);
+		float h_to = atan2f(lab_to.z, lab_to.y);
+		// a gray endpoint has no hue, take the hue of the other side
+		if (c_from < EPSILON)
+			h_from = h_to;
+		if (c_to < EPSILON)
+			h_to = h_from;
+		float h_diff = h_to - h_from;
+		if (h_diff > M_PI)
+			h_diff -= 2.0f * M_PI;
+		else if (h_diff < -M_PI)
+			h_diff += 2.0f * M_PI;
+		const float c = (1.0f - t) * c_from + t * c_to;
+		const float h = h_from + t * h_diff;
+		lab.y = c * cosf(h);
+		lab.z = c * sinf(h);
+	} else {
+		lab.y = (1.0f - t) * lab_from.y + t * lab_to.y;
+		lab.z = (1.0f - t) * lab_from.z + t * lab_to.z;
+	}
+	oklab_to_linear(dst, &lab);
+	dst->x = fminf(fmaxf(dst->x, 0.0f), 1.0f);
+	dst->y = fminf(fmaxf(dst->y, 0.0f), 1.0f);
+	dst->z = fminf(fmaxf(dst->z, 0.0f), 1.0f);
+}
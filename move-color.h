@@ -0,0 +1,13 @@
+#pragma once
+
+#include <graphics/vec4.h>
+
+#define MOVE_VALUE_COLOR_SPACE_LINEAR 0
+#define MOVE_VALUE_COLOR_SPACE_OKLAB 1
+#define MOVE_VALUE_COLOR_SPACE_OKLCH 2
+
+// colors are linear sRGB, oklab is stored as x = L, y = a, z = b with alpha kept in w
+void linear_to_oklab(struct vec4 *dst, const struct vec4 *src);
+void oklab_to_linear(struct vec4 *dst, const struct vec4 *src);
+// OKLCH takes the shortest way around the hue circle
+void color_mix(struct vec4 *dst, const struct vec4 *from, const struct vec4 *to, float t, long long color_space);
@@ -914,6 +914,8 @@ void SetMoveDirectShowFilter(struct obs_source_info *info)
 	info->destroy = move_directshow_destroy;
 	info->get_properties = move_directshow_properties;
 	info->video_tick = move_directshow_tick;
+	info->filter_add = move_filter_add;
+	info->filter_remove = move_filter_remove;
 	info->update = move_directshow_update;
 	info->load = move_directshow_update;
 	info->get_defaults = move_filter_defaults;
@@ -0,0 +1,134 @@
+#include "move-transition.h"
+#include "easing.h"
+
+float get_eased(float f, long long easing, long long easing_function)
+{
+	float t = f;
+	if (EASE_NONE == easing) {
+	} else if (EASE_IN == easing) {
+		switch (easing_function) {
+		case EASING_QUADRATIC:
+			t = QuadraticEaseIn(f);
+			break;
+		case EASING_CUBIC:
+			t = CubicEaseIn(f);
+			break;
+		case EASING_QUARTIC:
+			t = QuarticEaseIn(f);
+			break;
+		case EASING_QUINTIC:
+			t = QuinticEaseIn(f);
+			break;
+		case EASING_SINE:
+			t = SineEaseIn(f);
+			break;
+		case EASING_CIRCULAR:
+			t = CircularEaseIn(f);
+			break;
+		case EASING_EXPONENTIAL:
+			t = ExponentialEaseIn(f);
+			break;
+		case EASING_ELASTIC:
+			t = ElasticEaseIn(f);
+			break;
+		case EASING_BOUNCE:
+			t = BounceEaseIn(f);
+			break;
+		case EASING_BACK:
+			t = BackEaseIn(f);
+			break;
+		default:;
+		}
+	} else if (EASE_OUT == easing) {
+		switch (easing_function) {
+		case EASING_QUADRATIC:
+			t = QuadraticEaseOut(f);
+			break;
+		case EASING_CUBIC:
+			t = CubicEaseOut(f);
+			break;
+		case EASING_QUARTIC:
+			t = QuarticEaseOut(f);
+			break;
+		case EASING_QUINTIC:
+			t = QuinticEaseOut(f);
+			break;
+		case EASING_SINE:
+			t = SineEaseOut(f);
+			break;
+		case EASING_CIRCULAR:
+			t = CircularEaseOut(f);
+			break;
+		case EASING_EXPONENTIAL:
+			t = ExponentialEaseOut(f);
+			break;
+		case EASING_ELASTIC:
+			t = ElasticEaseOut(f);
+			break;
+		case EASING_BOUNCE:
+			t = BounceEaseOut(f);
+			break;
+		case EASING_BACK:
+			t = BackEaseOut(f);
+			break;
+		default:;
+		}
+	} else if (EASE_IN_OUT == easing) {
+		switch (easing_function) {
+		case EASING_QUADRATIC:
+			t = QuadraticEaseInOut(f);
+			break;
+		case EASING_CUBIC:
+			t = CubicEaseInOut(f);
+			break;
+		case EASING_QUARTIC:
+			t = QuarticEaseInOut(f);
+			break;
+		case EASING_QUINTIC:
+			t = QuinticEaseInOut(f);
+			break;
+		case EASING_SINE:
+			t = SineEaseInOut(f);
+			break;
+		case EASING_CIRCULAR:
+			t = CircularEaseInOut(f);
+			break;
+		case EASING_EXPONENTIAL:
+			t = ExponentialEaseInOut(f);
+			break;
+		case EASING_ELASTIC:
+			t = ElasticEaseInOut(f);
+			break;
+		case EASING_BOUNCE:
+			t = BounceEaseInOut(f);
+			break;
+		case EASING_BACK:
+			t = BackEaseInOut(f);
+			break;
+		default:;
+		}
+	}
+	return t;
+}
+
+void prop_list_add_easings(obs_property_t *p)
+{
+	obs_property_list_add_int(p, obs_module_text("Easing.None"), EASE_NONE);
+	obs_property_list_add_int(p, obs_module_text("Easing.In"), EASE_IN);
+	obs_property_list_add_int(p, obs_module_text("Easing.Out"), EASE_OUT);
+	obs_property_list_add_int(p, obs_module_text("Easing.InOut"), EASE_IN_OUT);
+}
+
+void prop_list_add_easing_functions(obs_property_t *p)
+{
+	obs_property_list_add_int(p, obs_module_text("EasingFunction.Quadratic"), EASING_QUADRATIC);
+	obs_property_list_add_int(p, obs_module_text("EasingFunction.Cubic"), EASING_CUBIC);
+	obs_property_list_add_int(p, obs_module_text("EasingFunction.Quartic"), EASING_QUARTIC);
+	obs_property_list_add_int(p, obs_module_text("EasingFunction.Quintic"), EASING_QUINTIC);
+	obs_property_list_add_int(p, obs_module_text("EasingFunction.Sine"), EASING_SINE);
+	obs_property_list_add_int(p, obs_module_text("EasingFunction.Circular"), EASING_CIRCULAR);
+	obs_property_list_add_int(p, obs_module_text("EasingFunction.Exponential"), EASING_EXPONENTIAL);
+	obs_property_list_add_int(p, obs_module_text("EasingFunction.Elastic"), EASING_ELASTIC);
+	obs_property_list_add_int(p, obs_module_text("EasingFunction.Bounce"), EASING_BOUNCE);
+	obs_property_list_add_int(p, obs_module_text("EasingFunction.Back"), EASING_BACK);
+}
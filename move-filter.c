@@ -37,12 +37,20 @@ bool is_move_filter(const char *filter_id)
 	       strcmp(filter_id, MOVE_DIRECTSHOW_FILTER_ID) == 0;
 }
 
+static void move_filter_rename(void *data, calldata_t *call_data);
+static void move_filter_enable(void *data, calldata_t *call_data);
+static void move_filter_hotkeys_pending_remove(struct move_filter *move_filter);
+
 void move_filter_init(struct move_filter *move_filter, obs_source_t *source, void (*move_start)(void *data))
 {
 	move_filter->source = source;
+	move_filter->filter_name = bstrdup(obs_source_get_name(source));
 	move_filter->move_start_hotkey = OBS_INVALID_HOTKEY_ID;
 	move_filter->move_hold_hotkey = OBS_INVALID_HOTKEY_ID;
 	move_filter->move_start = move_start;
+	signal_handler_t *sh = obs_source_get_signal_handler(source);
+	signal_handler_connect(sh, "rename", move_filter_rename, move_filter);
+	signal_handler_connect(sh, "enable", move_filter_enable, move_filter);
 }
 
 void stop_udp_thread(struct udp_server *udp_server)
@@ -88,6 +96,11 @@ void move_filter_destroy(struct move_filter *move_filter)
 	}
 	pthread_mutex_unlock(&udp_servers_mutex);
 
+	signal_handler_t *sh = obs_source_get_signal_handler(move_filter->source);
+	signal_handler_disconnect(sh, "rename", move_filter_rename, move_filter);
+	signal_handler_disconnect(sh, "enable", move_filter_enable, move_filter);
+	move_filter_hotkeys_pending_remove(move_filter);
+
 	bfree(move_filter->filter_name);
 	bfree(move_filter->simultaneous_move_name);
 	bfree(move_filter->next_move_name);
@@ -198,7 +211,7 @@ void move_filter_hold_hotkey(void *data, obs_hotkey_id id, obs_hotkey_t *hotkey,
 		move_filter->holding = true;
 		return;
 	}
-	move_filter->running_duration = (float)(move_filter->start_delay + move_filter->duration) / 1000.0f;
+	move_filter->running_duration = (move_filter->start_delay + move_filter->duration) * 1000000ULL;
 
 	move_filter->holding = false;
 }
@@ -234,6 +247,7 @@ static void *udp_server_thread(void *data)
 	socklen_t slen = sizeof(si_other);
 	while (true) {
 		recv_len = recvfrom(sockfd, buf, BUFLEN, 0, (struct sockaddr *)&si_other, &slen);
+		MOVE_PERF_BEGIN(received);
 		pthread_mutex_lock(&udp_servers_mutex);
 		if (recv_len == -1) {
 			blog(LOG_ERROR, "[Move Transition] Error receiving udp");
@@ -263,6 +277,9 @@ static void *udp_server_thread(void *data)
 				obs_data_t *settings = obs_source_get_settings(move_filter->source);
 				const char *packet = obs_data_get_string(settings, "start_trigger_udp_packet");
 				if (!strlen(packet) || strcmp(packet, buf) == 0) {
+#ifdef MOVE_PERF
+					move_filter->udp_trigger_time = received;
+#endif
 					move_filter_start(move_filter);
 				}
 				obs_data_release(settings);
@@ -289,37 +306,131 @@ static void *udp_server_thread(void *data)
 	return NULL;
 }
 
-void move_filter_update(struct move_filter *move_filter, obs_data_t *settings)
+static void move_filter_hold_hotkey_name(struct dstr *hotkey_name, const char *filter_name)
 {
-	const char *filter_name = obs_source_get_name(move_filter->source);
-	if (!move_filter->filter_name || strcmp(move_filter->filter_name, filter_name) != 0) {
-		bfree(move_filter->filter_name);
-		move_filter->filter_name = bstrdup(filter_name);
-		if (move_filter->move_start_hotkey != OBS_INVALID_HOTKEY_ID) {
-			obs_hotkey_unregister(move_filter->move_start_hotkey);
-			move_filter->move_start_hotkey = OBS_INVALID_HOTKEY_ID;
-		}
-		if (move_filter->move_hold_hotkey != OBS_INVALID_HOTKEY_ID) {
-			obs_hotkey_unregister(move_filter->move_hold_hotkey);
-			move_filter->move_hold_hotkey = OBS_INVALID_HOTKEY_ID;
-		}
+	dstr_copy(hotkey_name, filter_name);
+	dstr_cat(hotkey_name, " ");
+	dstr_cat(hotkey_name, obs_module_text("Hold"));
+}
+
+// while a scene collection loads, filters are queued and their hotkeys registered in one pass once loading finished
+static DARRAY(struct move_filter *) hotkeys_pending;
+static pthread_mutex_t hotkeys_pending_mutex;
+static bool hotkeys_deferred = false;
+
+static void move_filter_hotkeys_register(struct move_filter *move_filter, obs_source_t *parent)
+{
+	if (move_filter->move_start_hotkey == OBS_INVALID_HOTKEY_ID) {
+		move_filter->move_start_hotkey = obs_hotkey_register_source(
+			parent, move_filter->filter_name, move_filter->filter_name, move_filter_start_hotkey, move_filter);
 	}
-	obs_source_t *parent = obs_filter_get_parent(move_filter->source);
-	if (parent && move_filter->filter_name) {
-		if (move_filter->move_start_hotkey == OBS_INVALID_HOTKEY_ID) {
-			move_filter->move_start_hotkey = obs_hotkey_register_source(
-				parent, move_filter->filter_name, move_filter->filter_name, move_filter_start_hotkey, move_filter);
-		}
-		if (move_filter->move_hold_hotkey == OBS_INVALID_HOTKEY_ID) {
-			struct dstr hotkey_name = {0};
-			dstr_init_copy(&hotkey_name, move_filter->filter_name);
-			dstr_cat(&hotkey_name, " ");
-			dstr_cat(&hotkey_name, obs_module_text("Hold"));
-			move_filter->move_hold_hotkey = obs_hotkey_register_source(parent, hotkey_name.array, hotkey_name.array,
-										   move_filter_hold_hotkey, move_filter);
-			dstr_free(&hotkey_name);
-		}
+	if (move_filter->move_hold_hotkey == OBS_INVALID_HOTKEY_ID) {
+		struct dstr hotkey_name = {0};
+		move_filter_hold_hotkey_name(&hotkey_name, move_filter->filter_name);
+		move_filter->move_hold_hotkey = obs_hotkey_register_source(parent, hotkey_name.array, hotkey_name.array,
+									   move_filter_hold_hotkey, move_filter);
+		dstr_free(&hotkey_name);
+	}
+}
+
+static void move_filter_hotkeys_pending_remove(struct move_filter *move_filter)
+{
+	pthread_mutex_lock(&hotkeys_pending_mutex);
+	da_erase_item(hotkeys_pending, &move_filter);
+	pthread_mutex_unlock(&hotkeys_pending_mutex);
+}
+
+void move_filter_hotkeys_load(void)
+{
+	da_init(hotkeys_pending);
+	pthread_mutex_init(&hotkeys_pending_mutex, NULL);
+	hotkeys_deferred = true;
+}
+
+void move_filter_hotkeys_unload(void)
+{
+	pthread_mutex_lock(&hotkeys_pending_mutex);
+	hotkeys_deferred = false;
+	da_free(hotkeys_pending);
+	pthread_mutex_unlock(&hotkeys_pending_mutex);
+	pthread_mutex_destroy(&hotkeys_pending_mutex);
+}
+
+void move_filter_hotkeys_defer(void)
+{
+	pthread_mutex_lock(&hotkeys_pending_mutex);
+	hotkeys_deferred = true;
+	pthread_mutex_unlock(&hotkeys_pending_mutex);
+}
+
+void move_filter_hotkeys_flush(void)
+{
+	pthread_mutex_lock(&hotkeys_pending_mutex);
+	hotkeys_deferred = false;
+	for (size_t i = 0; i < hotkeys_pending.num; i++) {
+		struct move_filter *move_filter = hotkeys_pending.array[i];
+		obs_source_t *parent = obs_filter_get_parent(move_filter->source);
+		if (parent && move_filter->filter_name)
+			move_filter_hotkeys_register(move_filter, parent);
 	}
+	da_resize(hotkeys_pending, 0);
+	pthread_mutex_unlock(&hotkeys_pending_mutex);
+}
+
+void move_filter_add(void *data, obs_source_t *parent)
+{
+	struct move_filter *move_filter = data;
+	if (!parent || !move_filter->filter_name)
+		return;
+	pthread_mutex_lock(&hotkeys_pending_mutex);
+	if (hotkeys_deferred) {
+		if (da_find(hotkeys_pending, &move_filter, 0) == DARRAY_INVALID)
+			da_push_back(hotkeys_pending, &move_filter);
+		pthread_mutex_unlock(&hotkeys_pending_mutex);
+		return;
+	}
+	pthread_mutex_unlock(&hotkeys_pending_mutex);
+	move_filter_hotkeys_register(move_filter, parent);
+}
+
+void move_filter_remove(void *data, obs_source_t *parent)
+{
+	UNUSED_PARAMETER(parent);
+	struct move_filter *move_filter = data;
+	move_filter_hotkeys_pending_remove(move_filter);
+	if (move_filter->move_start_hotkey != OBS_INVALID_HOTKEY_ID) {
+		obs_hotkey_unregister(move_filter->move_start_hotkey);
+		move_filter->move_start_hotkey = OBS_INVALID_HOTKEY_ID;
+	}
+	if (move_filter->move_hold_hotkey != OBS_INVALID_HOTKEY_ID) {
+		obs_hotkey_unregister(move_filter->move_hold_hotkey);
+		move_filter->move_hold_hotkey = OBS_INVALID_HOTKEY_ID;
+	}
+}
+
+static void move_filter_rename(void *data, calldata_t *call_data)
+{
+	struct move_filter *move_filter = data;
+	const char *new_name = calldata_string(call_data, "new_name");
+	if (!new_name)
+		return;
+	bfree(move_filter->filter_name);
+	move_filter->filter_name = bstrdup(new_name);
+	if (move_filter->move_start_hotkey != OBS_INVALID_HOTKEY_ID) {
+		obs_hotkey_set_name(move_filter->move_start_hotkey, new_name);
+		obs_hotkey_set_description(move_filter->move_start_hotkey, new_name);
+	}
+	if (move_filter->move_hold_hotkey != OBS_INVALID_HOTKEY_ID) {
+		struct dstr hotkey_name = {0};
+		move_filter_hold_hotkey_name(&hotkey_name, new_name);
+		obs_hotkey_set_name(move_filter->move_hold_hotkey, hotkey_name.array);
+		obs_hotkey_set_description(move_filter->move_hold_hotkey, hotkey_name.array);
+		dstr_free(&hotkey_name);
+	}
+}
+
+void move_filter_update(struct move_filter *move_filter, obs_data_t *settings)
+{
 	move_filter->enabled_match_moving = obs_data_get_bool(settings, S_ENABLED_MATCH_MOVING);
 	if (move_filter->enabled_match_moving && !move_filter->moving && obs_source_enabled(move_filter->source))
 		move_filter_start(move_filter);
@@ -456,6 +567,8 @@ void move_filter_update(struct move_filter *move_filter, obs_data_t *settings)
 		move_filter->reverse = false;
 	}
 	move_filter->next_move_on = obs_data_get_int(settings, S_NEXT_MOVE_ON);
+	move_filter->loop_mode = obs_data_get_int(settings, S_LOOP_MODE);
+	move_filter->loop_count = obs_data_get_int(settings, S_LOOP_COUNT);
 }
 
 void move_filter_start(struct move_filter *move_filter)
@@ -463,6 +576,15 @@ void move_filter_start(struct move_filter *move_filter)
 	move_filter->move_start(move_filter);
 }
 
+// a running move goes back from where it is, so the elapsed time is mirrored along with the direction
+void move_filter_turn_around(struct move_filter *move_filter)
+{
+	const uint64_t total = (move_filter->duration + move_filter->start_delay + move_filter->end_delay) * 1000000ULL;
+	move_filter->reverse = !move_filter->reverse;
+	move_filter->loop_reverse = !move_filter->loop_reverse;
+	move_filter_set_elapsed(move_filter, move_filter->running_duration < total ? total - move_filter->running_duration : 0);
+}
+
 bool move_filter_start_internal(struct move_filter *move_filter)
 {
 	if (!move_filter->custom_duration)
@@ -470,14 +592,13 @@ bool move_filter_start_internal(struct move_filter *move_filter)
 	if (move_filter->moving && !move_filter->holding && obs_source_enabled(move_filter->source)) {
 		if (move_filter->next_move_on == NEXT_MOVE_ON_HOTKEY && move_filter->next_move_name &&
 		    strcmp(move_filter->next_move_name, NEXT_MOVE_REVERSE) == 0) {
-			move_filter->reverse = !move_filter->reverse;
-			move_filter->running_duration =
-				(float)(move_filter->duration + move_filter->start_delay + move_filter->end_delay) / 1000.0f -
-				move_filter->running_duration;
+			move_filter_turn_around(move_filter);
 		}
 		return false;
 	}
-	move_filter->running_duration = 0.0f;
+	move_filter_set_elapsed(move_filter, 0);
+	move_filter->loops_done = 0;
+	move_filter->loop_reverse = move_filter->reverse;
 	move_filter->moving = true;
 
 	if (move_filter->enabled_match_moving && !obs_source_enabled(move_filter->source)) {
@@ -505,18 +626,46 @@ bool move_filter_start_internal(struct move_filter *move_filter)
 	return true;
 }
 
+// a ping-pong that stopped in a reverse cycle would otherwise play the next start backwards
+static void move_filter_loop_restore(struct move_filter *move_filter)
+{
+	if (!move_filter->loops_done)
+		return;
+	move_filter->reverse = move_filter->loop_reverse;
+	move_filter->loops_done = 0;
+}
+
 void move_filter_stop(struct move_filter *move_filter)
 {
 	if (move_filter->holding)
 		return;
 	move_filter->moving = false;
+	move_filter_loop_restore(move_filter);
 	if (move_filter->enabled_match_moving && obs_source_enabled(move_filter->source)) {
 		obs_source_set_enabled(move_filter->source, false);
 	}
 }
 
+// time the move ran past its end in the frame it ended
+static uint64_t move_filter_overshoot(const struct move_filter *move_filter)
+{
+	const uint64_t total = (move_filter->start_delay + move_filter->duration + move_filter->end_delay) * 1000000ULL;
+	return move_filter->running_duration > total ? move_filter->running_duration - total : 0;
+}
+
+// a move started by the end of another one continues from where the previous one stopped instead of from the next frame
+static void move_filter_carry(struct move_filter *move_filter, uint64_t overshoot, uint64_t frame_time)
+{
+	if (!move_filter->moving || move_filter->running_duration || !overshoot || !frame_time)
+		return;
+	move_filter->running_duration = overshoot;
+	move_filter->running_frame_time = frame_time;
+}
+
 extern void move_filter_ended(struct move_filter *move_filter)
 {
+	const uint64_t overshoot = move_filter_overshoot(move_filter);
+	const uint64_t frame_time = move_filter->running_frame_time;
 	if (move_filter->enabled_match_moving &&
 	    (move_filter->reverse || move_filter->next_move_on == NEXT_MOVE_ON_HOTKEY || !move_filter->next_move_name ||
 	     strcmp(move_filter->next_move_name, NEXT_MOVE_REVERSE) != 0) &&
@@ -528,8 +677,10 @@ extern void move_filter_ended(struct move_filter *move_filter)
 	    (!move_filter->filter_name || strcmp(move_filter->filter_name, move_filter->next_move_name) != 0)) {
 		if (strcmp(move_filter->next_move_name, NEXT_MOVE_REVERSE) == 0) {
 			move_filter->reverse = !move_filter->reverse;
-			if (move_filter->reverse)
+			if (move_filter->reverse) {
 				move_filter_start(move_filter);
+				move_filter_carry(move_filter, overshoot, frame_time);
+			}
 		} else {
 			obs_source_t *parent = obs_filter_get_parent(move_filter->source);
 			if (parent) {
@@ -542,6 +693,7 @@ extern void move_filter_ended(struct move_filter *move_filter)
 				if (filter) {
 					if (!obs_source_removed(filter) && is_move_filter(obs_source_get_unversioned_id(filter))) {
 						move_filter_start(obs_obj_get_data(filter));
+						move_filter_carry(obs_obj_get_data(filter), overshoot, frame_time);
 					}
 
 					obs_source_release(filter);
@@ -554,35 +706,17 @@ extern void move_filter_ended(struct move_filter *move_filter)
 	}
 }
 
-float get_eased(float f, long long easing, long long easing_function);
-
-bool move_filter_tick(struct move_filter *move_filter, float seconds, float *tp)
+static void move_filter_enabled_changed(struct move_filter *move_filter, bool enabled)
 {
-	if (move_filter->filter_name &&
-	    (move_filter->move_start_hotkey == OBS_INVALID_HOTKEY_ID || move_filter->move_hold_hotkey == OBS_INVALID_HOTKEY_ID)) {
-		obs_source_t *parent = obs_filter_get_parent(move_filter->source);
-		if (parent && move_filter->move_start_hotkey == OBS_INVALID_HOTKEY_ID) {
-			move_filter->move_start_hotkey = obs_hotkey_register_source(
-				parent, move_filter->filter_name, move_filter->filter_name, move_filter_start_hotkey, move_filter);
-		}
-		if (parent && move_filter->move_hold_hotkey == OBS_INVALID_HOTKEY_ID) {
-			struct dstr hotkey_name = {0};
-			dstr_init_copy(&hotkey_name, move_filter->filter_name);
-			dstr_cat(&hotkey_name, " ");
-			dstr_cat(&hotkey_name, obs_module_text("Hold"));
-			move_filter->move_hold_hotkey = obs_hotkey_register_source(parent, hotkey_name.array, hotkey_name.array,
-										   move_filter_hold_hotkey, move_filter);
-			dstr_free(&hotkey_name);
-		}
-	}
-
-	const bool enabled = obs_source_enabled(move_filter->source);
 	if (move_filter->enabled != enabled) {
 		if (enabled && (move_filter->start_trigger == START_TRIGGER_ENABLE ||
 				(move_filter->enabled_match_moving && !move_filter->moving)))
 			move_filter_start(move_filter);
-		if (enabled && move_filter->stop_trigger == START_TRIGGER_ENABLE)
+		if (enabled && move_filter->stop_trigger == START_TRIGGER_ENABLE) {
 			move_filter_stop(move_filter);
+			if (move_filter->enable_stopped)
+				move_filter->enable_stopped(move_filter);
+		}
 
 		move_filter->enabled = enabled;
 	}
@@ -591,45 +725,124 @@ bool move_filter_tick(struct move_filter *move_filter, float seconds, float *tp)
 			move_filter_start(move_filter);
 		} else {
 			move_filter_stop(move_filter);
+			if (move_filter->enable_stopped)
+				move_filter->enable_stopped(move_filter);
 		}
 	}
-	if (!move_filter->moving || !enabled)
+}
+
+// the enable signal runs on the UI thread, the transition is handed to the tick
+static void move_filter_enable(void *data, calldata_t *call_data)
+{
+	struct move_filter *move_filter = data;
+	os_atomic_set_long(&move_filter->enabled_pending,
+			   calldata_bool(call_data, "enabled") ? MOVE_FILTER_ENABLED_PENDING_ON : MOVE_FILTER_ENABLED_PENDING_OFF);
+}
+
+bool move_filter_tick(struct move_filter *move_filter, float seconds, float *tp)
+{
+	// later changes come from the enable signal, so only the state the filter was created with is checked here
+	if (!move_filter->enabled_checked) {
+		move_filter->enabled_checked = true;
+		os_atomic_set_long(&move_filter->enabled_pending, MOVE_FILTER_ENABLED_PENDING_NONE);
+		move_filter_enabled_changed(move_filter, obs_source_enabled(move_filter->source));
+	}
+	const long enabled_pending = os_atomic_exchange_long(&move_filter->enabled_pending, MOVE_FILTER_ENABLED_PENDING_NONE);
+	if (enabled_pending != MOVE_FILTER_ENABLED_PENDING_NONE)
+		move_filter_enabled_changed(move_filter, enabled_pending == MOVE_FILTER_ENABLED_PENDING_ON);
+	if (!move_filter->moving || !move_filter->enabled) {
+		move_filter->running_frame_time = 0;
 		return false;
+	}
+#ifdef MOVE_PERF
+	if (move_filter->udp_trigger_time) {
+		MOVE_PERF_END(MOVE_PERF_UDP_TRIGGER, move_filter->udp_trigger_time);
+		move_filter->udp_trigger_time = 0;
+	}
+#endif
 
-	move_filter->running_duration += seconds;
-	if (move_filter->running_duration * 1000.0f < (move_filter->reverse ? move_filter->end_delay : move_filter->start_delay)) {
+	// advance by the difference between video frame timestamps so long moves do not accumulate rounding errors
+	const uint64_t frame_time = obs_get_video_frame_time();
+	if (!move_filter->running_frame_time)
+		move_filter->running_duration += (uint64_t)((double)seconds * 1000000000.0);
+	else if (frame_time > move_filter->running_frame_time)
+		move_filter->running_duration += frame_time - move_filter->running_frame_time;
+	move_filter->running_frame_time = frame_time;
+
+	if (move_filter->running_duration <
+	    (move_filter->reverse ? move_filter->end_delay : move_filter->start_delay) * 1000000ULL) {
 		return false;
 	}
 	if (move_filter->holding) {
 		move_filter_start(move_filter);
-		move_filter->running_duration = (float)(move_filter->start_delay + move_filter->duration) / 1000.0f;
+		move_filter->running_duration = (move_filter->start_delay + move_filter->duration) * 1000000ULL;
 
 		*tp = 1.0f;
 		return true;
 	}
 
-	if (move_filter->running_duration * 1000.0f >=
-	    (float)(move_filter->start_delay + move_filter->duration + move_filter->end_delay)) {
+	const uint64_t total = (move_filter->start_delay + move_filter->duration + move_filter->end_delay) * 1000000ULL;
+	if (move_filter->running_duration >= total && move_filter->loop_mode != LOOP_MODE_NONE && total &&
+	    (!move_filter->loop_count || move_filter->loops_done + 1 < move_filter->loop_count)) {
+		// next cycle keeps the from and to state of the running move and the time past the end
+		move_filter->running_duration %= total;
+		move_filter->loops_done++;
+		if (move_filter->loop_mode == LOOP_MODE_PING_PONG)
+			move_filter->reverse = !move_filter->reverse;
+	} else if (move_filter->running_duration >= total) {
 		move_filter->moving = false;
 	}
-	if (!move_filter->duration) {
-		*tp = 1.0f;
-		return true;
-	}
-	float t = (move_filter->running_duration * 1000.0f -
-		   (float)(move_filter->reverse ? move_filter->end_delay : move_filter->start_delay)) /
-		  (float)move_filter->duration;
-	if (t >= 1.0f) {
-		t = 1.0f;
-	}
-	if (move_filter->reverse) {
-		t = 1.0f - t;
+	float t = 1.0f;
+	if (move_filter->duration) {
+		t = move_filter_progress(move_filter);
+		if (move_filter->reverse) {
+			t = 1.0f - t;
+		}
+		t = get_eased(t, move_filter->easing, move_filter->easing_function);
 	}
-	t = get_eased(t, move_filter->easing, move_filter->easing_function);
+	// the last cycle ends in its own direction, the next start goes the way this one started
+	if (!move_filter->moving)
+		move_filter_loop_restore(move_filter);
 	*tp = t;
 	return true;
 }
 
+// linear progress of the move from the elapsed time only, so timing can be checked without a running source
+float move_filter_progress(const struct move_filter *move_filter)
+{
+	if (!move_filter->duration)
+		return move_filter->moving ? 0.0f : 1.0f;
+	const uint64_t delay = (move_filter->reverse ? move_filter->end_delay : move_filter->start_delay) * 1000000ULL;
+	if (move_filter->running_duration <= delay)
+		return 0.0f;
+	const uint64_t duration = move_filter->duration * 1000000ULL;
+	if (move_filter->running_duration - delay >= duration)
+		return 1.0f;
+	return (float)((double)(move_filter->running_duration - delay) / (double)duration);
+}
+
+uint64_t move_filter_remaining(const struct move_filter *move_filter)
+{
+	const uint64_t total = (move_filter->start_delay + move_filter->duration + move_filter->end_delay) * 1000000ULL;
+	return move_filter->running_duration < total ? (total - move_filter->running_duration) / 1000000ULL : 0;
+}
+
+void move_filter_set_elapsed(struct move_filter *move_filter, uint64_t elapsed)
+{
+	move_filter->running_duration = elapsed;
+	move_filter->running_frame_time = obs_get_video_frame_time();
+}
+
+void move_filter_seek(struct move_filter *move_filter, float t)
+{
+	if (t < 0.0f)
+		t = 0.0f;
+	else if (t > 1.0f)
+		t = 1.0f;
+	const uint64_t delay = (move_filter->reverse ? move_filter->end_delay : move_filter->start_delay) * 1000000ULL;
+	move_filter_set_elapsed(move_filter, delay + (uint64_t)((double)t * (double)(move_filter->duration * 1000000ULL)));
+}
+
 bool move_filter_start_button(obs_properties_t *props, obs_property_t *property, void *data)
 {
 	struct move_filter *move_filter = data;
@@ -758,10 +971,36 @@ void move_filter_properties(struct move_filter *move_filter, obs_properties_t *p
 	obs_property_list_add_int(p, obs_module_text("NextMoveOn.End"), NEXT_MOVE_ON_END);
 	obs_property_list_add_int(p, obs_module_text("NextMoveOn.Hotkey"), NEXT_MOVE_ON_HOTKEY);
 
+	move_filter_loop_properties(ppts);
+
 	obs_properties_add_button(ppts, "move_filter_start", obs_module_text("Start"), move_filter_start_button);
 	obs_properties_add_text(ppts, "plugin_info", PLUGIN_INFO, OBS_TEXT_INFO);
 }
 
+static bool move_filter_loop_mode_changed(obs_properties_t *props, obs_property_t *property, obs_data_t *settings)
+{
+	UNUSED_PARAMETER(property);
+	obs_property_t *count = obs_properties_get(props, S_LOOP_COUNT);
+	const bool loop = obs_data_get_int(settings, S_LOOP_MODE) != LOOP_MODE_NONE;
+	if (obs_property_visible(count) == loop)
+		return false;
+	obs_property_set_visible(count, loop);
+	return true;
+}
+
+void move_filter_loop_properties(obs_properties_t *ppts)
+{
+	obs_property_t *p =
+		obs_properties_add_list(ppts, S_LOOP_MODE, obs_module_text("LoopMode"), OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
+	obs_property_list_add_int(p, obs_module_text("LoopMode.None"), LOOP_MODE_NONE);
+	obs_property_list_add_int(p, obs_module_text("LoopMode.Loop"), LOOP_MODE_LOOP);
+	obs_property_list_add_int(p, obs_module_text("LoopMode.PingPong"), LOOP_MODE_PING_PONG);
+	obs_property_set_modified_callback(p, move_filter_loop_mode_changed);
+
+	p = obs_properties_add_int(ppts, S_LOOP_COUNT, obs_module_text("LoopCount"), 0, 1000000, 1);
+	obs_property_set_long_description(p, obs_module_text("LoopCount.Description"));
+}
+
 void move_filter_defaults(obs_data_t *settings)
 {
 	obs_data_set_default_bool(settings, S_ENABLED_MATCH_MOVING, true);
@@ -0,0 +1,804 @@
+#include "move-match.h"
+#include <string.h>
+
+void get_override_filter(obs_source_t *source, obs_source_t *filter, void *param)
+{
+	UNUSED_PARAMETER(source);
+	if (!obs_source_enabled(filter))
+		return;
+	if (strcmp(obs_source_get_unversioned_id(filter), "move_transition_override_filter") != 0)
+		return;
+	obs_source_t *target = *(obs_source_t **)param;
+	if (!target) {
+		*(obs_source_t **)param = filter;
+		return;
+	}
+
+	if (obs_source_get_type(target) == OBS_SOURCE_TYPE_FILTER)
+		return;
+	obs_data_t *settings = obs_source_get_settings(filter);
+	if (!settings)
+		return;
+	const char *sn = obs_data_get_string(settings, S_SOURCE);
+	if (sn && strlen(sn)) {
+		if (strcmp(obs_source_get_name(target), sn) == 0) {
+			*(obs_source_t **)param = filter;
+		}
+	}
+	obs_data_release(settings);
+}
+
+obs_data_t *get_override_filter_settings(obs_sceneitem_t *item)
+{
+	if (!item)
+		return NULL;
+	obs_source_t *filter = obs_sceneitem_get_source(item);
+	obs_scene_t *scene = obs_sceneitem_get_scene(item);
+	if (scene) {
+		obs_source_t *scene_source = obs_scene_get_source(scene);
+		obs_source_enum_filters(scene_source, get_override_filter, &filter);
+	}
+
+	obs_source_t *source = obs_sceneitem_get_source(item);
+	if (!source)
+		return NULL;
+
+	if (filter && filter != source)
+		return obs_source_get_settings(filter);
+
+	filter = NULL;
+	obs_source_enum_filters(source, get_override_filter, &filter);
+	if (filter && filter != source)
+		return obs_source_get_settings(filter);
+	return NULL;
+}
+
+struct move_item *match_item_by_override(struct move_info *move, obs_sceneitem_t *scene_item, size_t *found_pos)
+{
+	struct move_item *item = NULL;
+	obs_source_t *source = obs_sceneitem_get_source(scene_item);
+	const char *name_b = obs_source_get_name(source);
+	obs_data_t *override_filter_b = get_override_filter_settings(scene_item);
+	const char *override_name_b = override_filter_b ? obs_data_get_string(override_filter_b, S_MATCH_SOURCE) : NULL;
+	obs_data_release(override_filter_b);
+	for (size_t i = 0; i < move->items_a.num; i++) {
+		struct move_item *check_item = move->items_a.array[i];
+		if (check_item->item_b)
+			continue;
+		obs_source_t *check_source = obs_sceneitem_get_source(check_item->item_a);
+		if (!check_source)
+			continue;
+		const char *name_a = obs_source_get_name(check_source);
+		if (name_a && strlen(name_a) && override_name_b && strcmp(name_a, override_name_b) == 0) {
+			item = check_item;
+			*found_pos = i;
+			break;
+		}
+		if (!name_b || !strlen(name_b))
+			continue;
+		obs_data_t *override_filter_a = get_override_filter_settings(check_item->item_a);
+		if (override_filter_a) {
+			const char *override_name_a = obs_data_get_string(override_filter_a, S_MATCH_SOURCE);
+			obs_data_release(override_filter_a);
+			if (strcmp(override_name_a, name_b) == 0) {
+				item = check_item;
+				*found_pos = i;
+				break;
+			}
+		}
+	}
+	return item;
+}
+
+bool is_number_match(const char c)
+{
+	if (c >= '0' && c <= '9')
+		return true;
+	if (c == '(' || c == ')' || c == ' ' || c == '.' || c == ',')
+		return true;
+	return false;
+}
+
+struct move_item *match_item_by_name(struct move_info *move, obs_sceneitem_t *scene_item, size_t *found_pos)
+{
+	struct move_item *item = NULL;
+	obs_source_t *source = obs_sceneitem_get_source(scene_item);
+	const char *name_b = obs_source_get_name(source);
+	if (!name_b || !strlen(name_b))
+		return item;
+	for (size_t i = 0; i < move->items_a.num; i++) {
+		struct move_item *check_item = move->items_a.array[i];
+		if (check_item->item_b)
+			continue;
+
+		obs_source_t *check_source = obs_sceneitem_get_source(check_item->item_a);
+		if (!check_source)
+			continue;
+		if (check_source == source) {
+			item = check_item;
+			*found_pos = i;
+			break;
+		}
+		const char *name_a = obs_source_get_name(check_source);
+		if (!name_a)
+			continue;
+		if (strcmp(name_a, name_b) == 0) {
+			item = check_item;
+			*found_pos = i;
+			break;
+		}
+	}
+	return item;
+}
+
+struct move_item *match_item_by_type_and_settings(struct move_info *move, obs_sceneitem_t *scene_item, size_t *found_pos)
+{
+
+	struct move_item *item = NULL;
+	obs_source_t *source = obs_sceneitem_get_source(scene_item);
+	if (obs_source_is_scene(source) || obs_source_is_group(source))
+		return item;
+	for (size_t i = 0; i < move->items_a.num; i++) {
+		struct move_item *check_item = move->items_a.array[i];
+		if (check_item->item_b)
+			continue;
+
+		obs_source_t *check_source = obs_sceneitem_get_source(check_item->item_a);
+		if (!check_source)
+			continue;
+		if (obs_source_get_type(check_source) != obs_source_get_type(source))
+			continue;
+
+		if (strcmp(obs_source_get_unversioned_id(check_source), obs_source_get_unversioned_id(source)) != 0)
+			continue;
+
+		obs_data_t *settings = obs_source_get_settings(source);
+		obs_data_t *check_settings = obs_source_get_settings(check_source);
+		if (settings && check_settings && strcmp(obs_data_get_json(settings), obs_data_get_json(check_settings)) == 0) {
+			item = check_item;
+			*found_pos = i;
+			obs_data_release(check_settings);
+			obs_data_release(settings);
+			break;
+		}
+		obs_data_release(check_settings);
+		obs_data_release(settings);
+	}
+	return item;
+}
+
+struct move_item *match_item_clone(struct move_info *move, obs_sceneitem_t *scene_item, size_t *found_pos)
+{
+	struct move_item *item = NULL;
+	obs_source_t *source = obs_sceneitem_get_source(scene_item);
+	const char *name_b = obs_source_get_name(source);
+	if (!name_b || !strlen(name_b))
+		return item;
+	for (size_t i = 0; i < move->items_a.num; i++) {
+		struct move_item *check_item = move->items_a.array[i];
+		if (check_item->item_b)
+			continue;
+		obs_source_t *check_source = obs_sceneitem_get_source(check_item->item_a);
+		if (!check_source)
+			continue;
+		const char *name_a = obs_source_get_name(check_source);
+		if (!name_a || !strlen(name_a))
+			continue;
+		const char *id_a = obs_source_get_unversioned_id(check_source);
+		const char *id_b = obs_source_get_unversioned_id(source);
+		const char *clone_a = NULL;
+		const char *clone_b = NULL;
+		if (strcmp(id_a, "source-clone") == 0) {
+			obs_data_t *s = obs_source_get_settings(check_source);
+			clone_a = obs_data_get_string(s, "clone");
+			obs_data_release(s);
+		} else if (strcmp(id_a, "streamfx-source-mirror") == 0) {
+			obs_data_t *s = obs_source_get_settings(check_source);
+			clone_a = obs_data_get_string(s, "Source.Mirror.Source");
+			obs_data_release(s);
+		}
+
+		if (strcmp(id_b, "source-clone") == 0) {
+			obs_data_t *s = obs_source_get_settings(source);
+			clone_b = obs_data_get_string(s, "clone");
+			obs_data_release(s);
+		} else if (strcmp(id_b, "streamfx-source-mirror") == 0) {
+			obs_data_t *s = obs_source_get_settings(check_source);
+			clone_b = obs_data_get_string(s, "Source.Mirror.Source");
+			obs_data_release(s);
+		}
+		if ((clone_a && clone_b && strcmp(clone_a, clone_b) == 0) || (clone_a && strcmp(clone_a, name_b) == 0) ||
+		    (clone_b && strcmp(clone_b, name_a) == 0)) {
+			item = check_item;
+			*found_pos = i;
+			break;
+		}
+	}
+	return item;
+}
+
+// length of the name without its last word and trailing numbers, depending on the match options
+static size_t move_name_part_length(const char *name, size_t len, bool last_word_match, bool number_match)
+{
+	if (last_word_match) {
+		const char *last_space = strrchr(name, ' ');
+		if (last_space && last_space > name)
+			len = last_space - name;
+	}
+	while (len > 0 && number_match && is_number_match(name[len - 1]))
+		len--;
+	return len;
+}
+
+static bool move_name_part_match(const char *name, size_t len, const char *part, size_t part_len, bool part_match)
+{
+	if (!part_len)
+		return false;
+	if (!part_match)
+		return memcmp(name, part, part_len) == 0;
+	for (size_t pos = 0; pos <= len - part_len; pos++) {
+		if (memcmp(name + pos, part, part_len) == 0)
+			return true;
+	}
+	return false;
+}
+
+struct move_item *match_item_name_part(struct move_info *move, obs_sceneitem_t *scene_item, size_t *found_pos)
+{
+	struct move_item *item = NULL;
+
+	if (!move->last_word_match && !move->number_match && !move->part_match)
+		return item;
+
+	obs_source_t *source = obs_sceneitem_get_source(scene_item);
+	const char *name_b = obs_source_get_name(source);
+	if (!name_b || !strlen(name_b))
+		return item;
+	const size_t len_b = strlen(name_b);
+	const size_t part_len_b = move_name_part_length(name_b, len_b, move->last_word_match, move->number_match);
+	for (size_t i = 0; i < move->items_a.num; i++) {
+		struct move_item *check_item = move->items_a.array[i];
+		if (check_item->item_b)
+			continue;
+
+		obs_source_t *check_source = obs_sceneitem_get_source(check_item->item_a);
+		if (!check_source)
+			continue;
+		const char *name_a = obs_source_get_name(check_source);
+		if (!name_a)
+			continue;
+
+		const size_t len_a = strlen(name_a);
+		if (!len_a)
+			continue;
+
+		// the shorter name is trimmed and looked for in the longer one
+		bool matched;
+		if (len_a > len_b) {
+			matched = move_name_part_match(name_a, len_a, name_b, part_len_b, move->part_match);
+		} else {
+			const size_t part_len_a = move_name_part_length(name_a, len_a, move->last_word_match, move->number_match);
+			matched = move_name_part_match(name_b, len_b, name_a, part_len_a, move->part_match);
+		}
+		if (matched) {
+			item = check_item;
+			*found_pos = i;
+			break;
+		}
+	}
+	return item;
+}
+
+struct match_item_clone_match {
+	const char *name;
+	obs_sceneitem_t *matched;
+};
+
+bool match_item_clone_match(obs_scene_t *scene, obs_sceneitem_t *sceneitem, void *p)
+{
+	UNUSED_PARAMETER(scene);
+	if (!obs_sceneitem_visible(sceneitem))
+		return true;
+	struct match_item_clone_match *mi = p;
+	obs_source_t *source = obs_sceneitem_get_source(sceneitem);
+	const char *id = obs_source_get_unversioned_id(source);
+	bool match = false;
+	if (strcmp(id, "source-clone") == 0) {
+		obs_data_t *s = obs_source_get_settings(source);
+		match = strcmp(obs_data_get_string(s, "clone"), mi->name) == 0;
+		obs_data_release(s);
+	} else if (strcmp(id, "streamfx-source-mirror") == 0) {
+		obs_data_t *s = obs_source_get_settings(source);
+		match = strcmp(obs_data_get_string(s, "Source.Mirror.Source"), mi->name) == 0;
+		obs_data_release(s);
+	}
+	if (match) {
+		mi->matched = sceneitem;
+		return false;
+	}
+	return true;
+}
+
+obs_sceneitem_t *scene_find_source(obs_scene_t *scene, const char *name)
+{
+	obs_sceneitem_t *item = obs_scene_find_source(scene, name);
+	if (!item) {
+		struct match_item_clone_match mi;
+		mi.name = name;
+		mi.matched = NULL;
+		obs_scene_enum_items(scene, match_item_clone_match, &mi);
+		item = mi.matched;
+	}
+	return item;
+}
+
+struct match_item_nested_match {
+	obs_source_t *check_source;
+	bool matched;
+	bool scene_flip_horizontal;
+	bool scene_flip_vertical;
+};
+
+bool match_item_nested_all_match(obs_scene_t *obs_scene, obs_sceneitem_t *sceneitem, void *p)
+{
+	UNUSED_PARAMETER(obs_scene);
+	if (!obs_sceneitem_visible(sceneitem))
+		return true;
+	struct match_item_nested_match *mi = p;
+	obs_source_t *source = obs_sceneitem_get_source(sceneitem);
+	if (!source)
+		return true;
+	obs_scene_t *scene = obs_scene_from_source(mi->check_source);
+	if (!scene)
+		scene = obs_group_from_source(mi->check_source);
+	const char *source_name = obs_source_get_name(source);
+	obs_sceneitem_t *item = scene_find_source(scene, source_name);
+	if (!item) {
+		source_name = NULL;
+		const char *id = obs_source_get_unversioned_id(source);
+		if (strcmp(id, "source-clone") == 0) {
+			obs_data_t *s = obs_source_get_settings(source);
+			source_name = obs_data_get_string(s, "clone");
+			obs_data_release(s);
+		} else if (strcmp(id, "streamfx-source-mirror") == 0) {
+			obs_data_t *s = obs_source_get_settings(source);
+			source_name = obs_data_get_string(s, "Source.Mirror.Source");
+			obs_data_release(s);
+		}
+		if (source_name)
+			item = scene_find_source(scene, source_name);
+	}
+	if (!item) {
+		mi->matched = false;
+		return false;
+	}
+	return true;
+}
+
+struct move_item *match_item_scene_same(struct move_info *move, obs_sceneitem_t *scene_item, size_t *found_pos)
+{
+	struct move_item *item = NULL;
+	if (!move->nested_scenes)
+		return item;
+	obs_source_t *source = obs_sceneitem_get_source(scene_item);
+	if (!obs_source_is_scene(source) && !obs_source_is_group(source))
+		return item;
+	obs_scene_t *scene = obs_scene_from_source(source);
+	if (!scene)
+		scene = obs_group_from_source(source);
+
+	for (size_t i = 0; i < move->items_a.num; i++) {
+		struct move_item *check_item = move->items_a.array[i];
+		if (check_item->item_b || check_item->move_scene)
+			continue;
+
+		obs_source_t *check_source = obs_sceneitem_get_source(check_item->item_a);
+		if (!check_source)
+			continue;
+
+		if (!obs_source_is_scene(check_source) && !obs_source_is_group(check_source))
+			continue;
+
+		obs_scene_t *check_scene = obs_scene_from_source(check_source);
+		if (!check_scene)
+			check_scene = obs_group_from_source(check_source);
+
+		struct match_item_nested_match mi;
+		mi.check_source = check_source;
+		mi.matched = true;
+		obs_scene_enum_items(scene, match_item_nested_all_match, &mi);
+		mi.check_source = source;
+		obs_scene_enum_items(check_scene, match_item_nested_all_match, &mi);
+		if (mi.matched) {
+			item = check_item;
+			item->move_scene = true;
+			*found_pos = i;
+			break;
+		}
+	}
+	return item;
+}
+
+bool match_item_nested_match(obs_scene_t *obs_scene, obs_sceneitem_t *sceneitem, void *p)
+{
+	UNUSED_PARAMETER(obs_scene);
+	if (!obs_sceneitem_visible(sceneitem))
+		return true;
+	struct match_item_nested_match *mi = p;
+	obs_source_t *source = obs_sceneitem_get_source(sceneitem);
+	if (!source)
+		return true;
+	if (source == mi->check_source) {
+		mi->matched = true;
+		struct vec2 scale;
+		obs_sceneitem_get_scale(sceneitem, &scale);
+		mi->scene_flip_horizontal = mi->scene_flip_horizontal && scale.x < 0.0f;
+		mi->scene_flip_vertical = mi->scene_flip_vertical && scale.y < 0.0f;
+		return false;
+	}
+	const char *name_a = obs_source_get_name(mi->check_source);
+	const char *name_b = obs_source_get_name(source);
+	if (name_a && name_b && strlen(name_a) && strlen(name_b) && strcmp(name_a, name_b) == 0) {
+		mi->matched = true;
+		struct vec2 scale;
+		obs_sceneitem_get_scale(sceneitem, &scale);
+		mi->scene_flip_horizontal = mi->scene_flip_horizontal && scale.x < 0.0f;
+		mi->scene_flip_vertical = mi->scene_flip_vertical && scale.y < 0.0f;
+		return false;
+	}
+	return true;
+}
+
+struct move_item *match_item_nested(struct move_info *move, obs_sceneitem_t *scene_item, size_t *found_pos)
+{
+	struct move_item *item = NULL;
+	if (!move->nested_scenes)
+		return item;
+	obs_source_t *source = obs_sceneitem_get_source(scene_item);
+
+	for (size_t i = 0; i < move->items_a.num; i++) {
+		struct move_item *check_item = move->items_a.array[i];
+		if (check_item->item_b || check_item->move_scene)
+			continue;
+
+		obs_source_t *check_source = obs_sceneitem_get_source(check_item->item_a);
+		if (!check_source)
+			continue;
+		if (obs_source_is_scene(source)) {
+			obs_scene_t *scene = obs_scene_from_source(source);
+			struct match_item_nested_match mi;
+			mi.check_source = check_source;
+			mi.matched = false;
+			struct vec2 scale;
+			obs_sceneitem_get_scale(check_item->item_a, &scale);
+			mi.scene_flip_horizontal = scale.x < 0.0f;
+			mi.scene_flip_vertical = scale.y < 0.0f;
+			obs_scene_enum_items(scene, match_item_nested_match, &mi);
+			if (mi.matched) {
+				item = check_item;
+				item->move_scene = true;
+				item->scene_flip_horizontal = mi.scene_flip_horizontal;
+				item->scene_flip_vertical = mi.scene_flip_vertical;
+				*found_pos = i;
+				break;
+			}
+		} else if (obs_source_is_group(source)) {
+			obs_scene_t *scene = obs_group_from_source(source);
+			struct match_item_nested_match mi;
+			mi.check_source = check_source;
+			mi.matched = false;
+			struct vec2 scale;
+			obs_sceneitem_get_scale(check_item->item_a, &scale);
+			mi.scene_flip_horizontal = scale.x < 0.0f;
+			mi.scene_flip_vertical = scale.y < 0.0f;
+			obs_scene_enum_items(scene, match_item_nested_match, &mi);
+			if (mi.matched) {
+				item = check_item;
+				item->move_scene = true;
+				item->scene_flip_horizontal = mi.scene_flip_horizontal;
+				item->scene_flip_vertical = mi.scene_flip_vertical;
+				*found_pos = i;
+				break;
+			}
+		}
+		if (obs_source_is_scene(check_source)) {
+			obs_scene_t *scene = obs_scene_from_source(check_source);
+			struct match_item_nested_match mi;
+			mi.check_source = source;
+			mi.matched = false;
+			struct vec2 scale;
+			obs_sceneitem_get_scale(scene_item, &scale);
+			mi.scene_flip_horizontal = scale.x < 0.0f;
+			mi.scene_flip_vertical = scale.y < 0.0f;
+			obs_scene_enum_items(scene, match_item_nested_match, &mi);
+			if (mi.matched) {
+				item = check_item;
+				item->move_scene = true;
+				item->scene_flip_horizontal = mi.scene_flip_horizontal;
+				item->scene_flip_vertical = mi.scene_flip_vertical;
+				*found_pos = i;
+				break;
+			}
+		} else if (obs_source_is_group(check_source)) {
+			obs_scene_t *scene = obs_group_from_source(check_source);
+			struct match_item_nested_match mi;
+			mi.check_source = source;
+			mi.matched = false;
+			struct vec2 scale;
+			obs_sceneitem_get_scale(scene_item, &scale);
+			mi.scene_flip_horizontal = scale.x < 0.0f;
+			mi.scene_flip_vertical = scale.y < 0.0f;
+			obs_scene_enum_items(scene, match_item_nested_match, &mi);
+			if (mi.matched) {
+				item = check_item;
+				item->move_scene = true;
+				item->scene_flip_horizontal = mi.scene_flip_horizontal;
+				item->scene_flip_vertical = mi.scene_flip_vertical;
+				*found_pos = i;
+				break;
+			}
+		}
+	}
+	return item;
+}
+
+bool match_item_nested_any_match(obs_scene_t *obs_scene, obs_sceneitem_t *sceneitem, void *p)
+{
+	UNUSED_PARAMETER(obs_scene);
+	if (!obs_sceneitem_visible(sceneitem))
+		return true;
+	struct match_item_nested_match *mi = p;
+	obs_source_t *source = obs_sceneitem_get_source(sceneitem);
+	if (!source)
+		return true;
+	obs_scene_t *scene = obs_scene_from_source(mi->check_source);
+	if (!scene)
+		scene = obs_group_from_source(mi->check_source);
+	const char *source_name = obs_source_get_name(source);
+	obs_sceneitem_t *item = scene_find_source(scene, source_name);
+	if (!item) {
+		source_name = NULL;
+		const char *id = obs_source_get_unversioned_id(source);
+		if (strcmp(id, "source-clone") == 0) {
+			obs_data_t *s = obs_source_get_settings(source);
+			source_name = obs_data_get_string(s, "clone");
+			obs_data_release(s);
+		} else if (strcmp(id, "streamfx-source-mirror") == 0) {
+			obs_data_t *s = obs_source_get_settings(source);
+			source_name = obs_data_get_string(s, "Source.Mirror.Source");
+			obs_data_release(s);
+		}
+		if (source_name)
+			item = scene_find_source(scene, source_name);
+	}
+	if (item && obs_sceneitem_visible(item)) {
+		mi->matched = true;
+		return false;
+	}
+	return true;
+}
+
+struct move_item *match_item_scene_match(struct move_info *move, obs_sceneitem_t *scene_item, size_t *found_pos)
+{
+	struct move_item *item = NULL;
+	if (!move->nested_scenes)
+		return item;
+	obs_source_t *source = obs_sceneitem_get_source(scene_item);
+	if (!obs_source_is_scene(source) && !obs_source_is_group(source))
+		return item;
+	obs_scene_t *scene = obs_scene_from_source(source);
+	if (!scene)
+		scene = obs_group_from_source(source);
+
+	for (size_t i = 0; i < move->items_a.num; i++) {
+		struct move_item *check_item = move->items_a.array[i];
+		if (check_item->item_b || check_item->move_scene)
+			continue;
+
+		obs_source_t *check_source = obs_sceneitem_get_source(check_item->item_a);
+		if (!check_source)
+			continue;
+		if (!obs_source_is_scene(check_source) && !obs_source_is_group(check_source))
+			continue;
+
+		obs_scene_t *check_scene = obs_scene_from_source(check_source);
+		if (!check_scene)
+			check_scene = obs_group_from_source(check_source);
+
+		struct match_item_nested_match mi;
+		mi.check_source = check_source;
+		mi.matched = false;
+		obs_scene_enum_items(scene, match_item_nested_any_match, &mi);
+		mi.check_source = source;
+		obs_scene_enum_items(check_scene, match_item_nested_any_match, &mi);
+		if (mi.matched) {
+			item = check_item;
+			item->move_scene = true;
+			*found_pos = i;
+			break;
+		}
+	}
+	return item;
+}
+
+match_function match_functions[MATCH_FUNCTION_COUNT] = {
+	match_item_by_override,          match_item_by_name,    match_item_clone,  match_item_name_part,
+	match_item_by_type_and_settings, match_item_scene_same, match_item_nested, match_item_scene_match};
+
+struct move_item *create_move_item(void)
+{
+	struct move_item *item = bzalloc(sizeof(struct move_item));
+	item->end_percentage = 100;
+	return item;
+}
+
+bool add_item(obs_scene_t *scene, obs_sceneitem_t *scene_item, void *data)
+{
+	UNUSED_PARAMETER(scene);
+	if (!obs_sceneitem_visible(scene_item)) {
+		return true;
+	}
+	struct move_info *move = data;
+	struct move_item *item = create_move_item();
+	da_push_back(move->items_a, &item);
+	obs_sceneitem_addref(scene_item);
+	item->item_a = scene_item;
+	item->move_scene = obs_sceneitem_get_source(scene_item) == move->scene_source_b;
+	if (item->move_scene)
+		move->matched_scene_b = true;
+	return true;
+}
+
+bool match_item(obs_scene_t *scene, obs_sceneitem_t *scene_item, void *data)
+{
+	UNUSED_PARAMETER(scene);
+	if (!obs_sceneitem_visible(scene_item)) {
+		return true;
+	}
+	struct move_info *move = data;
+	size_t old_pos = 0;
+	struct move_item *item;
+	if (obs_sceneitem_get_source(scene_item) == move->scene_source_a) {
+		item = create_move_item();
+		da_insert(move->items_a, move->item_pos, &item);
+		move->item_pos++;
+		item->move_scene = true;
+		move->matched_scene_a = true;
+	} else {
+		for (size_t i = 0; i < MATCH_FUNCTION_COUNT; i++) {
+			item = match_functions[i](move, scene_item, &old_pos);
+			if (item)
+				break;
+		}
+		if (item) {
+			move->matched_items++;
+			if (old_pos >= move->item_pos)
+				move->item_pos = old_pos + 1;
+		} else {
+			item = create_move_item();
+			da_insert(move->items_a, move->item_pos, &item);
+			move->item_pos++;
+		}
+	}
+	obs_sceneitem_addref(scene_item);
+	item->item_b = scene_item;
+
+	da_push_back(move->items_b, &item);
+	return true;
+}
+
+static bool darray_sceneitem_push_back(obs_scene_t *scene, obs_sceneitem_t *item, void *data)
+{
+	UNUSED_PARAMETER(scene);
+	struct darray *array = data;
+	if (obs_sceneitem_visible(item))
+		darray_push_back(sizeof(item), array, &item);
+	return true;
+}
+
+// matches the visible items of scene b against items_a, filled by add_item for scene a
+void move_match_scene_items(struct move_info *move, obs_scene_t *scene_b)
+{
+	//put items in todo array
+	DARRAY(obs_sceneitem_t *) items;
+	da_init(items);
+	obs_scene_enum_items(scene_b, darray_sceneitem_push_back, &items);
+	struct move_item *item = NULL;
+	for (size_t i = items.num; i > 0; i--) {
+		obs_sceneitem_t *scene_item = items.array[i - 1];
+		if (obs_sceneitem_get_source(scene_item) == move->scene_source_a) {
+
+			struct move_item *item = NULL;
+			for (size_t j = 0; j < MATCH_FUNCTION_COUNT; j++) {
+				size_t old_pos = 0;
+				item = match_functions[j](move, scene_item, &old_pos);
+				if (item)
+					break;
+			}
+			if (item && item->move_scene) {
+				obs_sceneitem_release(item->item_a);
+				if (item->release_scene_a)
+					obs_scene_release(item->release_scene_a);
+				if (item->release_scene_b)
+					obs_scene_release(item->release_scene_b);
+				da_erase_item(move->items_a, &item);
+				bfree(item->transition_name);
+				bfree(item);
+				item = create_move_item();
+			} else if (item) {
+				move->matched_items++;
+			} else {
+				item = create_move_item();
+			}
+			item->move_scene = true;
+			move->matched_scene_a = true;
+			da_erase(items, i - 1);
+
+			obs_sceneitem_addref(scene_item);
+			item->item_b = scene_item;
+			da_insert(move->items_b, 0, &item);
+		}
+	}
+	if (!move->matched_scene_a) {
+		for (size_t i = 0; i < MATCH_FUNCTION_COUNT; i++) {
+			for (size_t j = items.num; j > 0; j--) {
+				obs_sceneitem_t *scene_item = items.array[j - 1];
+				size_t old_pos = 0;
+				item = match_functions[i](move, scene_item, &old_pos);
+				if (item) {
+					move->matched_items++;
+
+					da_erase(items, j - 1);
+
+					obs_sceneitem_addref(scene_item);
+					item->item_b = scene_item;
+				}
+			}
+		}
+	}
+	for (size_t i = items.num; i > 0; i--) {
+		obs_sceneitem_t *scene_item = items.array[i - 1];
+		item = create_move_item();
+
+		obs_sceneitem_addref(scene_item);
+		item->item_b = scene_item;
+
+		size_t insert = 0;
+		int order = obs_sceneitem_get_order_position(scene_item);
+		while (insert < move->items_b.num &&
+		       order > obs_sceneitem_get_order_position(move->items_b.array[insert]->item_b)) {
+			insert++;
+		}
+		da_insert(move->items_b, insert, &item);
+	}
+	da_free(items);
+	//add matched items to items_b
+	for (size_t i = 0; i < move->items_a.num; i++) {
+		struct move_item *item = move->items_a.array[i];
+		if (item->item_b) {
+			size_t insert = 0;
+			int order = obs_sceneitem_get_order_position(item->item_b);
+			while (insert < move->items_b.num &&
+			       order > obs_sceneitem_get_order_position(move->items_b.array[insert]->item_b)) {
+				insert++;
+			}
+			da_insert(move->items_b, insert, &item);
+		}
+	}
+	// insert not matched items from items_b into items_a
+	move->item_pos = 0;
+	for (size_t i = 0; i < move->items_b.num; i++) {
+		struct move_item *item = move->items_b.array[i];
+		if (item->item_b && !item->item_a) {
+			da_insert(move->items_a, move->item_pos, &item);
+			move->item_pos++;
+		} else {
+			for (size_t j = move->item_pos; j < move->items_a.num; j++) {
+				if (item == move->items_a.array[j]) {
+					move->item_pos = j + 1;
+					break;
+				}
+			}
+		}
+	}
+}
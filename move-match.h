@@ -0,0 +1,90 @@
+#pragma once
+
+#include "move-transition.h"
+#include <graphics/matrix4.h>
+
+struct move_info {
+	obs_source_t *source;
+	bool start_init;
+	bool first_frame;
+	DARRAY(struct move_item *) items_a;
+	DARRAY(struct move_item *) items_b;
+	float t;
+	float curve_move;
+	float curve_in;
+	float curve_out;
+	obs_source_t *scene_source_a;
+	obs_source_t *scene_source_b;
+	gs_samplerstate_t *point_sampler;
+	long long easing_move;
+	long long easing_in;
+	long long easing_out;
+	long long easing_function_move;
+	long long easing_function_in;
+	long long easing_function_out;
+	float zoom_in;
+	float zoom_out;
+	long long position_in;
+	long long position_out;
+	char *transition_move;
+	char *transition_in;
+	char *transition_out;
+	bool part_match;
+	bool number_match;
+	bool last_word_match;
+	enum obs_transition_scale_type transition_move_scale;
+	size_t item_pos;
+	uint32_t matched_items;
+	bool matched_scene_a;
+	bool matched_scene_b;
+	uint32_t item_order_switch_percentage;
+	bool nested_scenes;
+	bool cache_transitions;
+	DARRAY(obs_source_t *) transition_pool_move;
+	size_t transition_pool_move_index;
+	DARRAY(obs_source_t *) transition_pool_in;
+	size_t transition_pool_in_index;
+	DARRAY(obs_source_t *) transition_pool_out;
+	size_t transition_pool_out_index;
+
+	bool scene_flip_horizontal;
+	bool scene_flip_vertical;
+};
+
+struct move_item {
+	obs_sceneitem_t *item_a;
+	obs_sceneitem_t *item_b;
+	gs_texrender_t *item_render;
+	obs_source_t *transition;
+	long long easing;
+	long long easing_function;
+	float zoom;
+	long long position;
+	char *transition_name;
+	enum obs_transition_scale_type transition_scale;
+	float curve;
+	bool move_scene;
+	int start_percentage;
+	int end_percentage;
+	obs_scene_t *release_scene_a;
+	obs_scene_t *release_scene_b;
+	bool scene_flip_horizontal;
+	bool scene_flip_vertical;
+	struct matrix4 transform_a;
+	struct matrix4 transform_b;
+	struct obs_sceneitem_crop bounds_crop_a;
+	struct obs_sceneitem_crop bounds_crop_b;
+	bool move_filter_a;
+	bool move_filter_b;
+};
+
+typedef struct move_item *(*match_function)(struct move_info *move, obs_sceneitem_t *scene_item, size_t *found_pos);
+
+#define MATCH_FUNCTION_COUNT 8
+extern match_function match_functions[MATCH_FUNCTION_COUNT];
+
+struct move_item *create_move_item(void);
+obs_data_t *get_override_filter_settings(obs_sceneitem_t *item);
+bool add_item(obs_scene_t *scene, obs_sceneitem_t *scene_item, void *data);
+bool match_item(obs_scene_t *scene, obs_sceneitem_t *scene_item, void *data);
+void move_match_scene_items(struct move_info *move, obs_scene_t *scene_b);
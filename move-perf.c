@@ -0,0 +1,212 @@
+#include "move-perf.h"
+
+#ifdef MOVE_PERF
+
+#include <util/bmem.h>
+#include <util/threading.h>
+
+#ifdef _MSC_VER
+#define MOVE_PERF_THREAD_LOCAL __declspec(thread)
+#else
+#define MOVE_PERF_THREAD_LOCAL __thread
+#endif
+
+#define MOVE_PERF_BUCKETS 40
+#define MOVE_PERF_LOG_INTERVAL 60.0f
+
+static const char *move_perf_timer_names[MOVE_PERF_TIMER_COUNT] = {
+	"match", "render", "source_tick", "value_tick", "swap_tick", "action_tick", "audio_tick", "udp_trigger",
+};
+
+static const char *move_perf_event_names[MOVE_PERF_EVENT_COUNT] = {
+	"offscreen_pass",
+	"pool_hit",
+	"pool_miss",
+};
+
+struct move_perf_histogram {
+	uint64_t count;
+	uint64_t total_ns;
+	uint64_t max_ns;
+	// bucket i holds durations in [2^i, 2^(i+1)) ns
+	uint64_t buckets[MOVE_PERF_BUCKETS];
+};
+
+struct move_perf_counters {
+	struct move_perf_histogram timers[MOVE_PERF_TIMER_COUNT];
+	uint64_t events[MOVE_PERF_EVENT_COUNT];
+};
+
+// each thread only writes its own block, readers sum all blocks without locking
+struct move_perf_thread {
+	struct move_perf_counters counters;
+	struct move_perf_thread *next;
+};
+
+static MOVE_PERF_THREAD_LOCAL struct move_perf_thread *move_perf_local = NULL;
+static struct move_perf_thread *move_perf_threads = NULL;
+static pthread_mutex_t move_perf_threads_mutex;
+
+// totals at the last reset and the last periodic log, so both report deltas
+static struct move_perf_counters move_perf_reset_base;
+static struct move_perf_counters move_perf_log_base;
+static pthread_mutex_t move_perf_base_mutex;
+static float move_perf_log_elapsed = 0.0f;
+
+static struct move_perf_counters *move_perf_counters_local(void)
+{
+	if (move_perf_local)
+		return &move_perf_local->counters;
+	struct move_perf_thread *thread = bzalloc(sizeof(struct move_perf_thread));
+	pthread_mutex_lock(&move_perf_threads_mutex);
+	thread->next = move_perf_threads;
+	move_perf_threads = thread;
+	pthread_mutex_unlock(&move_perf_threads_mutex);
+	move_perf_local = thread;
+	return &thread->counters;
+}
+
+void move_perf_record(enum move_perf_timer timer, uint64_t ns)
+{
+	struct move_perf_histogram *histogram = &move_perf_counters_local()->timers[timer];
+	histogram->count++;
+	histogram->total_ns += ns;
+	if (ns > histogram->max_ns)
+		histogram->max_ns = ns;
+	size_t bucket = 0;
+	while (ns >>= 1)
+		bucket++;
+	if (bucket >= MOVE_PERF_BUCKETS)
+		bucket = MOVE_PERF_BUCKETS - 1;
+	histogram->buckets[bucket]++;
+}
+
+void move_perf_event(enum move_perf_event event)
+{
+	move_perf_counters_local()->events[event]++;
+}
+
+static void move_perf_sum(struct move_perf_counters *total)
+{
+	memset(total, 0, sizeof(struct move_perf_counters));
+	pthread_mutex_lock(&move_perf_threads_mutex);
+	for (struct move_perf_thread *thread = move_perf_threads; thread; thread = thread->next) {
+		for (size_t i = 0; i < MOVE_PERF_TIMER_COUNT; i++) {
+			const struct move_perf_histogram *src = &thread->counters.timers[i];
+			struct move_perf_histogram *dst = &total->timers[i];
+			dst->count += src->count;
+			dst->total_ns += src->total_ns;
+			if (src->max_ns > dst->max_ns)
+				dst->max_ns = src->max_ns;
+			for (size_t b = 0; b < MOVE_PERF_BUCKETS; b++)
+				dst->buckets[b] += src->buckets[b];
+		}
+		for (size_t i = 0; i < MOVE_PERF_EVENT_COUNT; i++)
+			total->events[i] += thread->counters.events[i];
+	}
+	pthread_mutex_unlock(&move_perf_threads_mutex);
+}
+
+// max stays the all time max, everything else becomes the difference to base
+static void move_perf_delta(struct move_perf_counters *total, const struct move_perf_counters *base)
+{
+	for (size_t i = 0; i < MOVE_PERF_TIMER_COUNT; i++) {
+		total->timers[i].count -= base->timers[i].count;
+		total->timers[i].total_ns -= base->timers[i].total_ns;
+		for (size_t b = 0; b < MOVE_PERF_BUCKETS; b++)
+			total->timers[i].buckets[b] -= base->timers[i].buckets[b];
+	}
+	for (size_t i = 0; i < MOVE_PERF_EVENT_COUNT; i++)
+		total->events[i] -= base->events[i];
+}
+
+static uint64_t move_perf_percentile(const struct move_perf_histogram *histogram, double percentile)
+{
+	const uint64_t target = (uint64_t)((double)histogram->count * percentile);
+	uint64_t seen = 0;
+	for (size_t b = 0; b < MOVE_PERF_BUCKETS; b++) {
+		seen += histogram->buckets[b];
+		if (seen > target)
+			return 2ULL << b;
+	}
+	return histogram->max_ns;
+}
+
+void move_perf_get(obs_data_t *data, bool reset)
+{
+	struct move_perf_counters total;
+	move_perf_sum(&total);
+	pthread_mutex_lock(&move_perf_base_mutex);
+	struct move_perf_counters current = total;
+	move_perf_delta(&total, &move_perf_reset_base);
+	if (reset)
+		move_perf_reset_base = current;
+	pthread_mutex_unlock(&move_perf_base_mutex);
+
+	for (size_t i = 0; i < MOVE_PERF_TIMER_COUNT; i++) {
+		const struct move_perf_histogram *histogram = &total.timers[i];
+		obs_data_t *timer = obs_data_create();
+		obs_data_set_int(timer, "count", (long long)histogram->count);
+		obs_data_set_int(timer, "avg_ns", histogram->count ? (long long)(histogram->total_ns / histogram->count) : 0);
+		obs_data_set_int(timer, "p50_ns", (long long)move_perf_percentile(histogram, 0.5));
+		obs_data_set_int(timer, "p99_ns", (long long)move_perf_percentile(histogram, 0.99));
+		obs_data_set_int(timer, "max_ns", (long long)histogram->max_ns);
+		obs_data_set_obj(data, move_perf_timer_names[i], timer);
+		obs_data_release(timer);
+	}
+	for (size_t i = 0; i < MOVE_PERF_EVENT_COUNT; i++)
+		obs_data_set_int(data, move_perf_event_names[i], (long long)total.events[i]);
+}
+
+static void move_perf_tick(void *param, float seconds)
+{
+	UNUSED_PARAMETER(param);
+	move_perf_log_elapsed += seconds;
+	if (move_perf_log_elapsed < MOVE_PERF_LOG_INTERVAL)
+		return;
+	move_perf_log_elapsed = 0.0f;
+
+	struct move_perf_counters total;
+	move_perf_sum(&total);
+	pthread_mutex_lock(&move_perf_base_mutex);
+	struct move_perf_counters current = total;
+	move_perf_delta(&total, &move_perf_log_base);
+	move_perf_log_base = current;
+	pthread_mutex_unlock(&move_perf_base_mutex);
+
+	for (size_t i = 0; i < MOVE_PERF_TIMER_COUNT; i++) {
+		const struct move_perf_histogram *histogram = &total.timers[i];
+		if (!histogram->count)
+			continue;
+		blog(LOG_INFO, "[Move Transition] perf %s: %llu calls, avg %.3f ms, p99 < %.3f ms", move_perf_timer_names[i],
+		     (unsigned long long)histogram->count, (double)histogram->total_ns / (double)histogram->count / 1000000.0,
+		     (double)move_perf_percentile(histogram, 0.99) / 1000000.0);
+	}
+	if (total.events[MOVE_PERF_OFFSCREEN_PASS] || total.events[MOVE_PERF_POOL_HIT] || total.events[MOVE_PERF_POOL_MISS])
+		blog(LOG_INFO, "[Move Transition] perf offscreen passes: %llu, transition pool hits: %llu, misses: %llu",
+		     (unsigned long long)total.events[MOVE_PERF_OFFSCREEN_PASS],
+		     (unsigned long long)total.events[MOVE_PERF_POOL_HIT], (unsigned long long)total.events[MOVE_PERF_POOL_MISS]);
+}
+
+void move_perf_load(void)
+{
+	pthread_mutex_init(&move_perf_threads_mutex, NULL);
+	pthread_mutex_init(&move_perf_base_mutex, NULL);
+	obs_add_tick_callback(move_perf_tick, NULL);
+}
+
+void move_perf_unload(void)
+{
+	obs_remove_tick_callback(move_perf_tick, NULL);
+	struct move_perf_thread *thread = move_perf_threads;
+	while (thread) {
+		struct move_perf_thread *next = thread->next;
+		bfree(thread);
+		thread = next;
+	}
+	move_perf_threads = NULL;
+	pthread_mutex_destroy(&move_perf_base_mutex);
+	pthread_mutex_destroy(&move_perf_threads_mutex);
+}
+
+#endif
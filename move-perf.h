@@ -0,0 +1,44 @@
+#pragma once
+
+#include <obs-module.h>
+
+#ifdef MOVE_PERF
+
+#include <util/platform.h>
+
+enum move_perf_timer {
+	MOVE_PERF_MATCH,
+	MOVE_PERF_RENDER,
+	MOVE_PERF_SOURCE_TICK,
+	MOVE_PERF_VALUE_TICK,
+	MOVE_PERF_SWAP_TICK,
+	MOVE_PERF_ACTION_TICK,
+	MOVE_PERF_AUDIO_TICK,
+	MOVE_PERF_UDP_TRIGGER,
+	MOVE_PERF_TIMER_COUNT,
+};
+
+enum move_perf_event {
+	MOVE_PERF_OFFSCREEN_PASS,
+	MOVE_PERF_POOL_HIT,
+	MOVE_PERF_POOL_MISS,
+	MOVE_PERF_EVENT_COUNT,
+};
+
+void move_perf_record(enum move_perf_timer timer, uint64_t ns);
+void move_perf_event(enum move_perf_event event);
+void move_perf_get(obs_data_t *data, bool reset);
+void move_perf_load(void);
+void move_perf_unload(void);
+
+#define MOVE_PERF_BEGIN(start) const uint64_t start = os_gettime_ns()
+#define MOVE_PERF_END(timer, start) move_perf_record(timer, os_gettime_ns() - (start))
+#define MOVE_PERF_EVENT(event) move_perf_event(event)
+
+#else
+
+#define MOVE_PERF_BEGIN(start)
+#define MOVE_PERF_END(timer, start) ((void)0)
+#define MOVE_PERF_EVENT(event) ((void)0)
+
+#endif
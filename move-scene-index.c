@@ -0,0 +1,196 @@
+#include "move-transition.h"
+#include <util/threading.h>
+#include <util/uthash.h>
+
+struct move_scene_index_item {
+	char *name;
+	obs_sceneitem_t *item;
+	UT_hash_handle hh;
+};
+
+struct move_scene_index {
+	obs_scene_t *scene;
+	signal_handler_t *signal_handler;
+	struct move_scene_index_item *items;
+	uint64_t generation;
+	bool dirty;
+	UT_hash_handle hh;
+};
+
+static struct move_scene_index *move_scene_indexes = NULL;
+static pthread_mutex_t move_scene_indexes_mutex;
+
+static void move_scene_index_items_free(struct move_scene_index_item **items)
+{
+	struct move_scene_index_item *item, *tmp;
+	HASH_ITER (hh, *items, item, tmp) {
+		HASH_DEL(*items, item);
+		bfree(item->name);
+		bfree(item);
+	}
+}
+
+static void move_scene_index_items_add(struct move_scene_index_item **items, obs_sceneitem_t *scene_item)
+{
+	const char *name = obs_source_get_name(obs_sceneitem_get_source(scene_item));
+	if (!name)
+		return;
+	struct move_scene_index_item *item;
+	HASH_FIND_STR(*items, name, item);
+	if (item)
+		return;
+	item = bzalloc(sizeof(struct move_scene_index_item));
+	item->name = bstrdup(name);
+	item->item = scene_item;
+	HASH_ADD_KEYPTR(hh, *items, item->name, strlen(item->name), item);
+}
+
+static bool move_scene_index_enum(obs_scene_t *scene, obs_sceneitem_t *scene_item, void *data)
+{
+	UNUSED_PARAMETER(scene);
+	move_scene_index_items_add(data, scene_item);
+	return true;
+}
+
+static void move_scene_index_invalidate(void *data, calldata_t *call_data)
+{
+	UNUSED_PARAMETER(call_data);
+	struct move_scene_index *index = data;
+	pthread_mutex_lock(&move_scene_indexes_mutex);
+	index->generation++;
+	index->dirty = true;
+	pthread_mutex_unlock(&move_scene_indexes_mutex);
+}
+
+static void move_scene_index_item_add(void *data, calldata_t *call_data)
+{
+	struct move_scene_index *index = data;
+	obs_sceneitem_t *item = calldata_ptr(call_data, "item");
+	pthread_mutex_lock(&move_scene_indexes_mutex);
+	index->generation++;
+	if (item && !index->dirty)
+		move_scene_index_items_add(&index->items, item);
+	pthread_mutex_unlock(&move_scene_indexes_mutex);
+}
+
+static void move_scene_index_item_remove(void *data, calldata_t *call_data)
+{
+	struct move_scene_index *index = data;
+	obs_sceneitem_t *item = calldata_ptr(call_data, "item");
+	pthread_mutex_lock(&move_scene_indexes_mutex);
+	index->generation++;
+	struct move_scene_index_item *i, *tmp;
+	HASH_ITER (hh, index->items, i, tmp) {
+		if (i->item == item) {
+			// another item of the same source could be next in line
+			index->dirty = true;
+			break;
+		}
+	}
+	pthread_mutex_unlock(&move_scene_indexes_mutex);
+}
+
+static void move_scene_index_disconnect(struct move_scene_index *index);
+
+static void move_scene_index_destroy(void *data, calldata_t *call_data)
+{
+	UNUSED_PARAMETER(call_data);
+	struct move_scene_index *index = data;
+	move_scene_index_disconnect(index);
+	pthread_mutex_lock(&move_scene_indexes_mutex);
+	HASH_DEL(move_scene_indexes, index);
+	pthread_mutex_unlock(&move_scene_indexes_mutex);
+	move_scene_index_items_free(&index->items);
+	bfree(index);
+}
+
+static void move_scene_index_disconnect(struct move_scene_index *index)
+{
+	signal_handler_disconnect(index->signal_handler, "item_add", move_scene_index_item_add, index);
+	signal_handler_disconnect(index->signal_handler, "item_remove", move_scene_index_item_remove, index);
+	signal_handler_disconnect(index->signal_handler, "reorder", move_scene_index_invalidate, index);
+	signal_handler_disconnect(index->signal_handler, "destroy", move_scene_index_destroy, index);
+}
+
+static void move_scene_index_source_rename(void *data, calldata_t *call_data)
+{
+	UNUSED_PARAMETER(data);
+	UNUSED_PARAMETER(call_data);
+	pthread_mutex_lock(&move_scene_indexes_mutex);
+	struct move_scene_index *index, *tmp;
+	HASH_ITER (hh, move_scene_indexes, index, tmp) {
+		index->generation++;
+		index->dirty = true;
+	}
+	pthread_mutex_unlock(&move_scene_indexes_mutex);
+}
+
+obs_sceneitem_t *move_scene_find_item(obs_scene_t *scene, const char *name)
+{
+	if (!scene || !name || !*name)
+		return NULL;
+	obs_sceneitem_t *result = NULL;
+	struct move_scene_index_item *item;
+	pthread_mutex_lock(&move_scene_indexes_mutex);
+	struct move_scene_index *index;
+	HASH_FIND_PTR(move_scene_indexes, &scene, index);
+	if (!index) {
+		obs_source_t *scene_source = obs_scene_get_source(scene);
+		index = bzalloc(sizeof(struct move_scene_index));
+		index->scene = scene;
+		index->signal_handler = obs_source_get_signal_handler(scene_source);
+		index->dirty = true;
+		HASH_ADD_PTR(move_scene_indexes, scene, index);
+		signal_handler_connect(index->signal_handler, "item_add", move_scene_index_item_add, index);
+		signal_handler_connect(index->signal_handler, "item_remove", move_scene_index_item_remove, index);
+		signal_handler_connect(index->signal_handler, "reorder", move_scene_index_invalidate, index);
+		signal_handler_connect(index->signal_handler, "destroy", move_scene_index_destroy, index);
+	}
+	if (!index->dirty) {
+		HASH_FIND_STR(index->items, name, item);
+		if (item)
+			result = item->item;
+		pthread_mutex_unlock(&move_scene_indexes_mutex);
+		return result;
+	}
+	const uint64_t generation = index->generation;
+	pthread_mutex_unlock(&move_scene_indexes_mutex);
+
+	// scene signals are emitted with the scene locked, so enumerate without holding the index lock
+	struct move_scene_index_item *items = NULL;
+	obs_scene_enum_items(scene, move_scene_index_enum, &items);
+	HASH_FIND_STR(items, name, item);
+	if (item)
+		result = item->item;
+
+	pthread_mutex_lock(&move_scene_indexes_mutex);
+	HASH_FIND_PTR(move_scene_indexes, &scene, index);
+	if (index && index->dirty) {
+		move_scene_index_items_free(&index->items);
+		index->items = items;
+		items = NULL;
+		index->dirty = index->generation != generation;
+	}
+	pthread_mutex_unlock(&move_scene_indexes_mutex);
+	move_scene_index_items_free(&items);
+	return result;
+}
+
+void move_scene_index_load(void)
+{
+	pthread_mutex_init(&move_scene_indexes_mutex, NULL);
+	signal_handler_connect(obs_get_signal_handler(), "source_rename", move_scene_index_source_rename, NULL);
+}
+
+void move_scene_index_unload(void)
+{
+	signal_handler_disconnect(obs_get_signal_handler(), "source_rename", move_scene_index_source_rename, NULL);
+	struct move_scene_index *index, *tmp;
+	HASH_ITER (hh, move_scene_indexes, index, tmp) {
+		move_scene_index_disconnect(index);
+		HASH_DEL(move_scene_indexes, index);
+		move_scene_index_items_free(&index->items);
+		bfree(index);
+	}
+	pthread_mutex_destroy(&move_scene_indexes_mutex);
+}
@@ -3,6 +3,7 @@
 #include <obs-module.h>
 #include <stdio.h>
 #include <util/dstr.h>
+#include <util/threading.h>
 
 struct move_source_info {
 	struct move_filter move_filter;
@@ -23,6 +24,7 @@ struct move_source_info {
 	struct vec2 bounds_to;
 	struct obs_sceneitem_crop crop_from;
 	struct obs_sceneitem_crop crop_to;
+	struct move_source_relative relative;
 	uint32_t canvas_width;
 	uint32_t canvas_height;
 
@@ -44,6 +46,17 @@ struct move_source_info {
 	bool midpoint;
 };
 
+struct move_source_commit {
+	obs_sceneitem_t *item;
+	struct obs_transform_info info;
+	struct obs_sceneitem_crop crop;
+};
+
+static DARRAY(struct move_source_info *) move_sources;
+static pthread_mutex_t move_sources_mutex;
+static DARRAY(struct move_source_info *) move_sources_ticking;
+static DARRAY(struct move_source_commit) move_source_commits;
+
 void move_source_scene_remove(void *data, calldata_t *call_data);
 
 void move_source_item_remove(void *data, calldata_t *call_data)
@@ -86,17 +99,14 @@ void move_source_scene_remove(void *data, calldata_t *call_data)
 	signal_handler_disconnect(sh, "destroy", move_source_scene_remove, move_source);
 }
 
-bool find_sceneitem(obs_scene_t *scene, obs_sceneitem_t *scene_item, void *data)
+static void move_source_find_sceneitem(struct move_source_info *move_source, obs_scene_t *scene)
 {
-	UNUSED_PARAMETER(scene);
-	struct move_source_info *move_source = data;
-	const char *name = obs_source_get_name(obs_sceneitem_get_source(scene_item));
-	if (!name || strcmp(name, move_source->source_name) != 0)
-		return true;
-	move_source->scene_item = scene_item;
+	move_source->scene_item = move_scene_find_item(scene, move_source->source_name);
+	if (!move_source->scene_item)
+		return;
 	obs_source_t *parent = obs_scene_get_source(scene);
 	if (!parent)
-		return false;
+		return;
 
 	signal_handler_t *sh = obs_source_get_signal_handler(parent);
 	if (sh) {
@@ -104,8 +114,6 @@ bool find_sceneitem(obs_scene_t *scene, obs_sceneitem_t *scene_item, void *data)
 		signal_handler_connect(sh, "remove", move_source_scene_remove, move_source);
 		signal_handler_connect(sh, "destroy", move_source_scene_remove, move_source);
 	}
-
-	return false;
 }
 
 char obs_data_get_char(obs_data_t *data, const char *name)
@@ -137,49 +145,104 @@ float calc_sign(char sign, float from, float to)
 	}
 }
 
-void calc_relative_to(struct move_source_info *move_source)
-{
+struct move_source_component_info {
+	const char *setting_name;
+	const char *obj;
+	const char *key;
+	const char *sign;
+	bool integer;
+};
 
-	obs_data_t *settings = obs_source_get_settings(move_source->move_filter.source);
+static const struct move_source_component_info move_source_components[MOVE_SOURCE_COMPONENT_COUNT] = {
+	[MOVE_SOURCE_POS_X] = {"pos.x", S_POS, "x", "x_sign", false},
+	[MOVE_SOURCE_POS_Y] = {"pos.y", S_POS, "y", "y_sign", false},
+	[MOVE_SOURCE_ROT] = {"rot", NULL, S_ROT, "rot_sign", false},
+	[MOVE_SOURCE_SCALE_X] = {"scale.x", S_SCALE, "x", "x_sign", false},
+	[MOVE_SOURCE_SCALE_Y] = {"scale.y", S_SCALE, "y", "y_sign", false},
+	[MOVE_SOURCE_BOUNDS_X] = {"bounds.x", S_BOUNDS, "x", "x_sign", false},
+	[MOVE_SOURCE_BOUNDS_Y] = {"bounds.y", S_BOUNDS, "y", "y_sign", false},
+	[MOVE_SOURCE_CROP_LEFT] = {"crop.left", S_CROP, "left", "left_sign", true},
+	[MOVE_SOURCE_CROP_TOP] = {"crop.top", S_CROP, "top", "top_sign", true},
+	[MOVE_SOURCE_CROP_RIGHT] = {"crop.right", S_CROP, "right", "right_sign", true},
+	[MOVE_SOURCE_CROP_BOTTOM] = {"crop.bottom", S_CROP, "bottom", "bottom_sign", true},
+};
+
+int move_source_component_find(const char *setting_name)
+{
+	if (!setting_name)
+		return -1;
+	for (int i = 0; i < MOVE_SOURCE_COMPONENT_COUNT; i++) {
+		if (strcmp(move_source_components[i].setting_name, setting_name) == 0)
+			return i;
+	}
+	return -1;
+}
 
-	move_source->rot_to = calc_sign(obs_data_get_char(settings, "rot_sign"), move_source->rot_from,
-					(float)obs_data_get_double(settings, S_ROT));
+bool move_source_component_get(obs_data_t *settings, int component, double *value)
+{
+	const struct move_source_component_info *info = &move_source_components[component];
+	obs_data_t *obj = info->obj ? obs_data_get_obj(settings, info->obj) : settings;
+	if (!obj)
+		return false;
+	*value = info->integer ? (double)obs_data_get_int(obj, info->key) : obs_data_get_double(obj, info->key);
+	if (info->obj)
+		obs_data_release(obj);
+	return true;
+}
 
-	obs_data_t *pos = obs_data_get_obj(settings, S_POS);
-	move_source->pos_to.x =
-		calc_sign(obs_data_get_char(pos, "x_sign"), move_source->pos_from.x, (float)obs_data_get_double(pos, "x"));
+void move_source_component_set(obs_data_t *settings, int component, double value)
+{
+	const struct move_source_component_info *info = &move_source_components[component];
+	obs_data_t *obj = info->obj ? obs_data_get_obj(settings, info->obj) : settings;
+	if (info->integer)
+		obs_data_set_int(obj, info->key, (long long)value);
+	else
+		obs_data_set_double(obj, info->key, value);
+	if (info->obj)
+		obs_data_release(obj);
+}
 
-	move_source->pos_to.y =
-		calc_sign(obs_data_get_char(pos, "y_sign"), move_source->pos_from.y, (float)obs_data_get_double(pos, "y"));
-	obs_data_release(pos);
+void move_source_relative_load(struct move_source_relative *relative, obs_data_t *settings)
+{
+	obs_data_t *obj = NULL;
+	const char *obj_name = NULL;
+	for (int i = 0; i < MOVE_SOURCE_COMPONENT_COUNT; i++) {
+		const struct move_source_component_info *info = &move_source_components[i];
+		if (info->obj != obj_name) {
+			obs_data_release(obj);
+			obj = info->obj ? obs_data_get_obj(settings, info->obj) : NULL;
+			obj_name = info->obj;
+		}
+		obs_data_t *data = info->obj ? obj : settings;
+		relative->sign[i] = obs_data_get_char(data, info->sign);
+		relative->value[i] = info->integer ? (float)obs_data_get_int(data, info->key)
+						   : (float)obs_data_get_double(data, info->key);
+	}
+	obs_data_release(obj);
+}
 
-	obs_data_t *scale = obs_data_get_obj(settings, S_SCALE);
+void calc_relative_to(struct move_source_info *move_source)
+{
+	const struct move_source_relative *r = &move_source->relative;
+	move_source->pos_to.x = calc_sign(r->sign[MOVE_SOURCE_POS_X], move_source->pos_from.x, r->value[MOVE_SOURCE_POS_X]);
+	move_source->pos_to.y = calc_sign(r->sign[MOVE_SOURCE_POS_Y], move_source->pos_from.y, r->value[MOVE_SOURCE_POS_Y]);
+	move_source->rot_to = calc_sign(r->sign[MOVE_SOURCE_ROT], move_source->rot_from, r->value[MOVE_SOURCE_ROT]);
 	move_source->scale_to.x =
-		calc_sign(obs_data_get_char(scale, "x_sign"), move_source->scale_from.x, (float)obs_data_get_double(scale, "x"));
-
+		calc_sign(r->sign[MOVE_SOURCE_SCALE_X], move_source->scale_from.x, r->value[MOVE_SOURCE_SCALE_X]);
 	move_source->scale_to.y =
-		calc_sign(obs_data_get_char(scale, "y_sign"), move_source->scale_from.y, (float)obs_data_get_double(scale, "y"));
-	obs_data_release(scale);
-
-	obs_data_t *bounds = obs_data_get_obj(settings, S_BOUNDS);
+		calc_sign(r->sign[MOVE_SOURCE_SCALE_Y], move_source->scale_from.y, r->value[MOVE_SOURCE_SCALE_Y]);
 	move_source->bounds_to.x =
-		calc_sign(obs_data_get_char(bounds, "x_sign"), move_source->bounds_from.x, (float)obs_data_get_double(bounds, "x"));
-
+		calc_sign(r->sign[MOVE_SOURCE_BOUNDS_X], move_source->bounds_from.x, r->value[MOVE_SOURCE_BOUNDS_X]);
 	move_source->bounds_to.y =
-		calc_sign(obs_data_get_char(bounds, "y_sign"), move_source->bounds_from.y, (float)obs_data_get_double(bounds, "y"));
-	obs_data_release(bounds);
-
-	obs_data_t *crop = obs_data_get_obj(settings, S_CROP);
-	move_source->crop_to.left = (int)calc_sign(obs_data_get_char(crop, "left_sign"), (float)move_source->crop_from.left,
-						   (float)obs_data_get_int(crop, "left"));
-	move_source->crop_to.top = (int)calc_sign(obs_data_get_char(crop, "top_sign"), (float)move_source->crop_from.top,
-						  (float)obs_data_get_int(crop, "top"));
-	move_source->crop_to.right = (int)calc_sign(obs_data_get_char(crop, "right_sign"), (float)move_source->crop_from.right,
-						    (float)obs_data_get_int(crop, "right"));
-	move_source->crop_to.bottom = (int)calc_sign(obs_data_get_char(crop, "bottom_sign"), (float)move_source->crop_from.bottom,
-						     (float)obs_data_get_int(crop, "bottom"));
-	obs_data_release(crop);
-	obs_data_release(settings);
+		calc_sign(r->sign[MOVE_SOURCE_BOUNDS_Y], move_source->bounds_from.y, r->value[MOVE_SOURCE_BOUNDS_Y]);
+	move_source->crop_to.left = (int)calc_sign(r->sign[MOVE_SOURCE_CROP_LEFT], (float)move_source->crop_from.left,
+						   r->value[MOVE_SOURCE_CROP_LEFT]);
+	move_source->crop_to.top = (int)calc_sign(r->sign[MOVE_SOURCE_CROP_TOP], (float)move_source->crop_from.top,
+						  r->value[MOVE_SOURCE_CROP_TOP]);
+	move_source->crop_to.right = (int)calc_sign(r->sign[MOVE_SOURCE_CROP_RIGHT], (float)move_source->crop_from.right,
+						    r->value[MOVE_SOURCE_CROP_RIGHT]);
+	move_source->crop_to.bottom = (int)calc_sign(r->sign[MOVE_SOURCE_CROP_BOTTOM], (float)move_source->crop_from.bottom,
+						     r->value[MOVE_SOURCE_CROP_BOTTOM]);
 }
 
 void move_source_media_action(struct move_source_info *move_source, long long media_action, int64_t media_time)
@@ -245,7 +308,7 @@ void move_source_start(struct move_source_info *move_source)
 			if (!scene)
 				scene = obs_group_from_source(parent);
 			if (scene)
-				obs_scene_enum_items(scene, find_sceneitem, move_source);
+				move_source_find_sceneitem(move_source, scene);
 		}
 	}
 	if (!move_source->scene_item)
@@ -456,7 +519,7 @@ void move_source_source_changed(struct move_source_info *move_source, const char
 	if (!scene)
 		scene = obs_group_from_source(parent);
 	if (move_source->source_name && scene)
-		obs_scene_enum_items(scene, find_sceneitem, move_source);
+		move_source_find_sceneitem(move_source, scene);
 }
 
 static void obs_data_set_sign(obs_data_t *settings, const char *name, const char *val)
@@ -517,6 +580,7 @@ void move_source_update(void *data, obs_data_t *settings)
 		}
 		obs_data_unset_user_value(settings, S_TRANSFORM_RELATIVE);
 	}
+	move_source_relative_load(&move_source->relative, settings);
 	calc_relative_to(move_source);
 
 	move_source->change_order = obs_data_get_int(settings, S_CHANGE_ORDER);
@@ -630,6 +694,10 @@ static void *move_source_create(obs_data_t *settings, obs_source_t *source)
 	obs_source_update(source, settings);
 	signal_handler_connect(obs_get_signal_handler(), "source_rename", move_source_source_rename, move_source);
 
+	pthread_mutex_lock(&move_sources_mutex);
+	da_push_back(move_sources, &move_source);
+	pthread_mutex_unlock(&move_sources_mutex);
+
 	return move_source;
 }
 
@@ -638,6 +706,10 @@ extern bool move_exit;
 static void move_source_destroy(void *data)
 {
 	struct move_source_info *move_source = data;
+	pthread_mutex_lock(&move_sources_mutex);
+	da_erase_item(move_sources, &move_source);
+	pthread_mutex_unlock(&move_sources_mutex);
+
 	signal_handler_disconnect(obs_get_signal_handler(), "source_rename", move_source_source_rename, move_source);
 
 	obs_source_t *parent = obs_filter_get_parent(move_source->move_filter.source);
@@ -714,7 +786,7 @@ bool move_source_get_transform(obs_properties_t *props, obs_property_t *property
 			if (!scene)
 				scene = obs_group_from_source(parent);
 			if (scene)
-				obs_scene_enum_items(scene, find_sceneitem, data);
+				move_source_find_sceneitem(move_source, scene);
 		}
 	}
 	if (!move_source->scene_item)
@@ -920,7 +992,7 @@ static obs_properties_t *move_source_properties(void *data)
 		return ppts;
 	}
 	if (!move_source->scene_item && move_source->source_name && strlen(move_source->source_name)) {
-		obs_scene_enum_items(scene, find_sceneitem, move_source);
+		move_source_find_sceneitem(move_source, scene);
 	}
 	obs_properties_t *group = obs_properties_create();
 	obs_property_t *p =
@@ -1110,6 +1182,8 @@ static obs_properties_t *move_source_properties(void *data)
 	obs_property_list_add_int(p, obs_module_text("NextMoveOn.End"), NEXT_MOVE_ON_END);
 	obs_property_list_add_int(p, obs_module_text("NextMoveOn.Hotkey"), NEXT_MOVE_ON_HOTKEY);
 
+	move_filter_loop_properties(group);
+
 	obs_properties_add_button(group, "move_source_start", obs_module_text("Start"), move_source_start_button);
 
 	p = obs_properties_add_group(ppts, S_ACTIONS, obs_module_text("Actions"), OBS_GROUP_NORMAL, group);
@@ -1182,16 +1256,15 @@ void move_source_ended(struct move_source_info *move_source)
 	}
 }
 
-void move_source_tick(void *data, float seconds)
+static bool move_source_tick(struct move_source_info *move_source, float seconds)
 {
-	struct move_source_info *move_source = data;
 	float t;
 	if (!move_filter_tick(&move_source->move_filter, seconds, &t))
-		return;
+		return false;
 
 	if (!move_source->scene_item) {
 		move_source->move_filter.moving = false;
-		return;
+		return false;
 	}
 
 	if (!move_source->midpoint && t >= 0.5) {
@@ -1260,31 +1333,110 @@ void move_source_tick(void *data, float seconds)
 			vec2_set(&pos, (1.0f - t) * move_source->pos_from.x + t * move_source->pos_to.x,
 				 (1.0f - t) * move_source->pos_from.y + t * move_source->pos_to.y);
 		}
-		obs_sceneitem_defer_update_begin(move_source->scene_item);
-		obs_sceneitem_set_pos(move_source->scene_item, &pos);
 		const float rot = (1.0f - t) * move_source->rot_from + t * move_source->rot_to;
-		obs_sceneitem_set_rot(move_source->scene_item, rot);
 		struct vec2 scale;
 		vec2_set(&scale, (1.0f - t) * move_source->scale_from.x + t * move_source->scale_to.x,
 			 (1.0f - t) * move_source->scale_from.y + t * move_source->scale_to.y);
-		obs_sceneitem_set_scale(move_source->scene_item, &scale);
 		struct vec2 bounds;
 		vec2_set(&bounds, (1.0f - t) * move_source->bounds_from.x + t * move_source->bounds_to.x,
 			 (1.0f - t) * move_source->bounds_from.y + t * move_source->bounds_to.y);
-		obs_sceneitem_set_bounds(move_source->scene_item, &bounds);
-		struct obs_sceneitem_crop crop;
-		crop.left = (int)((float)(1.0f - ot) * (float)move_source->crop_from.left + ot * (float)move_source->crop_to.left);
-		crop.top = (int)((float)(1.0f - ot) * (float)move_source->crop_from.top + ot * (float)move_source->crop_to.top);
-		crop.right =
+		struct move_source_commit *commit = da_push_back_new(move_source_commits);
+		obs_sceneitem_addref(move_source->scene_item);
+		commit->item = move_source->scene_item;
+		obs_sceneitem_get_info2(commit->item, &commit->info);
+		vec2_copy(&commit->info.pos, &pos);
+		commit->info.rot = rot;
+		vec2_copy(&commit->info.scale, &scale);
+		vec2_copy(&commit->info.bounds, &bounds);
+		commit->crop.left =
+			(int)((float)(1.0f - ot) * (float)move_source->crop_from.left + ot * (float)move_source->crop_to.left);
+		commit->crop.top =
+			(int)((float)(1.0f - ot) * (float)move_source->crop_from.top + ot * (float)move_source->crop_to.top);
+		commit->crop.right =
 			(int)((float)(1.0f - ot) * (float)move_source->crop_from.right + ot * (float)move_source->crop_to.right);
-		crop.bottom =
+		commit->crop.bottom =
 			(int)((float)(1.0f - ot) * (float)move_source->crop_from.bottom + ot * (float)move_source->crop_to.bottom);
-		obs_sceneitem_set_crop(move_source->scene_item, &crop);
-		obs_sceneitem_defer_update_end(move_source->scene_item);
 	}
-	if (!move_source->move_filter.moving) {
-		move_source_ended(move_source);
+	return !move_source->move_filter.moving;
+}
+
+static void move_source_commit_scene(void *data, obs_scene_t *scene)
+{
+	UNUSED_PARAMETER(data);
+	for (size_t i = 0; i < move_source_commits.num; i++) {
+		struct move_source_commit *commit = &move_source_commits.array[i];
+		if (!commit->item || obs_sceneitem_get_scene(commit->item) != scene)
+			continue;
+		obs_sceneitem_defer_update_begin(commit->item);
+		obs_sceneitem_set_info2(commit->item, &commit->info);
+		obs_sceneitem_set_crop(commit->item, &commit->crop);
+		obs_sceneitem_defer_update_end(commit->item);
+		obs_sceneitem_release(commit->item);
+		commit->item = NULL;
+	}
+}
+
+static void move_sources_tick(void *param, float seconds)
+{
+	UNUSED_PARAMETER(param);
+	move_sources_ticking.num = 0;
+	pthread_mutex_lock(&move_sources_mutex);
+	for (size_t i = 0; i < move_sources.num; i++) {
+		if (obs_source_get_ref(move_sources.array[i]->move_filter.source))
+			da_push_back(move_sources_ticking, &move_sources.array[i]);
+	}
+	pthread_mutex_unlock(&move_sources_mutex);
+
+	// stage the transforms of all moving filters, ended moves are gathered at the front
+	move_source_commits.num = 0;
+	size_t ended = 0;
+	for (size_t i = 0; i < move_sources_ticking.num; i++) {
+		struct move_source_info *move_source = move_sources_ticking.array[i];
+		MOVE_PERF_BEGIN(tick_start);
+		const bool move_ended = move_source_tick(move_source, seconds);
+		MOVE_PERF_END(MOVE_PERF_SOURCE_TICK, tick_start);
+		if (move_ended) {
+			move_sources_ticking.array[i] = move_sources_ticking.array[ended];
+			move_sources_ticking.array[ended++] = move_source;
+		}
 	}
+
+	// one commit per scene, before ended moves can start the next move from the new transform
+	for (size_t i = 0; i < move_source_commits.num; i++) {
+		obs_sceneitem_t *item = move_source_commits.array[i].item;
+		if (item)
+			obs_scene_atomic_update(obs_sceneitem_get_scene(item), move_source_commit_scene, NULL);
+	}
+	// items that lost their scene were never committed, drop the reference staging took
+	for (size_t i = 0; i < move_source_commits.num; i++) {
+		struct move_source_commit *commit = &move_source_commits.array[i];
+		if (commit->item) {
+			obs_sceneitem_release(commit->item);
+			commit->item = NULL;
+		}
+	}
+
+	for (size_t i = 0; i < ended; i++)
+		move_source_ended(move_sources_ticking.array[i]);
+
+	for (size_t i = 0; i < move_sources_ticking.num; i++)
+		obs_source_release(move_sources_ticking.array[i]->move_filter.source);
+}
+
+void move_sources_load(void)
+{
+	da_init(move_sources);
+	pthread_mutex_init(&move_sources_mutex, NULL);
+	obs_add_tick_callback(move_sources_tick, NULL);
+}
+
+void move_sources_unload(void)
+{
+	obs_remove_tick_callback(move_sources_tick, NULL);
+	da_free(move_sources);
+	da_free(move_sources_ticking);
+	da_free(move_source_commits);
+	pthread_mutex_destroy(&move_sources_mutex);
 }
 
 struct obs_source_info move_source_filter = {
@@ -1297,9 +1449,10 @@ struct obs_source_info move_source_filter = {
 	.get_properties = move_source_properties,
 	.get_defaults = move_source_defaults,
 	.video_render = move_source_video_render,
-	.video_tick = move_source_tick,
 	.update = move_source_update,
 	.load = move_source_load,
+	.filter_add = move_filter_add,
+	.filter_remove = move_filter_remove,
 	.activate = move_filter_activate,
 	.deactivate = move_filter_deactivate,
 	.show = move_filter_show,
@@ -1,4 +1,35 @@
 #include "move-transition.h"
+#include <util/threading.h>
+
+#define S_ROTATE_SOURCES "rotate_sources"
+
+struct move_source_swap_state {
+	struct vec2 pos;
+	float rot;
+	struct vec2 scale;
+	struct vec2 bounds;
+	struct obs_sceneitem_crop crop;
+	float volume;
+	uint32_t width;
+	uint32_t height;
+};
+
+// one item moving to the place of the next one, everything that does not depend on t is set when the move starts
+struct move_source_swap_track {
+	obs_sceneitem_t *item;
+	obs_source_t *source;
+	struct move_source_swap_state from;
+	struct move_source_swap_state to;
+	bool curved;
+	struct vec2 control_pos;
+	// scale that gives this item the size of the next one
+	struct vec2 scale_to;
+	float volume;
+
+	struct obs_transform_info info;
+	struct obs_sceneitem_crop crop;
+	bool commit;
+};
 
 struct move_source_swap_info {
 	struct move_filter move_filter;
@@ -7,6 +38,7 @@ struct move_source_swap_info {
 	obs_sceneitem_t *scene_item1;
 	char *source_name2;
 	obs_sceneitem_t *scene_item2;
+	DARRAY(char *) rotate_source_names;
 
 	uint8_t swap_order;
 	uint8_t swap_visibility;
@@ -15,25 +47,9 @@ struct move_source_swap_info {
 	bool stretch;
 	float curve;
 
-	struct vec2 pos1;
-	struct vec2 pos2;
-	float rot1;
-	float rot2;
-	struct vec2 scale1;
-	struct vec2 scale2;
-	struct vec2 bounds1;
-	struct vec2 bounds2;
-	struct obs_sceneitem_crop crop1;
-	struct obs_sceneitem_crop crop2;
-	float volume1;
-	float volume2;
-	uint32_t width1;
-	uint32_t width2;
-	uint32_t height1;
-	uint32_t height2;
-
-	uint32_t canvas_width;
-	uint32_t canvas_height;
+	// the plan is built wherever a start comes from and swapped in under plan_mutex, which the tick holds while using it
+	pthread_mutex_t plan_mutex;
+	DARRAY(struct move_source_swap_track) plan;
 
 	bool midpoint;
 };
@@ -165,8 +181,130 @@ static bool find_sceneitem(obs_scene_t *scene, obs_sceneitem_t *scene_item, void
 	return !move_source_swap->scene_item1 || !move_source_swap->scene_item2;
 }
 
+static void find_sceneitems(struct move_source_swap_info *move_source_swap, obs_scene_t *scene)
+{
+	if (move_source_swap->source_name1 && move_source_swap->source_name2 &&
+	    strcmp(move_source_swap->source_name1, move_source_swap->source_name2) == 0) {
+		// swapping two items of the same source needs both of them
+		obs_scene_enum_items(scene, find_sceneitem, move_source_swap);
+		return;
+	}
+	if (!move_source_swap->scene_item1 && move_source_swap->source_name1)
+		move_source_swap->scene_item1 = move_scene_find_item(scene, move_source_swap->source_name1);
+	if (!move_source_swap->scene_item2 && move_source_swap->source_name2)
+		move_source_swap->scene_item2 = move_scene_find_item(scene, move_source_swap->source_name2);
+	if (!move_source_swap->scene_item1 && !move_source_swap->scene_item2)
+		return;
+
+	obs_source_t *parent = obs_scene_get_source(scene);
+	if (!parent)
+		return;
+
+	signal_handler_t *sh = obs_source_get_signal_handler(parent);
+	if (sh) {
+		signal_handler_disconnect(sh, "item_remove", move_source_swap_item_remove, move_source_swap);
+		signal_handler_disconnect(sh, "remove", move_source_swap_scene_remove, move_source_swap);
+		signal_handler_disconnect(sh, "destroy", move_source_swap_scene_remove, move_source_swap);
+		signal_handler_connect(sh, "item_remove", move_source_swap_item_remove, move_source_swap);
+		signal_handler_connect(sh, "remove", move_source_swap_scene_remove, move_source_swap);
+		signal_handler_connect(sh, "destroy", move_source_swap_scene_remove, move_source_swap);
+	}
+}
+
+static void move_source_swap_plan_release(struct move_source_swap_info *move_source_swap)
+{
+	for (size_t i = 0; i < move_source_swap->plan.num; i++)
+		obs_sceneitem_release(move_source_swap->plan.array[i].item);
+	move_source_swap->plan.num = 0;
+}
+
+static void move_source_swap_plan_clear(struct move_source_swap_info *move_source_swap)
+{
+	pthread_mutex_lock(&move_source_swap->plan_mutex);
+	move_source_swap_plan_release(move_source_swap);
+	pthread_mutex_unlock(&move_source_swap->plan_mutex);
+}
+
+static void move_source_swap_get_state(obs_sceneitem_t *item, struct move_source_swap_state *state)
+{
+	obs_source_t *source = obs_sceneitem_get_source(item);
+	obs_sceneitem_get_pos(item, &state->pos);
+	state->rot = obs_sceneitem_get_rot(item);
+	obs_sceneitem_get_scale(item, &state->scale);
+	obs_sceneitem_get_bounds(item, &state->bounds);
+	obs_sceneitem_get_crop(item, &state->crop);
+	state->volume = obs_source_get_volume(source);
+	state->width = obs_source_get_width(source);
+	if (!state->width)
+		state->width = 1;
+	state->height = obs_source_get_height(source);
+	if (!state->height)
+		state->height = 1;
+}
+
+// every item takes the place of the next one, with only source 1 and 2 that is a swap
+static void move_source_swap_plan(struct move_source_swap_info *move_source_swap)
+{
+	DARRAY(struct move_source_swap_track) plan;
+	da_init(plan);
+	DARRAY(obs_sceneitem_t *) items;
+	da_init(items);
+	da_push_back(items, &move_source_swap->scene_item1);
+	da_push_back(items, &move_source_swap->scene_item2);
+	obs_scene_t *scene = obs_sceneitem_get_scene(move_source_swap->scene_item1);
+	for (size_t i = 0; i < move_source_swap->rotate_source_names.num; i++) {
+		obs_sceneitem_t *item = move_scene_find_item(scene, move_source_swap->rotate_source_names.array[i]);
+		if (item && da_find(items, &item, 0) == DARRAY_INVALID)
+			da_push_back(items, &item);
+	}
+
+	obs_source_t *scene_source = obs_scene_get_source(scene);
+	const uint32_t canvas_width = obs_source_get_width(scene_source);
+	const uint32_t canvas_height = obs_source_get_height(scene_source);
+
+	da_resize(plan, items.num);
+	for (size_t i = 0; i < items.num; i++)
+		move_source_swap_get_state(items.array[i], &plan.array[i].from);
+	for (size_t i = 0; i < items.num; i++) {
+		struct move_source_swap_track *track = plan.array + i;
+		obs_sceneitem_addref(items.array[i]);
+		track->item = items.array[i];
+		track->source = obs_sceneitem_get_source(track->item);
+		track->to = plan.array[(i + 1) % items.num].from;
+		track->volume = track->from.volume;
+		track->commit = false;
+		vec2_set(&track->scale_to, track->to.scale.x * (float)track->to.width / (float)track->from.width,
+			 track->to.scale.y * (float)track->to.height / (float)track->from.height);
+
+		track->curved = move_source_swap->curve != 0.0f;
+		if (!track->curved)
+			continue;
+		const float diff_x = fabsf(track->from.pos.x - track->to.pos.x);
+		const float diff_y = fabsf(track->from.pos.y - track->to.pos.y);
+		vec2_set(&track->control_pos, 0.5f * track->from.pos.x + 0.5f * track->to.pos.x,
+			 0.5f * track->from.pos.y + 0.5f * track->to.pos.y);
+		if (track->control_pos.x >= (canvas_width >> 1)) {
+			track->control_pos.x += diff_y * move_source_swap->curve;
+		} else {
+			track->control_pos.x -= diff_y * move_source_swap->curve;
+		}
+		if (track->control_pos.y >= (canvas_height >> 1)) {
+			track->control_pos.y += diff_x * move_source_swap->curve;
+		} else {
+			track->control_pos.y -= diff_x * move_source_swap->curve;
+		}
+	}
+	da_free(items);
+
+	pthread_mutex_lock(&move_source_swap->plan_mutex);
+	move_source_swap_plan_release(move_source_swap);
+	da_move(move_source_swap->plan, plan);
+	pthread_mutex_unlock(&move_source_swap->plan_mutex);
+}
+
 static void move_source_swap_ended(struct move_source_swap_info *move_source_swap)
 {
+	move_source_swap_plan_clear(move_source_swap);
 	move_filter_ended(&move_source_swap->move_filter);
 	if (move_source_swap->swap_order == SWAP_END) {
 		int order1 = obs_sceneitem_get_order_position(move_source_swap->scene_item1);
@@ -209,7 +347,7 @@ static void move_source_swap_start(struct move_source_swap_info *move_source_swa
 			if (!scene)
 				scene = obs_group_from_source(parent);
 			if (scene)
-				obs_scene_enum_items(scene, find_sceneitem, move_source_swap);
+				find_sceneitems(move_source_swap, scene);
 		}
 	}
 	if (!move_source_swap->scene_item1 || !move_source_swap->scene_item2) {
@@ -249,36 +387,7 @@ static void move_source_swap_start(struct move_source_swap_info *move_source_swa
 		}
 	}
 
-	obs_source_t *scene_source = obs_scene_get_source(obs_sceneitem_get_scene(move_source_swap->scene_item1));
-	move_source_swap->canvas_width = obs_source_get_width(scene_source);
-	move_source_swap->canvas_height = obs_source_get_height(scene_source);
-
-	move_source_swap->rot1 = obs_sceneitem_get_rot(move_source_swap->scene_item1);
-	move_source_swap->rot2 = obs_sceneitem_get_rot(move_source_swap->scene_item2);
-	obs_sceneitem_get_pos(move_source_swap->scene_item1, &move_source_swap->pos1);
-	obs_sceneitem_get_pos(move_source_swap->scene_item2, &move_source_swap->pos2);
-	obs_sceneitem_get_scale(move_source_swap->scene_item1, &move_source_swap->scale1);
-	obs_sceneitem_get_scale(move_source_swap->scene_item2, &move_source_swap->scale2);
-	obs_sceneitem_get_bounds(move_source_swap->scene_item1, &move_source_swap->bounds1);
-	obs_sceneitem_get_bounds(move_source_swap->scene_item2, &move_source_swap->bounds2);
-	obs_sceneitem_get_crop(move_source_swap->scene_item1, &move_source_swap->crop1);
-	obs_sceneitem_get_crop(move_source_swap->scene_item2, &move_source_swap->crop2);
-	obs_source_t *source1 = obs_sceneitem_get_source(move_source_swap->scene_item1);
-	obs_source_t *source2 = obs_sceneitem_get_source(move_source_swap->scene_item2);
-	move_source_swap->volume1 = obs_source_get_volume(source1);
-	move_source_swap->volume2 = obs_source_get_volume(source2);
-	move_source_swap->width1 = obs_source_get_width(source1);
-	move_source_swap->width2 = obs_source_get_width(source2);
-	if (!move_source_swap->width1)
-		move_source_swap->width1 = 1;
-	if (!move_source_swap->width2)
-		move_source_swap->width2 = 1;
-	move_source_swap->height1 = obs_source_get_height(source1);
-	move_source_swap->height2 = obs_source_get_height(source2);
-	if (!move_source_swap->height1)
-		move_source_swap->height1 = 1;
-	if (!move_source_swap->height2)
-		move_source_swap->height2 = 1;
+	move_source_swap_plan(move_source_swap);
 
 	move_source_swap->midpoint = false;
 }
@@ -332,6 +441,7 @@ static void move_source_swap_source_hide(void *data, calldata_t *call_data)
 static void *move_source_swap_create(obs_data_t *settings, obs_source_t *source)
 {
 	struct move_source_swap_info *move_source_swap = bzalloc(sizeof(struct move_source_swap_info));
+	pthread_mutex_init(&move_source_swap->plan_mutex, NULL);
 	move_filter_init(&move_source_swap->move_filter, source, (void (*)(void *))move_source_swap_start);
 	move_source_swap->move_filter.get_alternative_filter = move_source_swap_get_source;
 	obs_source_update(source, settings);
@@ -407,6 +517,12 @@ static void move_source_swap_destroy(void *data)
 	
 	move_source_swap->scene_item1 = NULL;
 	move_source_swap->scene_item2 = NULL;
+	move_source_swap_plan_clear(move_source_swap);
+	da_free(move_source_swap->plan);
+	pthread_mutex_destroy(&move_source_swap->plan_mutex);
+	for (size_t i = 0; i < move_source_swap->rotate_source_names.num; i++)
+		bfree(move_source_swap->rotate_source_names.array[i]);
+	da_free(move_source_swap->rotate_source_names);
 	move_filter_destroy(&move_source_swap->move_filter);
 	bfree(move_source_swap->source_name1);
 	bfree(move_source_swap->source_name2);
@@ -477,7 +593,7 @@ static void move_source_swap_source_changed(struct move_source_swap_info *move_s
 	if (!scene)
 		scene = obs_group_from_source(parent);
 	if (*old_source_name && scene)
-		obs_scene_enum_items(scene, find_sceneitem, move_source_swap);
+		find_sceneitems(move_source_swap, scene);
 }
 
 static bool move_source_swap_changed(void *data, obs_properties_t *props, obs_property_t *property, obs_data_t *settings)
@@ -556,7 +672,7 @@ static obs_properties_t *move_source_swap_properties(void *data)
 	}
 	if ((!move_source_swap->scene_item1 && move_source_swap->source_name1 && strlen(move_source_swap->source_name1)) ||
 	    (!move_source_swap->scene_item2 && move_source_swap->source_name2 && strlen(move_source_swap->source_name2))) {
-		obs_scene_enum_items(scene, find_sceneitem, move_source_swap);
+		find_sceneitems(move_source_swap, scene);
 	}
 	obs_properties_t *group = obs_properties_create();
 	obs_property_t *p =
@@ -568,6 +684,10 @@ static obs_properties_t *move_source_swap_properties(void *data)
 	obs_scene_enum_items(scene, prop_list_add_sceneitem, p);
 	obs_property_set_modified_callback2(p, move_source_swap_changed, data);
 
+	p = obs_properties_add_editable_list(group, S_ROTATE_SOURCES, obs_module_text("RotateSources"),
+					     OBS_EDITABLE_LIST_TYPE_STRINGS, NULL, NULL);
+	obs_property_set_long_description(p, obs_module_text("RotateSources.Description"));
+
 	p = obs_properties_add_int(group, S_START_DELAY, obs_module_text("StartDelay"), 0, 10000000, 100);
 	obs_property_int_set_suffix(p, "ms");
 	obs_properties_t *duration = obs_properties_create();
@@ -706,6 +826,8 @@ static obs_properties_t *move_source_swap_properties(void *data)
 	obs_property_list_add_int(p, obs_module_text("NextMoveOn.End"), NEXT_MOVE_ON_END);
 	obs_property_list_add_int(p, obs_module_text("NextMoveOn.Hotkey"), NEXT_MOVE_ON_HOTKEY);
 
+	move_filter_loop_properties(group);
+
 	obs_properties_add_button(group, "move_source_start", obs_module_text("Start"), move_source_swap_start_button);
 
 	p = obs_properties_add_group(ppts, S_ACTIONS, obs_module_text("Actions"), OBS_GROUP_NORMAL, group);
@@ -731,12 +853,33 @@ static void move_source_swap_video_render(void *data, gs_effect_t *effect)
 
 void vec2_bezier(struct vec2 *dst, struct vec2 *begin, struct vec2 *control, struct vec2 *end, const float t);
 
-static void move_source_swap_tick(void *data, float seconds)
+static void move_source_swap_commit_scene(void *data, obs_scene_t *scene)
+{
+	struct move_source_swap_info *move_source_swap = data;
+	for (size_t i = 0; i < move_source_swap->plan.num; i++) {
+		struct move_source_swap_track *track = move_source_swap->plan.array + i;
+		if (!track->commit || obs_sceneitem_get_scene(track->item) != scene)
+			continue;
+		obs_sceneitem_defer_update_begin(track->item);
+		obs_sceneitem_set_info2(track->item, &track->info);
+		obs_sceneitem_set_crop(track->item, &track->crop);
+		obs_sceneitem_defer_update_end(track->item);
+		track->commit = false;
+	}
+}
+
+static void move_source_swap_tick_internal(void *data, float seconds)
 {
 	struct move_source_swap_info *move_source_swap = data;
 	float t;
-	if (!move_filter_tick(&move_source_swap->move_filter, seconds, &t))
+	if (!move_filter_tick(&move_source_swap->move_filter, seconds, &t)) {
+		// a stop does not go through move_source_swap_ended, the plan goes unless a start already put in a new one
+		pthread_mutex_lock(&move_source_swap->plan_mutex);
+		if (!move_source_swap->move_filter.moving)
+			move_source_swap_plan_release(move_source_swap);
+		pthread_mutex_unlock(&move_source_swap->plan_mutex);
 		return;
+	}
 
 	if (!move_source_swap->scene_item1 || !move_source_swap->scene_item2) {
 		move_source_swap->move_filter.moving = false;
@@ -783,98 +926,58 @@ static void move_source_swap_tick(void *data, float seconds)
 	else if (t < 0.0f)
 		ot = 0.0f;
 
-	if (move_source_swap->swap_volume && move_source_swap->volume1 != move_source_swap->volume2) {
-		obs_source_set_volume(obs_sceneitem_get_source(move_source_swap->scene_item1),
-				      (1.0f - ot) * move_source_swap->volume1 + ot * move_source_swap->volume2);
-		obs_source_set_volume(obs_sceneitem_get_source(move_source_swap->scene_item2),
-				      (1.0f - ot) * move_source_swap->volume2 + ot * move_source_swap->volume1);
-	}
-
-	struct vec2 pos1;
-	struct vec2 pos2;
-	if (move_source_swap->curve != 0.0f) {
-		const float diff_x = fabsf(move_source_swap->pos1.x - move_source_swap->pos2.x);
-		const float diff_y = fabsf(move_source_swap->pos1.y - move_source_swap->pos2.y);
-		struct vec2 control_pos;
-		vec2_set(&control_pos, 0.5f * move_source_swap->pos1.x + 0.5f * move_source_swap->pos2.x,
-			 0.5f * move_source_swap->pos1.y + 0.5f * move_source_swap->pos2.y);
+	pthread_mutex_lock(&move_source_swap->plan_mutex);
+	for (size_t i = 0; i < move_source_swap->plan.num; i++) {
+		struct move_source_swap_track *track = move_source_swap->plan.array + i;
+		if (move_source_swap->swap_volume && track->from.volume != track->to.volume) {
+			const float volume = (1.0f - ot) * track->from.volume + ot * track->to.volume;
+			if (volume != track->volume) {
+				obs_source_set_volume(track->source, volume);
+				track->volume = volume;
+			}
+		}
 
-		if (control_pos.x >= (move_source_swap->canvas_width >> 1)) {
-			control_pos.x += diff_y * move_source_swap->curve;
+		obs_sceneitem_get_info2(track->item, &track->info);
+		if (track->curved) {
+			vec2_bezier(&track->info.pos, &track->from.pos, &track->control_pos, &track->to.pos, t);
 		} else {
-			control_pos.x -= diff_y * move_source_swap->curve;
+			vec2_set(&track->info.pos, (1.0f - t) * track->from.pos.x + t * track->to.pos.x,
+				 (1.0f - t) * track->from.pos.y + t * track->to.pos.y);
 		}
-		if (control_pos.y >= (move_source_swap->canvas_height >> 1)) {
-			control_pos.y += diff_x * move_source_swap->curve;
-		} else {
-			control_pos.y -= diff_x * move_source_swap->curve;
+		track->info.rot = (1.0f - t) * track->from.rot + t * track->to.rot;
+		if (move_source_swap->stretch) {
+			vec2_set(&track->info.scale, (1.0f - t) * track->from.scale.x + t * track->scale_to.x,
+				 (1.0f - t) * track->from.scale.y + t * track->scale_to.y);
+			vec2_set(&track->info.bounds, (1.0f - t) * track->from.bounds.x + t * track->to.bounds.x,
+				 (1.0f - t) * track->from.bounds.y + t * track->to.bounds.y);
 		}
-		vec2_bezier(&pos1, &move_source_swap->pos1, &control_pos, &move_source_swap->pos2, t);
-		vec2_bezier(&pos2, &move_source_swap->pos2, &control_pos, &move_source_swap->pos1, t);
-	} else {
-		vec2_set(&pos1, (1.0f - t) * move_source_swap->pos1.x + t * move_source_swap->pos2.x,
-			 (1.0f - t) * move_source_swap->pos1.y + t * move_source_swap->pos2.y);
-		vec2_set(&pos2, (1.0f - t) * move_source_swap->pos2.x + t * move_source_swap->pos1.x,
-			 (1.0f - t) * move_source_swap->pos2.y + t * move_source_swap->pos1.y);
-	}
-	obs_sceneitem_defer_update_begin(move_source_swap->scene_item1);
-	obs_sceneitem_defer_update_begin(move_source_swap->scene_item2);
-	obs_sceneitem_set_pos(move_source_swap->scene_item1, &pos1);
-	obs_sceneitem_set_pos(move_source_swap->scene_item2, &pos2);
-	const float rot1 = (1.0f - t) * move_source_swap->rot1 + t * move_source_swap->rot2;
-	const float rot2 = (1.0f - t) * move_source_swap->rot2 + t * move_source_swap->rot1;
-	obs_sceneitem_set_rot(move_source_swap->scene_item1, rot1);
-	obs_sceneitem_set_rot(move_source_swap->scene_item2, rot2);
-	if (move_source_swap->stretch) {
-		struct vec2 scale1;
-		struct vec2 scale2;
-		vec2_set(&scale1,
-			 ((1.0f - t) * move_source_swap->scale1.x * move_source_swap->width1 +
-			  t * move_source_swap->scale2.x * move_source_swap->width2) /
-				 (float)move_source_swap->width1,
-			 ((1.0f - t) * move_source_swap->scale1.y * move_source_swap->height1 +
-			  t * move_source_swap->scale2.y * move_source_swap->height2) /
-				 (float)move_source_swap->height1);
-		vec2_set(&scale2,
-			 ((1.0f - t) * move_source_swap->scale2.x * move_source_swap->width2 +
-			  t * move_source_swap->scale1.x * move_source_swap->width1) /
-				 (float)move_source_swap->width2,
-			 ((1.0f - t) * move_source_swap->scale2.y * move_source_swap->height2 +
-			  t * move_source_swap->scale1.y * move_source_swap->height1) /
-				 (float)move_source_swap->height2);
-		obs_sceneitem_set_scale(move_source_swap->scene_item1, &scale1);
-		obs_sceneitem_set_scale(move_source_swap->scene_item2, &scale2);
-
-		struct vec2 bounds1;
-		struct vec2 bounds2;
-		vec2_set(&bounds1, (1.0f - t) * move_source_swap->bounds1.x + t * move_source_swap->bounds2.x,
-			 (1.0f - t) * move_source_swap->bounds1.y + t * move_source_swap->bounds2.y);
-		vec2_set(&bounds2, (1.0f - t) * move_source_swap->bounds2.x + t * move_source_swap->bounds1.x,
-			 (1.0f - t) * move_source_swap->bounds2.y + t * move_source_swap->bounds1.y);
-		obs_sceneitem_set_bounds(move_source_swap->scene_item2, &bounds2);
-	}
-	struct obs_sceneitem_crop crop1;
-	struct obs_sceneitem_crop crop2;
-	crop1.left = (int)((float)(1.0f - ot) * (float)move_source_swap->crop1.left + ot * (float)move_source_swap->crop2.left);
-	crop2.left = (int)((float)(1.0f - ot) * (float)move_source_swap->crop2.left + ot * (float)move_source_swap->crop1.left);
-	crop1.top = (int)((float)(1.0f - ot) * (float)move_source_swap->crop1.top + ot * (float)move_source_swap->crop2.top);
-	crop2.top = (int)((float)(1.0f - ot) * (float)move_source_swap->crop2.top + ot * (float)move_source_swap->crop1.top);
-	crop1.right = (int)((float)(1.0f - ot) * (float)move_source_swap->crop1.right + ot * (float)move_source_swap->crop2.right);
-	crop2.right = (int)((float)(1.0f - ot) * (float)move_source_swap->crop2.right + ot * (float)move_source_swap->crop1.right);
-	crop1.bottom =
-		(int)((float)(1.0f - ot) * (float)move_source_swap->crop1.bottom + ot * (float)move_source_swap->crop2.bottom);
-	crop2.bottom =
-		(int)((float)(1.0f - ot) * (float)move_source_swap->crop2.bottom + ot * (float)move_source_swap->crop1.bottom);
-	obs_sceneitem_set_crop(move_source_swap->scene_item1, &crop1);
-	obs_sceneitem_set_crop(move_source_swap->scene_item2, &crop2);
-	obs_sceneitem_defer_update_end(move_source_swap->scene_item1);
-	obs_sceneitem_defer_update_end(move_source_swap->scene_item2);
+		track->crop.left = (int)((1.0f - ot) * (float)track->from.crop.left + ot * (float)track->to.crop.left);
+		track->crop.top = (int)((1.0f - ot) * (float)track->from.crop.top + ot * (float)track->to.crop.top);
+		track->crop.right = (int)((1.0f - ot) * (float)track->from.crop.right + ot * (float)track->to.crop.right);
+		track->crop.bottom = (int)((1.0f - ot) * (float)track->from.crop.bottom + ot * (float)track->to.crop.bottom);
+		track->commit = true;
+	}
+
+	// one update per scene for all items of the swap
+	for (size_t i = 0; i < move_source_swap->plan.num; i++) {
+		if (move_source_swap->plan.array[i].commit)
+			obs_scene_atomic_update(obs_sceneitem_get_scene(move_source_swap->plan.array[i].item),
+						move_source_swap_commit_scene, move_source_swap);
+	}
+	pthread_mutex_unlock(&move_source_swap->plan_mutex);
 
 	if (!move_source_swap->move_filter.moving) {
 		move_source_swap_ended(move_source_swap);
 	}
 }
 
+static void move_source_swap_tick(void *data, float seconds)
+{
+	MOVE_PERF_BEGIN(tick_start);
+	move_source_swap_tick_internal(data, seconds);
+	MOVE_PERF_END(MOVE_PERF_SWAP_TICK, tick_start);
+}
+
 static void move_source_swap_update(void *data, obs_data_t *settings)
 {
 	struct move_source_swap_info *move_source_swap = data;
@@ -900,6 +1003,23 @@ static void move_source_swap_update(void *data, obs_data_t *settings)
 	move_source_swap->swap_mute = (uint8_t)obs_data_get_int(settings, S_MUTE_ACTION);
 	move_source_swap->swap_volume = obs_data_get_bool(settings, S_AUDIO_FADE);
 	move_source_swap->stretch = obs_data_get_bool(settings, "stretch");
+
+	for (size_t i = 0; i < move_source_swap->rotate_source_names.num; i++)
+		bfree(move_source_swap->rotate_source_names.array[i]);
+	move_source_swap->rotate_source_names.num = 0;
+	obs_data_array_t *rotate_sources = obs_data_get_array(settings, S_ROTATE_SOURCES);
+	const size_t count = obs_data_array_count(rotate_sources);
+	for (size_t i = 0; i < count; i++) {
+		obs_data_t *item = obs_data_array_item(rotate_sources, i);
+		const char *name = obs_data_get_string(item, "value");
+		if (name && strlen(name)) {
+			char *rotate_source_name = bstrdup(name);
+			da_push_back(move_source_swap->rotate_source_names, &rotate_source_name);
+		}
+		obs_data_release(item);
+	}
+	obs_data_array_release(rotate_sources);
+
 	if (move_source_swap->move_filter.start_trigger == START_TRIGGER_LOAD) {
 		move_source_swap_start(move_source_swap);
 	}
@@ -918,6 +1038,8 @@ struct obs_source_info move_source_swap_filter = {
 	.video_tick = move_source_swap_tick,
 	.update = move_source_swap_update,
 	.load = move_source_swap_update,
+	.filter_add = move_filter_add,
+	.filter_remove = move_filter_remove,
 	.activate = move_filter_activate,
 	.deactivate = move_filter_deactivate,
 	.show = move_filter_show,
@@ -36,8 +36,6 @@ static void move_override_filter_destroy(void *data)
 	bfree(move_filter);
 }
 
-void prop_list_add_easings(obs_property_t *p);
-void prop_list_add_easing_functions(obs_property_t *p);
 void prop_list_add_positions(obs_property_t *p);
 void prop_list_add_transitions(obs_property_t *p);
 void prop_list_add_scales(obs_property_t *p);
@@ -1,4 +1,5 @@
 #include "move-transition.h"
+#include "move-match.h"
 #include <obs-module.h>
 #include <obs-frontend-api.h>
 #include "graphics/math-defs.h"
@@ -7,84 +8,9 @@
 #include <util/threading.h>
 #include "obs-websocket-api.h"
 
-struct move_info {
-	obs_source_t *source;
-	bool start_init;
-	bool first_frame;
-	DARRAY(struct move_item *) items_a;
-	DARRAY(struct move_item *) items_b;
-	float t;
-	float curve_move;
-	float curve_in;
-	float curve_out;
-	obs_source_t *scene_source_a;
-	obs_source_t *scene_source_b;
-	gs_samplerstate_t *point_sampler;
-	long long easing_move;
-	long long easing_in;
-	long long easing_out;
-	long long easing_function_move;
-	long long easing_function_in;
-	long long easing_function_out;
-	float zoom_in;
-	float zoom_out;
-	long long position_in;
-	long long position_out;
-	char *transition_move;
-	char *transition_in;
-	char *transition_out;
-	bool part_match;
-	bool number_match;
-	bool last_word_match;
-	enum obs_transition_scale_type transition_move_scale;
-	size_t item_pos;
-	uint32_t matched_items;
-	bool matched_scene_a;
-	bool matched_scene_b;
-	uint32_t item_order_switch_percentage;
-	bool nested_scenes;
-	bool cache_transitions;
-	DARRAY(obs_source_t *) transition_pool_move;
-	size_t transition_pool_move_index;
-	DARRAY(obs_source_t *) transition_pool_in;
-	size_t transition_pool_in_index;
-	DARRAY(obs_source_t *) transition_pool_out;
-	size_t transition_pool_out_index;
-
-	bool scene_flip_horizontal;
-	bool scene_flip_vertical;
-};
-
 DARRAY(struct move_info *) move_rendering;
 DARRAY(char *) move_render_filter_ids;
 
-struct move_item {
-	obs_sceneitem_t *item_a;
-	obs_sceneitem_t *item_b;
-	gs_texrender_t *item_render;
-	obs_source_t *transition;
-	long long easing;
-	long long easing_function;
-	float zoom;
-	long long position;
-	char *transition_name;
-	enum obs_transition_scale_type transition_scale;
-	float curve;
-	bool move_scene;
-	int start_percentage;
-	int end_percentage;
-	obs_scene_t *release_scene_a;
-	obs_scene_t *release_scene_b;
-	bool scene_flip_horizontal;
-	bool scene_flip_vertical;
-	struct matrix4 transform_a;
-	struct matrix4 transform_b;
-	struct obs_sceneitem_crop bounds_crop_a;
-	struct obs_sceneitem_crop bounds_crop_b;
-	bool move_filter_a;
-	bool move_filter_b;
-};
-
 static const struct {
 	enum gs_blend_type src_color;
 	enum gs_blend_type src_alpha;
@@ -698,116 +624,6 @@ static obs_source_t *obs_frontend_get_transition(const char *name)
 	return NULL;
 }
 
-float get_eased(float f, long long easing, long long easing_function)
-{
-	float t = f;
-	if (EASE_NONE == easing) {
-	} else if (EASE_IN == easing) {
-		switch (easing_function) {
-		case EASING_QUADRATIC:
-			t = QuadraticEaseIn(f);
-			break;
-		case EASING_CUBIC:
-			t = CubicEaseIn(f);
-			break;
-		case EASING_QUARTIC:
-			t = QuarticEaseIn(f);
-			break;
-		case EASING_QUINTIC:
-			t = QuinticEaseIn(f);
-			break;
-		case EASING_SINE:
-			t = SineEaseIn(f);
-			break;
-		case EASING_CIRCULAR:
-			t = CircularEaseIn(f);
-			break;
-		case EASING_EXPONENTIAL:
-			t = ExponentialEaseIn(f);
-			break;
-		case EASING_ELASTIC:
-			t = ElasticEaseIn(f);
-			break;
-		case EASING_BOUNCE:
-			t = BounceEaseIn(f);
-			break;
-		case EASING_BACK:
-			t = BackEaseIn(f);
-			break;
-		default:;
-		}
-	} else if (EASE_OUT == easing) {
-		switch (easing_function) {
-		case EASING_QUADRATIC:
-			t = QuadraticEaseOut(f);
-			break;
-		case EASING_CUBIC:
-			t = CubicEaseOut(f);
-			break;
-		case EASING_QUARTIC:
-			t = QuarticEaseOut(f);
-			break;
-		case EASING_QUINTIC:
-			t = QuinticEaseOut(f);
-			break;
-		case EASING_SINE:
-			t = SineEaseOut(f);
-			break;
-		case EASING_CIRCULAR:
-			t = CircularEaseOut(f);
-			break;
-		case EASING_EXPONENTIAL:
-			t = ExponentialEaseOut(f);
-			break;
-		case EASING_ELASTIC:
-			t = ElasticEaseOut(f);
-			break;
-		case EASING_BOUNCE:
-			t = BounceEaseOut(f);
-			break;
-		case EASING_BACK:
-			t = BackEaseOut(f);
-			break;
-		default:;
-		}
-	} else if (EASE_IN_OUT == easing) {
-		switch (easing_function) {
-		case EASING_QUADRATIC:
-			t = QuadraticEaseInOut(f);
-			break;
-		case EASING_CUBIC:
-			t = CubicEaseInOut(f);
-			break;
-		case EASING_QUARTIC:
-			t = QuarticEaseInOut(f);
-			break;
-		case EASING_QUINTIC:
-			t = QuinticEaseInOut(f);
-			break;
-		case EASING_SINE:
-			t = SineEaseInOut(f);
-			break;
-		case EASING_CIRCULAR:
-			t = CircularEaseInOut(f);
-			break;
-		case EASING_EXPONENTIAL:
-			t = ExponentialEaseInOut(f);
-			break;
-		case EASING_ELASTIC:
-			t = ElasticEaseInOut(f);
-			break;
-		case EASING_BOUNCE:
-			t = BounceEaseInOut(f);
-			break;
-		case EASING_BACK:
-			t = BackEaseInOut(f);
-			break;
-		default:;
-		}
-	}
-	return t;
-}
-
 obs_source_t *get_transition(const char *transition_name, void *pool_data, size_t *index, bool cache)
 {
 
@@ -818,8 +634,11 @@ obs_source_t *get_transition(const char *transition_name, void *pool_data, size_
 	if (cache && transition_pool->num && *index < transition_pool->num) {
 		obs_source_t *transition = obs_source_get_ref(transition_pool->array[i]);
 		*index = i + 1;
+		MOVE_PERF_EVENT(MOVE_PERF_POOL_HIT);
 		return transition;
 	}
+	if (cache)
+		MOVE_PERF_EVENT(MOVE_PERF_POOL_MISS);
 	obs_source_t *frontend_transition = obs_frontend_get_transition(transition_name);
 	if (!frontend_transition)
 		return NULL;
@@ -1512,6 +1331,7 @@ bool render2_item(struct move_info *move, struct move_item *item)
 		if (width && height &&
 		    gs_texrender_begin(item->item_render, width - (bounds_crop.left + bounds_crop.right),
 				       height - (bounds_crop.top + bounds_crop.bottom))) {
+			MOVE_PERF_EVENT(MOVE_PERF_OFFSCREEN_PASS);
 			float cx_scale = (float)original_width / (float)(width - (bounds_crop.left + bounds_crop.right));
 			float cy_scale = (float)original_height / (float)(height - (bounds_crop.top + bounds_crop.bottom));
 			struct vec4 clear_color;
@@ -1648,58 +1468,6 @@ bool render2_item(struct move_info *move, struct move_item *item)
 	return true;
 }
 
-void get_override_filter(obs_source_t *source, obs_source_t *filter, void *param)
-{
-	UNUSED_PARAMETER(source);
-	if (!obs_source_enabled(filter))
-		return;
-	if (strcmp(obs_source_get_unversioned_id(filter), "move_transition_override_filter") != 0)
-		return;
-	obs_source_t *target = *(obs_source_t **)param;
-	if (!target) {
-		*(obs_source_t **)param = filter;
-		return;
-	}
-
-	if (obs_source_get_type(target) == OBS_SOURCE_TYPE_FILTER)
-		return;
-	obs_data_t *settings = obs_source_get_settings(filter);
-	if (!settings)
-		return;
-	const char *sn = obs_data_get_string(settings, S_SOURCE);
-	if (sn && strlen(sn)) {
-		if (strcmp(obs_source_get_name(target), sn) == 0) {
-			*(obs_source_t **)param = filter;
-		}
-	}
-	obs_data_release(settings);
-}
-
-obs_data_t *get_override_filter_settings(obs_sceneitem_t *item)
-{
-	if (!item)
-		return NULL;
-	obs_source_t *filter = obs_sceneitem_get_source(item);
-	obs_scene_t *scene = obs_sceneitem_get_scene(item);
-	if (scene) {
-		obs_source_t *scene_source = obs_scene_get_source(scene);
-		obs_source_enum_filters(scene_source, get_override_filter, &filter);
-	}
-
-	obs_source_t *source = obs_sceneitem_get_source(item);
-	if (!source)
-		return NULL;
-
-	if (filter && filter != source)
-		return obs_source_get_settings(filter);
-
-	filter = NULL;
-	obs_source_enum_filters(source, get_override_filter, &filter);
-	if (filter && filter != source)
-		return obs_source_get_settings(filter);
-	return NULL;
-}
-
 bool same_transform_type(struct obs_transform_info *info_a, struct obs_transform_info *info_b)
 {
 	if (!info_a || !info_b)
@@ -1709,653 +1477,6 @@ bool same_transform_type(struct obs_transform_info *info_a, struct obs_transform
 	       info_a->bounds_alignment == info_b->bounds_alignment;
 }
 
-struct move_item *match_item_by_override(struct move_info *move, obs_sceneitem_t *scene_item, size_t *found_pos)
-{
-	struct move_item *item = NULL;
-	obs_source_t *source = obs_sceneitem_get_source(scene_item);
-	const char *name_b = obs_source_get_name(source);
-	obs_data_t *override_filter_b = get_override_filter_settings(scene_item);
-	const char *override_name_b = override_filter_b ? obs_data_get_string(override_filter_b, S_MATCH_SOURCE) : NULL;
-	obs_data_release(override_filter_b);
-	for (size_t i = 0; i < move->items_a.num; i++) {
-		struct move_item *check_item = move->items_a.array[i];
-		if (check_item->item_b)
-			continue;
-		obs_source_t *check_source = obs_sceneitem_get_source(check_item->item_a);
-		if (!check_source)
-			continue;
-		const char *name_a = obs_source_get_name(check_source);
-		if (name_a && strlen(name_a) && override_name_b && strcmp(name_a, override_name_b) == 0) {
-			item = check_item;
-			*found_pos = i;
-			break;
-		}
-		if (!name_b || !strlen(name_b))
-			continue;
-		obs_data_t *override_filter_a = get_override_filter_settings(check_item->item_a);
-		if (override_filter_a) {
-			const char *override_name_a = obs_data_get_string(override_filter_a, S_MATCH_SOURCE);
-			obs_data_release(override_filter_a);
-			if (strcmp(override_name_a, name_b) == 0) {
-				item = check_item;
-				*found_pos = i;
-				break;
-			}
-		}
-	}
-	return item;
-}
-
-bool is_number_match(const char c)
-{
-	if (c >= '0' && c <= '9')
-		return true;
-	if (c == '(' || c == ')' || c == ' ' || c == '.' || c == ',')
-		return true;
-	return false;
-}
-
-struct move_item *match_item_by_name(struct move_info *move, obs_sceneitem_t *scene_item, size_t *found_pos)
-{
-	struct move_item *item = NULL;
-	obs_source_t *source = obs_sceneitem_get_source(scene_item);
-	const char *name_b = obs_source_get_name(source);
-	if (!name_b || !strlen(name_b))
-		return item;
-	for (size_t i = 0; i < move->items_a.num; i++) {
-		struct move_item *check_item = move->items_a.array[i];
-		if (check_item->item_b)
-			continue;
-
-		obs_source_t *check_source = obs_sceneitem_get_source(check_item->item_a);
-		if (!check_source)
-			continue;
-		if (check_source == source) {
-			item = check_item;
-			*found_pos = i;
-			break;
-		}
-		const char *name_a = obs_source_get_name(check_source);
-		if (!name_a)
-			continue;
-		if (strcmp(name_a, name_b) == 0) {
-			item = check_item;
-			*found_pos = i;
-			break;
-		}
-	}
-	return item;
-}
-
-struct move_item *match_item_by_type_and_settings(struct move_info *move, obs_sceneitem_t *scene_item, size_t *found_pos)
-{
-
-	struct move_item *item = NULL;
-	obs_source_t *source = obs_sceneitem_get_source(scene_item);
-	if (obs_source_is_scene(source) || obs_source_is_group(source))
-		return item;
-	for (size_t i = 0; i < move->items_a.num; i++) {
-		struct move_item *check_item = move->items_a.array[i];
-		if (check_item->item_b)
-			continue;
-
-		obs_source_t *check_source = obs_sceneitem_get_source(check_item->item_a);
-		if (!check_source)
-			continue;
-		if (obs_source_get_type(check_source) != obs_source_get_type(source))
-			continue;
-
-		if (strcmp(obs_source_get_unversioned_id(check_source), obs_source_get_unversioned_id(source)) != 0)
-			continue;
-
-		obs_data_t *settings = obs_source_get_settings(source);
-		obs_data_t *check_settings = obs_source_get_settings(check_source);
-		if (settings && check_settings && strcmp(obs_data_get_json(settings), obs_data_get_json(check_settings)) == 0) {
-			item = check_item;
-			*found_pos = i;
-			obs_data_release(check_settings);
-			obs_data_release(settings);
-			break;
-		}
-		obs_data_release(check_settings);
-		obs_data_release(settings);
-	}
-	return item;
-}
-
-struct move_item *match_item_clone(struct move_info *move, obs_sceneitem_t *scene_item, size_t *found_pos)
-{
-	struct move_item *item = NULL;
-	obs_source_t *source = obs_sceneitem_get_source(scene_item);
-	const char *name_b = obs_source_get_name(source);
-	if (!name_b || !strlen(name_b))
-		return item;
-	for (size_t i = 0; i < move->items_a.num; i++) {
-		struct move_item *check_item = move->items_a.array[i];
-		if (check_item->item_b)
-			continue;
-		obs_source_t *check_source = obs_sceneitem_get_source(check_item->item_a);
-		if (!check_source)
-			continue;
-		const char *name_a = obs_source_get_name(check_source);
-		if (!name_a || !strlen(name_a))
-			continue;
-		const char *id_a = obs_source_get_unversioned_id(check_source);
-		const char *id_b = obs_source_get_unversioned_id(source);
-		const char *clone_a = NULL;
-		const char *clone_b = NULL;
-		if (strcmp(id_a, "source-clone") == 0) {
-			obs_data_t *s = obs_source_get_settings(check_source);
-			clone_a = obs_data_get_string(s, "clone");
-			obs_data_release(s);
-		} else if (strcmp(id_a, "streamfx-source-mirror") == 0) {
-			obs_data_t *s = obs_source_get_settings(check_source);
-			clone_a = obs_data_get_string(s, "Source.Mirror.Source");
-			obs_data_release(s);
-		}
-
-		if (strcmp(id_b, "source-clone") == 0) {
-			obs_data_t *s = obs_source_get_settings(source);
-			clone_b = obs_data_get_string(s, "clone");
-			obs_data_release(s);
-		} else if (strcmp(id_b, "streamfx-source-mirror") == 0) {
-			obs_data_t *s = obs_source_get_settings(check_source);
-			clone_b = obs_data_get_string(s, "Source.Mirror.Source");
-			obs_data_release(s);
-		}
-		if ((clone_a && clone_b && strcmp(clone_a, clone_b) == 0) || (clone_a && strcmp(clone_a, name_b) == 0) ||
-		    (clone_b && strcmp(clone_b, name_a) == 0)) {
-			item = check_item;
-			*found_pos = i;
-			break;
-		}
-	}
-	return item;
-}
-
-struct move_item *match_item_name_part(struct move_info *move, obs_sceneitem_t *scene_item, size_t *found_pos)
-{
-	struct move_item *item = NULL;
-
-	if (!move->last_word_match && !move->number_match && !move->part_match)
-		return item;
-
-	obs_source_t *source = obs_sceneitem_get_source(scene_item);
-	const char *name_b = obs_source_get_name(source);
-	if (!name_b || !strlen(name_b))
-		return item;
-	for (size_t i = 0; i < move->items_a.num; i++) {
-		struct move_item *check_item = move->items_a.array[i];
-		if (check_item->item_b)
-			continue;
-
-		obs_source_t *check_source = obs_sceneitem_get_source(check_item->item_a);
-		if (!check_source)
-			continue;
-		const char *name_a = obs_source_get_name(check_source);
-		if (!name_a)
-			continue;
-
-		size_t len_a = strlen(name_a);
-		size_t len_b = strlen(name_b);
-		if (!len_a || !len_b)
-			continue;
-
-		if (len_a > len_b) {
-			if (move->last_word_match) {
-				const char *last_space = strrchr(name_b, ' ');
-				if (last_space && last_space > name_b) {
-					len_b = last_space - name_b;
-				}
-			}
-			while (len_b > 0 && move->number_match && is_number_match(name_b[len_b - 1]))
-				len_b--;
-			if (len_b > 0 && move->part_match) {
-				for (size_t pos = 0; pos <= len_a - len_b; pos++) {
-					if (memcmp(name_a + pos, name_b, len_b) == 0) {
-						item = check_item;
-						*found_pos = i;
-						break;
-					}
-				}
-				if (item)
-					break;
-			} else if (len_b > 0 && memcmp(name_a, name_b, len_b) == 0) {
-				item = check_item;
-				*found_pos = i;
-				break;
-			}
-
-		} else {
-			if (move->last_word_match) {
-				const char *last_space = strrchr(name_a, ' ');
-				if (last_space && last_space > name_a) {
-					len_a = last_space - name_a;
-				}
-			}
-			while (len_a > 0 && move->number_match && is_number_match(name_a[len_a - 1]))
-				len_a--;
-			if (len_a > 0 && move->part_match) {
-				for (size_t pos = 0; pos <= len_b - len_a; pos++) {
-					if (memcmp(name_a, name_b + pos, len_a) == 0) {
-						item = check_item;
-						*found_pos = i;
-						break;
-					}
-				}
-				if (item)
-					break;
-			} else if (len_a > 0 && memcmp(name_a, name_b, len_a) == 0) {
-				item = check_item;
-				*found_pos = i;
-				break;
-			}
-		}
-	}
-	return item;
-}
-
-struct match_item_clone_match {
-	const char *name;
-	obs_sceneitem_t *matched;
-};
-
-bool match_item_clone_match(obs_scene_t *scene, obs_sceneitem_t *sceneitem, void *p)
-{
-	UNUSED_PARAMETER(scene);
-	if (!obs_sceneitem_visible(sceneitem))
-		return true;
-	struct match_item_clone_match *mi = p;
-	obs_source_t *source = obs_sceneitem_get_source(sceneitem);
-	const char *id = obs_source_get_unversioned_id(source);
-	bool match = false;
-	if (strcmp(id, "source-clone") == 0) {
-		obs_data_t *s = obs_source_get_settings(source);
-		match = strcmp(obs_data_get_string(s, "clone"), mi->name) == 0;
-		obs_data_release(s);
-	} else if (strcmp(id, "streamfx-source-mirror") == 0) {
-		obs_data_t *s = obs_source_get_settings(source);
-		match = strcmp(obs_data_get_string(s, "Source.Mirror.Source"), mi->name) == 0;
-		obs_data_release(s);
-	}
-	if (match) {
-		mi->matched = sceneitem;
-		return false;
-	}
-	return true;
-}
-
-obs_sceneitem_t *scene_find_source(obs_scene_t *scene, const char *name)
-{
-	obs_sceneitem_t *item = obs_scene_find_source(scene, name);
-	if (!item) {
-		struct match_item_clone_match mi;
-		mi.name = name;
-		mi.matched = NULL;
-		obs_scene_enum_items(scene, match_item_clone_match, &mi);
-		item = mi.matched;
-	}
-	return item;
-}
-
-struct match_item_nested_match {
-	obs_source_t *check_source;
-	bool matched;
-	bool scene_flip_horizontal;
-	bool scene_flip_vertical;
-};
-
-bool match_item_nested_all_match(obs_scene_t *obs_scene, obs_sceneitem_t *sceneitem, void *p)
-{
-	UNUSED_PARAMETER(obs_scene);
-	if (!obs_sceneitem_visible(sceneitem))
-		return true;
-	struct match_item_nested_match *mi = p;
-	obs_source_t *source = obs_sceneitem_get_source(sceneitem);
-	if (!source)
-		return true;
-	obs_scene_t *scene = obs_scene_from_source(mi->check_source);
-	if (!scene)
-		scene = obs_group_from_source(mi->check_source);
-	const char *source_name = obs_source_get_name(source);
-	obs_sceneitem_t *item = scene_find_source(scene, source_name);
-	if (!item) {
-		source_name = NULL;
-		const char *id = obs_source_get_unversioned_id(source);
-		if (strcmp(id, "source-clone") == 0) {
-			obs_data_t *s = obs_source_get_settings(source);
-			source_name = obs_data_get_string(s, "clone");
-			obs_data_release(s);
-		} else if (strcmp(id, "streamfx-source-mirror") == 0) {
-			obs_data_t *s = obs_source_get_settings(source);
-			source_name = obs_data_get_string(s, "Source.Mirror.Source");
-			obs_data_release(s);
-		}
-		if (source_name)
-			item = scene_find_source(scene, source_name);
-	}
-	if (!item) {
-		mi->matched = false;
-		return false;
-	}
-	return true;
-}
-
-struct move_item *match_item_scene_same(struct move_info *move, obs_sceneitem_t *scene_item, size_t *found_pos)
-{
-	struct move_item *item = NULL;
-	if (!move->nested_scenes)
-		return item;
-	obs_source_t *source = obs_sceneitem_get_source(scene_item);
-	if (!obs_source_is_scene(source) && !obs_source_is_group(source))
-		return item;
-	obs_scene_t *scene = obs_scene_from_source(source);
-	if (!scene)
-		scene = obs_group_from_source(source);
-
-	for (size_t i = 0; i < move->items_a.num; i++) {
-		struct move_item *check_item = move->items_a.array[i];
-		if (check_item->item_b || check_item->move_scene)
-			continue;
-
-		obs_source_t *check_source = obs_sceneitem_get_source(check_item->item_a);
-		if (!check_source)
-			continue;
-
-		if (!obs_source_is_scene(check_source) && !obs_source_is_group(check_source))
-			continue;
-
-		obs_scene_t *check_scene = obs_scene_from_source(check_source);
-		if (!check_scene)
-			check_scene = obs_group_from_source(check_source);
-
-		struct match_item_nested_match mi;
-		mi.check_source = check_source;
-		mi.matched = true;
-		obs_scene_enum_items(scene, match_item_nested_all_match, &mi);
-		mi.check_source = source;
-		obs_scene_enum_items(check_scene, match_item_nested_all_match, &mi);
-		if (mi.matched) {
-			item = check_item;
-			item->move_scene = true;
-			*found_pos = i;
-			break;
-		}
-	}
-	return item;
-}
-
-bool match_item_nested_match(obs_scene_t *obs_scene, obs_sceneitem_t *sceneitem, void *p)
-{
-	UNUSED_PARAMETER(obs_scene);
-	if (!obs_sceneitem_visible(sceneitem))
-		return true;
-	struct match_item_nested_match *mi = p;
-	obs_source_t *source = obs_sceneitem_get_source(sceneitem);
-	if (!source)
-		return true;
-	if (source == mi->check_source) {
-		mi->matched = true;
-		struct vec2 scale;
-		obs_sceneitem_get_scale(sceneitem, &scale);
-		mi->scene_flip_horizontal = mi->scene_flip_horizontal && scale.x < 0.0f;
-		mi->scene_flip_vertical = mi->scene_flip_vertical && scale.y < 0.0f;
-		return false;
-	}
-	const char *name_a = obs_source_get_name(mi->check_source);
-	const char *name_b = obs_source_get_name(source);
-	if (name_a && name_b && strlen(name_a) && strlen(name_b) && strcmp(name_a, name_b) == 0) {
-		mi->matched = true;
-		struct vec2 scale;
-		obs_sceneitem_get_scale(sceneitem, &scale);
-		mi->scene_flip_horizontal = mi->scene_flip_horizontal && scale.x < 0.0f;
-		mi->scene_flip_vertical = mi->scene_flip_vertical && scale.y < 0.0f;
-		return false;
-	}
-	return true;
-}
-
-struct move_item *match_item_nested(struct move_info *move, obs_sceneitem_t *scene_item, size_t *found_pos)
-{
-	struct move_item *item = NULL;
-	if (!move->nested_scenes)
-		return item;
-	obs_source_t *source = obs_sceneitem_get_source(scene_item);
-
-	for (size_t i = 0; i < move->items_a.num; i++) {
-		struct move_item *check_item = move->items_a.array[i];
-		if (check_item->item_b || check_item->move_scene)
-			continue;
-
-		obs_source_t *check_source = obs_sceneitem_get_source(check_item->item_a);
-		if (!check_source)
-			continue;
-		if (obs_source_is_scene(source)) {
-			obs_scene_t *scene = obs_scene_from_source(source);
-			struct match_item_nested_match mi;
-			mi.check_source = check_source;
-			mi.matched = false;
-			struct vec2 scale;
-			obs_sceneitem_get_scale(check_item->item_a, &scale);
-			mi.scene_flip_horizontal = scale.x < 0.0f;
-			mi.scene_flip_vertical = scale.y < 0.0f;
-			obs_scene_enum_items(scene, match_item_nested_match, &mi);
-			if (mi.matched) {
-				item = check_item;
-				item->move_scene = true;
-				item->scene_flip_horizontal = mi.scene_flip_horizontal;
-				item->scene_flip_vertical = mi.scene_flip_vertical;
-				*found_pos = i;
-				break;
-			}
-		} else if (obs_source_is_group(source)) {
-			obs_scene_t *scene = obs_group_from_source(source);
-			struct match_item_nested_match mi;
-			mi.check_source = check_source;
-			mi.matched = false;
-			struct vec2 scale;
-			obs_sceneitem_get_scale(check_item->item_a, &scale);
-			mi.scene_flip_horizontal = scale.x < 0.0f;
-			mi.scene_flip_vertical = scale.y < 0.0f;
-			obs_scene_enum_items(scene, match_item_nested_match, &mi);
-			if (mi.matched) {
-				item = check_item;
-				item->move_scene = true;
-				item->scene_flip_horizontal = mi.scene_flip_horizontal;
-				item->scene_flip_vertical = mi.scene_flip_vertical;
-				*found_pos = i;
-				break;
-			}
-		}
-		if (obs_source_is_scene(check_source)) {
-			obs_scene_t *scene = obs_scene_from_source(check_source);
-			struct match_item_nested_match mi;
-			mi.check_source = source;
-			mi.matched = false;
-			struct vec2 scale;
-			obs_sceneitem_get_scale(scene_item, &scale);
-			mi.scene_flip_horizontal = scale.x < 0.0f;
-			mi.scene_flip_vertical = scale.y < 0.0f;
-			obs_scene_enum_items(scene, match_item_nested_match, &mi);
-			if (mi.matched) {
-				item = check_item;
-				item->move_scene = true;
-				item->scene_flip_horizontal = mi.scene_flip_horizontal;
-				item->scene_flip_vertical = mi.scene_flip_vertical;
-				*found_pos = i;
-				break;
-			}
-		} else if (obs_source_is_group(check_source)) {
-			obs_scene_t *scene = obs_group_from_source(check_source);
-			struct match_item_nested_match mi;
-			mi.check_source = source;
-			mi.matched = false;
-			struct vec2 scale;
-			obs_sceneitem_get_scale(scene_item, &scale);
-			mi.scene_flip_horizontal = scale.x < 0.0f;
-			mi.scene_flip_vertical = scale.y < 0.0f;
-			obs_scene_enum_items(scene, match_item_nested_match, &mi);
-			if (mi.matched) {
-				item = check_item;
-				item->move_scene = true;
-				item->scene_flip_horizontal = mi.scene_flip_horizontal;
-				item->scene_flip_vertical = mi.scene_flip_vertical;
-				*found_pos = i;
-				break;
-			}
-		}
-	}
-	return item;
-}
-
-bool match_item_nested_any_match(obs_scene_t *obs_scene, obs_sceneitem_t *sceneitem, void *p)
-{
-	UNUSED_PARAMETER(obs_scene);
-	if (!obs_sceneitem_visible(sceneitem))
-		return true;
-	struct match_item_nested_match *mi = p;
-	obs_source_t *source = obs_sceneitem_get_source(sceneitem);
-	if (!source)
-		return true;
-	obs_scene_t *scene = obs_scene_from_source(mi->check_source);
-	if (!scene)
-		scene = obs_group_from_source(mi->check_source);
-	const char *source_name = obs_source_get_name(source);
-	obs_sceneitem_t *item = scene_find_source(scene, source_name);
-	if (!item) {
-		source_name = NULL;
-		const char *id = obs_source_get_unversioned_id(source);
-		if (strcmp(id, "source-clone") == 0) {
-			obs_data_t *s = obs_source_get_settings(source);
-			source_name = obs_data_get_string(s, "clone");
-			obs_data_release(s);
-		} else if (strcmp(id, "streamfx-source-mirror") == 0) {
-			obs_data_t *s = obs_source_get_settings(source);
-			source_name = obs_data_get_string(s, "Source.Mirror.Source");
-			obs_data_release(s);
-		}
-		if (source_name)
-			item = scene_find_source(scene, source_name);
-	}
-	if (item && obs_sceneitem_visible(item)) {
-		mi->matched = true;
-		return false;
-	}
-	return true;
-}
-
-struct move_item *match_item_scene_match(struct move_info *move, obs_sceneitem_t *scene_item, size_t *found_pos)
-{
-	struct move_item *item = NULL;
-	if (!move->nested_scenes)
-		return item;
-	obs_source_t *source = obs_sceneitem_get_source(scene_item);
-	if (!obs_source_is_scene(source) && !obs_source_is_group(source))
-		return item;
-	obs_scene_t *scene = obs_scene_from_source(source);
-	if (!scene)
-		scene = obs_group_from_source(source);
-
-	for (size_t i = 0; i < move->items_a.num; i++) {
-		struct move_item *check_item = move->items_a.array[i];
-		if (check_item->item_b || check_item->move_scene)
-			continue;
-
-		obs_source_t *check_source = obs_sceneitem_get_source(check_item->item_a);
-		if (!check_source)
-			continue;
-		if (!obs_source_is_scene(check_source) && !obs_source_is_group(check_source))
-			continue;
-
-		obs_scene_t *check_scene = obs_scene_from_source(check_source);
-		if (!check_scene)
-			check_scene = obs_group_from_source(check_source);
-
-		struct match_item_nested_match mi;
-		mi.check_source = check_source;
-		mi.matched = false;
-		obs_scene_enum_items(scene, match_item_nested_any_match, &mi);
-		mi.check_source = source;
-		obs_scene_enum_items(check_scene, match_item_nested_any_match, &mi);
-		if (mi.matched) {
-			item = check_item;
-			item->move_scene = true;
-			*found_pos = i;
-			break;
-		}
-	}
-	return item;
-}
-
-typedef struct move_item *(*match_function)(struct move_info *move, obs_sceneitem_t *scene_item, size_t *found_pos);
-
-#define MATCH_FUNCTION_COUNT 8
-match_function match_functions[MATCH_FUNCTION_COUNT] = {
-	match_item_by_override,          match_item_by_name,    match_item_clone,  match_item_name_part,
-	match_item_by_type_and_settings, match_item_scene_same, match_item_nested, match_item_scene_match};
-
-struct move_item *create_move_item()
-{
-	struct move_item *item = bzalloc(sizeof(struct move_item));
-	item->end_percentage = 100;
-	return item;
-}
-
-bool add_item(obs_scene_t *scene, obs_sceneitem_t *scene_item, void *data)
-{
-	UNUSED_PARAMETER(scene);
-	if (!obs_sceneitem_visible(scene_item)) {
-		return true;
-	}
-	struct move_info *move = data;
-	struct move_item *item = create_move_item();
-	da_push_back(move->items_a, &item);
-	obs_sceneitem_addref(scene_item);
-	item->item_a = scene_item;
-	item->move_scene = obs_sceneitem_get_source(scene_item) == move->scene_source_b;
-	if (item->move_scene)
-		move->matched_scene_b = true;
-	return true;
-}
-
-bool match_item(obs_scene_t *scene, obs_sceneitem_t *scene_item, void *data)
-{
-	UNUSED_PARAMETER(scene);
-	if (!obs_sceneitem_visible(scene_item)) {
-		return true;
-	}
-	struct move_info *move = data;
-	size_t old_pos = 0;
-	struct move_item *item;
-	if (obs_sceneitem_get_source(scene_item) == move->scene_source_a) {
-		item = create_move_item();
-		da_insert(move->items_a, move->item_pos, &item);
-		move->item_pos++;
-		item->move_scene = true;
-		move->matched_scene_a = true;
-	} else {
-		for (size_t i = 0; i < MATCH_FUNCTION_COUNT; i++) {
-			item = match_functions[i](move, scene_item, &old_pos);
-			if (item)
-				break;
-		}
-		if (item) {
-			move->matched_items++;
-			if (old_pos >= move->item_pos)
-				move->item_pos = old_pos + 1;
-		} else {
-			item = create_move_item();
-			da_insert(move->items_a, move->item_pos, &item);
-			move->item_pos++;
-		}
-	}
-	obs_sceneitem_addref(scene_item);
-	item->item_b = scene_item;
-
-	da_push_back(move->items_b, &item);
-	return true;
-}
-
 void sceneitem_start_move(obs_sceneitem_t *item, const char *start_move)
 {
 	obs_scene_t *scene = obs_sceneitem_get_scene(item);
@@ -2378,15 +1499,6 @@ void sceneitem_start_move(obs_sceneitem_t *item, const char *start_move)
 		move_filter_start(obs_obj_get_data(filter));
 }
 
-static bool darray_sceneitem_push_back(obs_scene_t *scene, obs_sceneitem_t *item, void *data)
-{
-	UNUSED_PARAMETER(scene);
-	struct darray *array = data;
-	if (obs_sceneitem_visible(item))
-		darray_push_back(sizeof(item), array, &item);
-	return true;
-}
-
 static void move_filter_start_matching(obs_source_t *parent, obs_source_t *child, void *param)
 {
 	UNUSED_PARAMETER(param);
@@ -2448,6 +1560,7 @@ static void move_start_init(struct move_info *move, bool in_graphics)
 		return;
 	move->start_init = false;
 	move->first_frame = true;
+	MOVE_PERF_BEGIN(match_start);
 
 	struct move_item *scene_flip_item = NULL;
 	obs_sceneitem_t *scene_flip_sceneitem = NULL;
@@ -2504,108 +1617,7 @@ static void move_start_init(struct move_info *move, bool in_graphics)
 	if (!scene_b)
 		scene_b = obs_group_from_source(move->scene_source_b);
 	if (scene_b) {
-		//put items in todo array
-		DARRAY(obs_sceneitem_t *) items;
-		da_init(items);
-		obs_scene_enum_items(scene_b, darray_sceneitem_push_back, &items);
-		struct move_item *item = NULL;
-		for (size_t i = items.num; i > 0; i--) {
-			obs_sceneitem_t *scene_item = items.array[i - 1];
-			if (obs_sceneitem_get_source(scene_item) == move->scene_source_a) {
-
-				struct move_item *item = NULL;
-				for (size_t j = 0; j < MATCH_FUNCTION_COUNT; j++) {
-					size_t old_pos = 0;
-					item = match_functions[j](move, scene_item, &old_pos);
-					if (item)
-						break;
-				}
-				if (item && item->move_scene) {
-					obs_sceneitem_release(item->item_a);
-					if (item->release_scene_a)
-						obs_scene_release(item->release_scene_a);
-					if (item->release_scene_b)
-						obs_scene_release(item->release_scene_b);
-					da_erase_item(move->items_a, &item);
-					bfree(item->transition_name);
-					bfree(item);
-					item = create_move_item();
-				} else if (item) {
-					move->matched_items++;
-				} else {
-					item = create_move_item();
-				}
-				item->move_scene = true;
-				move->matched_scene_a = true;
-				da_erase(items, i - 1);
-
-				obs_sceneitem_addref(scene_item);
-				item->item_b = scene_item;
-				da_insert(move->items_b, 0, &item);
-			}
-		}
-		if (!move->matched_scene_a) {
-			for (size_t i = 0; i < MATCH_FUNCTION_COUNT; i++) {
-				for (size_t j = items.num; j > 0; j--) {
-					obs_sceneitem_t *scene_item = items.array[j - 1];
-					size_t old_pos = 0;
-					item = match_functions[i](move, scene_item, &old_pos);
-					if (item) {
-						move->matched_items++;
-
-						da_erase(items, j - 1);
-
-						obs_sceneitem_addref(scene_item);
-						item->item_b = scene_item;
-					}
-				}
-			}
-		}
-		for (size_t i = items.num; i > 0; i--) {
-			obs_sceneitem_t *scene_item = items.array[i - 1];
-			item = create_move_item();
-
-			obs_sceneitem_addref(scene_item);
-			item->item_b = scene_item;
-
-			size_t insert = 0;
-			int order = obs_sceneitem_get_order_position(scene_item);
-			while (insert < move->items_b.num &&
-			       order > obs_sceneitem_get_order_position(move->items_b.array[insert]->item_b)) {
-				insert++;
-			}
-			da_insert(move->items_b, insert, &item);
-		}
-		da_free(items);
-		//add matched items to items_b
-		for (size_t i = 0; i < move->items_a.num; i++) {
-			struct move_item *item = move->items_a.array[i];
-			if (item->item_b) {
-				size_t insert = 0;
-				int order = obs_sceneitem_get_order_position(item->item_b);
-				while (insert < move->items_b.num &&
-				       order > obs_sceneitem_get_order_position(move->items_b.array[insert]->item_b)) {
-					insert++;
-				}
-				da_insert(move->items_b, insert, &item);
-			}
-		}
-		// insert not matched items from items_b into items_a
-		move->item_pos = 0;
-		for (size_t i = 0; i < move->items_b.num; i++) {
-			struct move_item *item = move->items_b.array[i];
-			if (item->item_b && !item->item_a) {
-				da_insert(move->items_a, move->item_pos, &item);
-				move->item_pos++;
-			} else {
-				for (size_t j = move->item_pos; j < move->items_a.num; j++) {
-					if (item == move->items_a.array[j]) {
-						move->item_pos = j + 1;
-						break;
-					}
-				}
-			}
-		}
+		move_match_scene_items(move, scene_b);
 	} else if (move->scene_source_b) {
 		const char *n = obs_source_get_name(move->scene_source_b);
 		obs_data_t *sd = obs_data_create();
@@ -3007,6 +2019,7 @@ static void move_start_init(struct move_info *move, bool in_graphics)
 			item->transition_name = bstrdup(move->transition_move);
 		}
 	}
+	MOVE_PERF_END(MOVE_PERF_MATCH, match_start);
 }
 
 static void move_video_tick(void *data, float seconds)
@@ -3020,6 +2033,7 @@ static void move_video_tick(void *data, float seconds)
 static void move_video_render(void *data, gs_effect_t *effect)
 {
 	struct move_info *move = data;
+	MOVE_PERF_BEGIN(render_start);
 
 	da_push_back(move_rendering, &move);
 
@@ -3068,6 +2082,7 @@ static void move_video_render(void *data, gs_effect_t *effect)
 	}
 
 	da_pop_back(move_rendering);
+	MOVE_PERF_END(MOVE_PERF_RENDER, render_start);
 
 	UNUSED_PARAMETER(effect);
 }
@@ -3110,28 +2125,6 @@ void prop_list_add_positions(obs_property_t *p)
 	obs_property_list_add_int(p, obs_module_text("Position.Bottom"), POS_SWIPE | POS_BOTTOM);
 }
 
-void prop_list_add_easings(obs_property_t *p)
-{
-	obs_property_list_add_int(p, obs_module_text("Easing.None"), EASE_NONE);
-	obs_property_list_add_int(p, obs_module_text("Easing.In"), EASE_IN);
-	obs_property_list_add_int(p, obs_module_text("Easing.Out"), EASE_OUT);
-	obs_property_list_add_int(p, obs_module_text("Easing.InOut"), EASE_IN_OUT);
-}
-
-void prop_list_add_easing_functions(obs_property_t *p)
-{
-	obs_property_list_add_int(p, obs_module_text("EasingFunction.Quadratic"), EASING_QUADRATIC);
-	obs_property_list_add_int(p, obs_module_text("EasingFunction.Cubic"), EASING_CUBIC);
-	obs_property_list_add_int(p, obs_module_text("EasingFunction.Quartic"), EASING_QUARTIC);
-	obs_property_list_add_int(p, obs_module_text("EasingFunction.Quintic"), EASING_QUINTIC);
-	obs_property_list_add_int(p, obs_module_text("EasingFunction.Sine"), EASING_SINE);
-	obs_property_list_add_int(p, obs_module_text("EasingFunction.Circular"), EASING_CIRCULAR);
-	obs_property_list_add_int(p, obs_module_text("EasingFunction.Exponential"), EASING_EXPONENTIAL);
-	obs_property_list_add_int(p, obs_module_text("EasingFunction.Elastic"), EASING_ELASTIC);
-	obs_property_list_add_int(p, obs_module_text("EasingFunction.Bounce"), EASING_BOUNCE);
-	obs_property_list_add_int(p, obs_module_text("EasingFunction.Back"), EASING_BACK);
-}
-
 void prop_list_add_transitions(obs_property_t *p)
 {
 	struct obs_frontend_source_list transitions = {0};
@@ -3344,6 +2337,20 @@ void SetMoveDirectShowFilter(struct obs_source_info *obs_source_info);
 
 extern DARRAY(struct udp_server) udp_servers;
 extern pthread_mutex_t udp_servers_mutex;
+extern void move_sources_load(void);
+extern void move_sources_unload(void);
+extern void move_scene_index_load(void);
+extern void move_scene_index_unload(void);
+extern void audio_move_load(void);
+extern void audio_move_unload(void);
+extern void move_action_load(void);
+extern void move_action_unload(void);
+extern void move_udp_output_load(void);
+extern void move_udp_output_unload(void);
+extern void move_filter_hotkeys_load(void);
+extern void move_filter_hotkeys_unload(void);
+extern void move_filter_hotkeys_defer(void);
+extern void move_filter_hotkeys_flush(void);
 
 static float move_get_transition_filter(obs_source_t *filter_from, obs_source_t **filter_to)
 {
@@ -3452,6 +2459,10 @@ void move_frontend_event(enum obs_frontend_event event, void* data) {
 	UNUSED_PARAMETER(data);
 	if (event == OBS_FRONTEND_EVENT_EXIT) {
 		move_exit = true;
+	} else if (event == OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGING) {
+		move_filter_hotkeys_defer();
+	} else if (event == OBS_FRONTEND_EVENT_FINISHED_LOADING || event == OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGED) {
+		move_filter_hotkeys_flush();
 	}
 }
 
@@ -3462,6 +2473,15 @@ bool obs_module_load(void)
 	da_init(move_rendering);
 	da_init(move_render_filter_ids);
 	pthread_mutex_init(&udp_servers_mutex, NULL);
+	move_filter_hotkeys_load();
+	move_sources_load();
+	move_scene_index_load();
+	audio_move_load();
+	move_action_load();
+	move_udp_output_load();
+#ifdef MOVE_PERF
+	move_perf_load();
+#endif
 	obs_register_source(&move_transition);
 	obs_register_source(&move_transition_override_filter);
 	obs_register_source(&move_source_filter);
@@ -3488,15 +2508,26 @@ bool obs_module_load(void)
 }
 
 obs_websocket_vendor vendor = NULL;
+extern void move_vendor_load(obs_websocket_vendor vendor);
 void obs_module_post_load()
 {
 	vendor = obs_websocket_register_vendor("move");
+	move_vendor_load(vendor);
 }
 
 void obs_module_unload()
 {
 	obs_frontend_remove_event_callback(move_frontend_event, NULL);
 	da_free(udp_servers);
+	move_filter_hotkeys_unload();
+	move_sources_unload();
+	move_scene_index_unload();
+	audio_move_unload();
+	move_action_unload();
+	move_udp_output_unload();
+#ifdef MOVE_PERF
+	move_perf_unload();
+#endif
 	da_free(move_rendering);
 	for (size_t i = 0; i < move_render_filter_ids.num; i++) {
 		bfree(move_render_filter_ids.array[i]);
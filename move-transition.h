@@ -3,6 +3,7 @@
 #include <obs-module.h>
 #include <util/darray.h>
 #include "version.h"
+#include "move-perf.h"
 
 #define MOVE_SOURCE_FILTER_ID "move_source_filter"
 #define MOVE_SOURCE_SWAP_FILTER_ID "move_source_swap_filter"
@@ -84,11 +85,15 @@
 #define S_SIMULTANEOUS_MOVE "simultaneous_move"
 #define S_NEXT_MOVE "next_move"
 #define S_NEXT_MOVE_ON "next_move_on"
+#define S_LOOP_MODE "loop_mode"
+#define S_LOOP_COUNT "loop_count"
 #define S_FILTER "filter"
 #define S_SINGLE_SETTING "single_setting"
 #define S_MOVE_VALUE_TYPE "move_value_type"
 #define S_SETTING_VALUE "setting_value"
 #define S_SETTING_RANDOM "setting_random"
+#define S_SETTING_RANDOM_SEED "setting_random_seed"
+#define S_SETTING_RANDOM_SEQUENCE "setting_random_sequence"
 #define S_SETTING_NAME "setting_name"
 #define S_SETTING_INT "setting_int"
 #define S_SETTING_INT_MIN "setting_int_min"
@@ -105,6 +110,7 @@
 #define S_SETTING_COLOR_ALPHA "setting_color_alpha"
 #define S_SETTING_COLOR_ALPHA_MIN "setting_color_alpha_min"
 #define S_SETTING_COLOR_ALPHA_MAX "setting_color_alpha_max"
+#define S_COLOR_SPACE "color_space"
 #define S_SETTING_TEXT "setting_text"
 #define S_SETTINGS "settings"
 #define S_SETTING_FROM "setting_from"
@@ -149,6 +155,8 @@
 #define EASING_BOUNCE 9
 #define EASING_BACK 10
 
+float get_eased(float f, long long easing, long long easing_function);
+
 #define POS_NONE 0
 #define POS_CENTER (1 << 0)
 #define POS_EDGE (1 << 1)
@@ -192,6 +200,14 @@
 #define NEXT_MOVE_ON_HOTKEY 1
 #define NEXT_MOVE_REVERSE "Reverse"
 
+#define LOOP_MODE_NONE 0
+#define LOOP_MODE_LOOP 1
+#define LOOP_MODE_PING_PONG 2
+
+#define MOVE_FILTER_ENABLED_PENDING_NONE 0
+#define MOVE_FILTER_ENABLED_PENDING_OFF 1
+#define MOVE_FILTER_ENABLED_PENDING_ON 2
+
 #define CHANGE_VISIBILITY_NONE 0
 #define CHANGE_VISIBILITY_SHOW_START 1
 #define CHANGE_VISIBILITY_HIDE_END 2
@@ -254,10 +270,15 @@ struct move_filter {
 	uint32_t start_trigger;
 	uint32_t stop_trigger;
 	bool moving;
-	float running_duration;
+	// ns the move has been running and the video frame time it was last advanced to
+	uint64_t running_duration;
+	uint64_t running_frame_time;
 	char *simultaneous_move_name;
 	char *next_move_name;
 	bool enabled;
+	bool enabled_checked;
+	// enable state reported by the enable signal, applied on the next tick
+	volatile long enabled_pending;
 
 	long long easing;
 	long long easing_function;
@@ -266,21 +287,39 @@ struct move_filter {
 
 	long long next_move_on;
 	bool reverse;
+	// direction the move was started in, ping-pong cycles flip reverse until the loop is done
+	bool loop_reverse;
+	long long loop_mode;
+	long long loop_count;
+	long long loops_done;
 	bool enabled_match_moving;
 	void (*move_start)(void *data);
+	// called when enabling or disabling the filter stopped the move
+	void (*enable_stopped)(void *data);
 	obs_source_t *(*get_alternative_filter)(void *data, const char *name);
+#ifdef MOVE_PERF
+	uint64_t udp_trigger_time;
+#endif
 };
 
 bool is_move_filter(const char *filter_id);
 void move_filter_init(struct move_filter *move_filter, obs_source_t *source, void (*move_start)(void *data));
 void move_filter_destroy(struct move_filter *move_filter);
 void move_filter_update(struct move_filter *move_filter, obs_data_t *settings);
+void move_filter_add(void *data, obs_source_t *parent);
+void move_filter_remove(void *data, obs_source_t *parent);
 void move_filter_start(struct move_filter *move_filter);
 bool move_filter_start_internal(struct move_filter *move_filter);
 void move_filter_stop(struct move_filter *move_filter);
+void move_filter_turn_around(struct move_filter *move_filter);
 void move_filter_ended(struct move_filter *move_filter);
 bool move_filter_tick(struct move_filter *move_filter, float seconds, float *t);
+float move_filter_progress(const struct move_filter *move_filter);
+uint64_t move_filter_remaining(const struct move_filter *move_filter);
+void move_filter_seek(struct move_filter *move_filter, float t);
+void move_filter_set_elapsed(struct move_filter *move_filter, uint64_t elapsed);
 void move_filter_properties(struct move_filter *move_filter, obs_properties_t *ppts);
+void move_filter_loop_properties(obs_properties_t *ppts);
 bool move_filter_start_trigger_changed(void *priv, obs_properties_t *props, obs_property_t *property, obs_data_t *settings);
 bool move_filter_stop_trigger_changed(void *priv, obs_properties_t *props, obs_property_t *property, obs_data_t *settings);
 void move_filter_defaults(obs_data_t *settings);
@@ -289,6 +328,39 @@ void move_filter_deactivate(void *data);
 void move_filter_show(void *data);
 void move_filter_hide(void *data);
 
+enum move_source_component {
+	MOVE_SOURCE_POS_X,
+	MOVE_SOURCE_POS_Y,
+	MOVE_SOURCE_ROT,
+	MOVE_SOURCE_SCALE_X,
+	MOVE_SOURCE_SCALE_Y,
+	MOVE_SOURCE_BOUNDS_X,
+	MOVE_SOURCE_BOUNDS_Y,
+	MOVE_SOURCE_CROP_LEFT,
+	MOVE_SOURCE_CROP_TOP,
+	MOVE_SOURCE_CROP_RIGHT,
+	MOVE_SOURCE_CROP_BOTTOM,
+	MOVE_SOURCE_COMPONENT_COUNT,
+};
+
+struct move_source_relative {
+	char sign[MOVE_SOURCE_COMPONENT_COUNT];
+	float value[MOVE_SOURCE_COMPONENT_COUNT];
+};
+
+void move_source_relative_load(struct move_source_relative *relative, obs_data_t *settings);
+int move_source_component_find(const char *setting_name);
+bool move_source_component_get(obs_data_t *settings, int component, double *value);
+void move_source_component_set(obs_data_t *settings, int component, double value);
+
+obs_sceneitem_t *move_scene_find_item(obs_scene_t *scene, const char *name);
+
+struct move_udp_target;
+struct move_udp_target *move_udp_target_get(const char *host, int port);
+void move_udp_target_release(struct move_udp_target *target);
+void move_udp_send(struct move_udp_target *target, const char *packet);
+void move_udp_flush(void);
+
 void prop_list_add_easings(obs_property_t *p);
 void prop_list_add_easing_functions(obs_property_t *p);
 void prop_list_add_move_source_filter(obs_source_t *parent, obs_source_t *child, void *data);
@@ -0,0 +1,294 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+#include "move-transition.h"
+#include <util/threading.h>
+#include <util/platform.h>
+#include <stdio.h>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <netdb.h>
+#define SOCKET int
+#define INVALID_SOCKET (-1)
+#define closesocket(s) close(s)
+#endif
+
+#define MOVE_UDP_RESOLVE_RETRY_NS 5000000000ULL
+#define MOVE_UDP_BATCH_MAX 64
+
+struct move_udp_target {
+	char *host;
+	int port;
+	long refs;
+
+	// only touched by the output thread
+	struct sockaddr_storage addr;
+	socklen_t addr_len;
+	bool resolved;
+	uint64_t resolve_time;
+};
+
+struct move_udp_packet {
+	struct move_udp_target *target;
+	char *data;
+	size_t size;
+};
+
+static DARRAY(struct move_udp_target *) move_udp_targets;
+static DARRAY(struct move_udp_packet) move_udp_packets;
+static pthread_mutex_t move_udp_mutex;
+static os_event_t *move_udp_event = NULL;
+static pthread_t move_udp_thread;
+static bool move_udp_thread_active = false;
+static volatile bool move_udp_stopping = false;
+static SOCKET move_udp_sockets[2] = {INVALID_SOCKET, INVALID_SOCKET};
+
+static void move_udp_target_free(struct move_udp_target *target)
+{
+	bfree(target->host);
+	bfree(target);
+}
+
+static void move_udp_target_release_locked(struct move_udp_target *target)
+{
+	if (--target->refs > 0)
+		return;
+	da_erase_item(move_udp_targets, &target);
+	move_udp_target_free(target);
+}
+
+static void move_udp_resolve(struct move_udp_target *target)
+{
+	const uint64_t now = os_gettime_ns();
+	if (target->resolved || (target->resolve_time && now - target->resolve_time < MOVE_UDP_RESOLVE_RETRY_NS))
+		return;
+	target->resolve_time = now;
+
+	char port[16];
+	snprintf(port, sizeof(port), "%d", target->port);
+	struct addrinfo hints;
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_DGRAM;
+	hints.ai_protocol = IPPROTO_UDP;
+	struct addrinfo *result = NULL;
+	if (getaddrinfo(target->host, port, &hints, &result) != 0 || !result) {
+		blog(LOG_WARNING, "[Move Transition] Error resolving udp host %s", target->host);
+		return;
+	}
+	for (struct addrinfo *ai = result; ai; ai = ai->ai_next) {
+		if ((ai->ai_family != AF_INET && ai->ai_family != AF_INET6) || ai->ai_addrlen > sizeof(target->addr))
+			continue;
+		memcpy(&target->addr, ai->ai_addr, ai->ai_addrlen);
+		target->addr_len = (socklen_t)ai->ai_addrlen;
+		target->resolved = true;
+		break;
+	}
+	freeaddrinfo(result);
+}
+
+static SOCKET move_udp_socket(int family)
+{
+	SOCKET *sockfd = &move_udp_sockets[family == AF_INET6 ? 1 : 0];
+	if (*sockfd != INVALID_SOCKET)
+		return *sockfd;
+	*sockfd = socket(family, SOCK_DGRAM, IPPROTO_UDP);
+	if (*sockfd == INVALID_SOCKET) {
+		blog(LOG_ERROR, "[Move Transition] Error creating udp socket");
+		return INVALID_SOCKET;
+	}
+#ifdef _WIN32
+	u_long mode = 1;
+	ioctlsocket(*sockfd, FIONBIO, &mode);
+#else
+	fcntl(*sockfd, F_SETFL, fcntl(*sockfd, F_GETFL, 0) | O_NONBLOCK);
+#endif
+	return *sockfd;
+}
+
+static void move_udp_send_family(struct move_udp_packet *packets, size_t count, int family)
+{
+	SOCKET sockfd = move_udp_socket(family);
+	if (sockfd == INVALID_SOCKET)
+		return;
+#ifdef __linux__
+	struct mmsghdr msgs[MOVE_UDP_BATCH_MAX];
+	struct iovec iovs[MOVE_UDP_BATCH_MAX];
+	size_t i = 0;
+	while (i < count) {
+		unsigned int n = 0;
+		for (; i < count && n < MOVE_UDP_BATCH_MAX; i++) {
+			struct move_udp_packet *packet = packets + i;
+			if (!packet->target->resolved || packet->target->addr.ss_family != family)
+				continue;
+			iovs[n].iov_base = packet->data;
+			iovs[n].iov_len = packet->size;
+			memset(&msgs[n], 0, sizeof(msgs[n]));
+			msgs[n].msg_hdr.msg_name = &packet->target->addr;
+			msgs[n].msg_hdr.msg_namelen = packet->target->addr_len;
+			msgs[n].msg_hdr.msg_iov = &iovs[n];
+			msgs[n].msg_hdr.msg_iovlen = 1;
+			n++;
+		}
+		unsigned int sent = 0;
+		while (sent < n) {
+			int r = sendmmsg(sockfd, msgs + sent, n - sent, 0);
+			if (r <= 0) {
+				if (errno != EAGAIN && errno != EWOULDBLOCK)
+					blog(LOG_WARNING, "[Move Transition] Error sending udp packet");
+				break;
+			}
+			sent += (unsigned int)r;
+		}
+	}
+#else
+	for (size_t i = 0; i < count; i++) {
+		struct move_udp_packet *packet = packets + i;
+		if (!packet->target->resolved || packet->target->addr.ss_family != family)
+			continue;
+		sendto(sockfd, packet->data, (int)packet->size, 0, (const struct sockaddr *)&packet->target->addr,
+		       packet->target->addr_len);
+	}
+#endif
+}
+
+static void *move_udp_output_thread(void *data)
+{
+	UNUSED_PARAMETER(data);
+	os_set_thread_name("move_udp_output_thread");
+	DARRAY(struct move_udp_target *) resolve;
+	DARRAY(struct move_udp_packet) packets;
+	da_init(resolve);
+	da_init(packets);
+	while (os_event_wait(move_udp_event) == 0 && !move_udp_stopping) {
+		pthread_mutex_lock(&move_udp_mutex);
+		for (size_t i = 0; i < move_udp_targets.num; i++) {
+			struct move_udp_target *target = move_udp_targets.array[i];
+			if (target->resolved)
+				continue;
+			target->refs++;
+			da_push_back(resolve, &target);
+		}
+		da_move(packets, move_udp_packets);
+		pthread_mutex_unlock(&move_udp_mutex);
+
+		// resolving can block, so it happens here and never on the thread firing the action
+		for (size_t i = 0; i < resolve.num; i++)
+			move_udp_resolve(resolve.array[i]);
+
+		move_udp_send_family(packets.array, packets.num, AF_INET);
+		move_udp_send_family(packets.array, packets.num, AF_INET6);
+
+		pthread_mutex_lock(&move_udp_mutex);
+		for (size_t i = 0; i < resolve.num; i++)
+			move_udp_target_release_locked(resolve.array[i]);
+		for (size_t i = 0; i < packets.num; i++)
+			move_udp_target_release_locked(packets.array[i].target);
+		pthread_mutex_unlock(&move_udp_mutex);
+		for (size_t i = 0; i < packets.num; i++)
+			bfree(packets.array[i].data);
+		resolve.num = 0;
+		packets.num = 0;
+	}
+	da_free(resolve);
+	da_free(packets);
+	for (size_t i = 0; i < 2; i++) {
+		if (move_udp_sockets[i] != INVALID_SOCKET) {
+			closesocket(move_udp_sockets[i]);
+			move_udp_sockets[i] = INVALID_SOCKET;
+		}
+	}
+	return NULL;
+}
+
+struct move_udp_target *move_udp_target_get(const char *host, int port)
+{
+	if (!host || !*host)
+		host = "127.0.0.1";
+	if (!port)
+		port = 3000;
+	pthread_mutex_lock(&move_udp_mutex);
+	for (size_t i = 0; i < move_udp_targets.num; i++) {
+		struct move_udp_target *target = move_udp_targets.array[i];
+		if (target->port == port && strcmp(target->host, host) == 0) {
+			target->refs++;
+			pthread_mutex_unlock(&move_udp_mutex);
+			return target;
+		}
+	}
+	struct move_udp_target *target = bzalloc(sizeof(struct move_udp_target));
+	target->host = bstrdup(host);
+	target->port = port;
+	target->refs = 1;
+	da_push_back(move_udp_targets, &target);
+	if (!move_udp_thread_active)
+		move_udp_thread_active = pthread_create(&move_udp_thread, NULL, move_udp_output_thread, NULL) == 0;
+	pthread_mutex_unlock(&move_udp_mutex);
+	// resolve in the background right away so the first packet does not wait for it
+	os_event_signal(move_udp_event);
+	return target;
+}
+
+void move_udp_target_release(struct move_udp_target *target)
+{
+	if (!target)
+		return;
+	pthread_mutex_lock(&move_udp_mutex);
+	move_udp_target_release_locked(target);
+	pthread_mutex_unlock(&move_udp_mutex);
+}
+
+void move_udp_send(struct move_udp_target *target, const char *packet)
+{
+	if (!target || !packet)
+		return;
+	struct move_udp_packet p;
+	p.target = target;
+	p.size = strlen(packet);
+	p.data = bmemdup(packet, p.size);
+	pthread_mutex_lock(&move_udp_mutex);
+	target->refs++;
+	da_push_back(move_udp_packets, &p);
+	pthread_mutex_unlock(&move_udp_mutex);
+}
+
+void move_udp_flush(void)
+{
+	os_event_signal(move_udp_event);
+}
+
+void move_udp_output_load(void)
+{
+	da_init(move_udp_targets);
+	da_init(move_udp_packets);
+	pthread_mutex_init(&move_udp_mutex, NULL);
+	os_event_init(&move_udp_event, OS_EVENT_TYPE_AUTO);
+}
+
+void move_udp_output_unload(void)
+{
+	if (move_udp_thread_active) {
+		move_udp_stopping = true;
+		os_event_signal(move_udp_event);
+		pthread_join(move_udp_thread, NULL);
+		move_udp_thread_active = false;
+	}
+	for (size_t i = 0; i < move_udp_packets.num; i++)
+		bfree(move_udp_packets.array[i].data);
+	da_free(move_udp_packets);
+	for (size_t i = 0; i < move_udp_targets.num; i++)
+		move_udp_target_free(move_udp_targets.array[i]);
+	da_free(move_udp_targets);
+	os_event_destroy(move_udp_event);
+	move_udp_event = NULL;
+	pthread_mutex_destroy(&move_udp_mutex);
+}
@@ -1,11 +1,16 @@
 #include "move-transition.h"
+#include "move-color.h"
+#include "graphics/math-defs.h"
 #include <obs-module.h>
 #include <float.h>
+#include <limits.h>
 #include <stdio.h>
 #include <time.h>
 #include <util/dstr.h>
 #include <obs-frontend-api.h>
 #include <util/platform.h>
+#include <util/threading.h>
+#include <util/uthash.h>
 
 #define TEXT_BUFFER_SIZE 256
 #define VOLUME_SETTING "source_volume"
@@ -18,12 +23,44 @@
 #define BALANCE_MAX 100.0
 #define BALANCE_STEP 1.0
 
+#define COLOR_RAMP_SIZE 256
+#define RANDOM_BAG_SIZE 16
+
+struct move_value_schema_prop;
+
+/* property layout of the settings target, rebuilt when the target, its settings or the filter settings change */
+struct move_value_schema {
+	obs_weak_source_t *source;
+	// set by the update signal of the target, its properties can depend on its settings
+	volatile bool dirty;
+	DARRAY(struct move_value_schema_prop *) props;
+	struct move_value_schema_prop *props_by_name;
+};
+
+struct move_value_rng {
+	uint64_t s[4];
+	uint32_t bag[RANDOM_BAG_SIZE];
+	uint32_t bag_size;
+	uint32_t bag_pos;
+	uint32_t bag_last;
+};
+
+struct move_value_target {
+	char *setting_name;
+	long long value_type;
+	size_t lane;
+	struct vec4 *ramp;
+	// the space the ramp was built in, update can change color_space while it is in use
+	long long ramp_space;
+};
+
 struct move_value_info {
 	struct move_filter move_filter;
 
 	obs_weak_source_t *filter;
 	char *setting_filter_name;
 	char *setting_name;
+	int setting_component;
 
 	long long int_to;
 	long long int_value;
@@ -43,6 +80,9 @@ struct move_value_info {
 	struct vec4 color_from;
 	struct vec4 color_min;
 	struct vec4 color_max;
+	struct vec4 *color_ramp;
+	long long color_ramp_space;
+	long long color_space;
 
 	wchar_t *text_from;
 	size_t text_from_len;
@@ -53,6 +93,18 @@ struct move_value_info {
 	size_t text_steps;
 
 	obs_data_array_t *settings;
+	struct move_value_schema schema;
+	// the schema, targets and lanes are rebuilt on the UI thread or at a start under lanes_mutex, which the tick holds
+	pthread_mutex_t lanes_mutex;
+	DARRAY(struct move_value_target) targets;
+	DARRAY(double) lanes_from;
+	DARRAY(double) lanes_to;
+	DARRAY(double) lanes;
+
+	struct move_value_rng rng;
+	bool rng_seeded;
+	long long random_seed;
+	bool random_sequence;
 
 	long long move_value_type;
 	long long value_type;
@@ -60,8 +112,136 @@ struct move_value_info {
 	char *format;
 };
 
-static void load_move_source_setting(obs_data_array_t *array, obs_data_t *settings_to, obs_data_t *settings_from,
-				     const char *obj_name, const char *var_name, const char *setting_name, bool is_float)
+struct move_value_schema_prop {
+	char *name;
+	enum obs_property_type type;
+	UT_hash_handle hh;
+};
+
+struct move_value_slot {
+	const char *name;
+	obs_data_t *setting;
+	UT_hash_handle hh;
+};
+
+static void move_value_schema_target_update(void *data, calldata_t *call_data)
+{
+	UNUSED_PARAMETER(call_data);
+	struct move_value_schema *schema = data;
+	os_atomic_set_bool(&schema->dirty, true);
+}
+
+static void move_value_schema_clear(struct move_value_schema *schema)
+{
+	struct move_value_schema_prop *prop, *tmp;
+	HASH_ITER (hh, schema->props_by_name, prop, tmp) {
+		HASH_DEL(schema->props_by_name, prop);
+		bfree(prop->name);
+		bfree(prop);
+	}
+	schema->props.num = 0;
+	obs_source_t *source = obs_weak_source_get_source(schema->source);
+	if (source) {
+		signal_handler_disconnect(obs_source_get_signal_handler(source), "update", move_value_schema_target_update, schema);
+		obs_source_release(source);
+	}
+	obs_weak_source_release(schema->source);
+	schema->source = NULL;
+}
+
+static void move_value_schema_add(struct move_value_schema *schema, obs_properties_t *props, bool visible)
+{
+	obs_property_t *prop = obs_properties_first(props);
+	for (; prop != NULL; obs_property_next(&prop)) {
+		const char *name = obs_property_name(prop);
+		const enum obs_property_type prop_type = obs_property_get_type(prop);
+		const bool prop_visible = visible && obs_property_visible(prop);
+		struct move_value_schema_prop *item;
+		HASH_FIND_STR(schema->props_by_name, name, item);
+		if (!item) {
+			item = bzalloc(sizeof(struct move_value_schema_prop));
+			item->name = bstrdup(name);
+			item->type = prop_type;
+			HASH_ADD_KEYPTR(hh, schema->props_by_name, item->name, strlen(item->name), item);
+			if (prop_visible && (prop_type == OBS_PROPERTY_INT || prop_type == OBS_PROPERTY_FLOAT ||
+					     prop_type == OBS_PROPERTY_COLOR || prop_type == OBS_PROPERTY_COLOR_ALPHA))
+				da_push_back(schema->props, &item);
+		}
+		if (prop_type == OBS_PROPERTY_GROUP)
+			move_value_schema_add(schema, obs_property_group_content(prop), prop_visible);
+	}
+}
+
+static void move_value_schema_load(struct move_value_schema *schema, obs_source_t *source)
+{
+	if (schema->source && !os_atomic_load_bool(&schema->dirty) && obs_weak_source_references_source(schema->source, source))
+		return;
+	move_value_schema_clear(schema);
+	schema->source = obs_source_get_weak_source(source);
+	os_atomic_set_bool(&schema->dirty, false);
+	signal_handler_connect(obs_source_get_signal_handler(source), "update", move_value_schema_target_update, schema);
+	obs_properties_t *sps = obs_source_properties(source);
+	if (!sps)
+		return;
+	move_value_schema_add(schema, sps, true);
+	obs_properties_destroy(sps);
+}
+
+static bool move_value_schema_has(struct move_value_schema *schema, const char *name)
+{
+	struct move_value_schema_prop *prop;
+	HASH_FIND_STR(schema->props_by_name, name, prop);
+	return prop != NULL;
+}
+
+static void move_value_slots_init(struct move_value_slot **slots, obs_data_array_t *array)
+{
+	const size_t count = obs_data_array_count(array);
+	for (size_t i = 0; i < count; i++) {
+		obs_data_t *setting = obs_data_array_item(array, i);
+		const char *name = obs_data_get_string(setting, S_SETTING_NAME);
+		struct move_value_slot *slot;
+		HASH_FIND_STR(*slots, name, slot);
+		if (slot) {
+			HASH_DEL(*slots, slot);
+			obs_data_release(slot->setting);
+		} else {
+			slot = bzalloc(sizeof(struct move_value_slot));
+		}
+		slot->name = name;
+		slot->setting = setting;
+		HASH_ADD_KEYPTR(hh, *slots, slot->name, strlen(slot->name), slot);
+	}
+}
+
+static void move_value_slots_free(struct move_value_slot **slots)
+{
+	struct move_value_slot *slot, *tmp;
+	HASH_ITER (hh, *slots, slot, tmp) {
+		HASH_DEL(*slots, slot);
+		obs_data_release(slot->setting);
+		bfree(slot);
+	}
+}
+
+static obs_data_t *move_value_slot_get(struct move_value_slot **slots, obs_data_array_t *array, const char *name)
+{
+	struct move_value_slot *slot;
+	HASH_FIND_STR(*slots, name, slot);
+	if (slot)
+		return slot->setting;
+	slot = bzalloc(sizeof(struct move_value_slot));
+	slot->setting = obs_data_create();
+	obs_data_set_string(slot->setting, S_SETTING_NAME, name);
+	obs_data_array_push_back(array, slot->setting);
+	slot->name = obs_data_get_string(slot->setting, S_SETTING_NAME);
+	HASH_ADD_KEYPTR(hh, *slots, slot->name, strlen(slot->name), slot);
+	return slot->setting;
+}
+
+static void load_move_source_setting(struct move_value_slot **slots, obs_data_array_t *array, obs_data_t *settings_to,
+				     obs_data_t *settings_from, const char *obj_name, const char *var_name,
+				     const char *setting_name, bool is_float)
 {
 
 	obs_data_t *obj = NULL;
@@ -71,21 +251,7 @@ static void load_move_source_setting(obs_data_array_t *array, obs_data_t *settin
 		obs_data_addref(settings_from);
 		obj = settings_from;
 	}
-	obs_data_t *setting = NULL;
-	const size_t count = obs_data_array_count(array);
-	for (size_t i = 0; i < count; i++) {
-		obs_data_t *item2 = obs_data_array_item(array, i);
-		const char *setting_name2 = obs_data_get_string(item2, S_SETTING_NAME);
-		if (strcmp(setting_name2, setting_name) == 0) {
-			setting = item2;
-		}
-		obs_data_release(item2);
-	}
-	if (!setting) {
-		setting = obs_data_create();
-		obs_data_set_string(setting, S_SETTING_NAME, setting_name);
-		obs_data_array_push_back(array, setting);
-	}
+	obs_data_t *setting = move_value_slot_get(slots, array, setting_name);
 	if (is_float) {
 		obs_data_set_int(setting, S_VALUE_TYPE, MOVE_VALUE_FLOAT);
 		const double to = obs_data_get_double(settings_to, setting_name);
@@ -103,51 +269,30 @@ static void load_move_source_setting(obs_data_array_t *array, obs_data_t *settin
 	obs_data_release(obj);
 }
 
-static void load_move_source_properties(obs_data_array_t *array, obs_data_t *settings_to, obs_data_t *settings_from)
+static void load_move_source_properties(struct move_value_slot **slots, obs_data_array_t *array, obs_data_t *settings_to,
+					obs_data_t *settings_from)
 {
-	load_move_source_setting(array, settings_to, settings_from, "pos", "x", "pos.x", true);
-	load_move_source_setting(array, settings_to, settings_from, "pos", "y", "pos.y", true);
-	load_move_source_setting(array, settings_to, settings_from, "scale", "x", "scale.x", true);
-	load_move_source_setting(array, settings_to, settings_from, "scale", "y", "scale.y", true);
-	load_move_source_setting(array, settings_to, settings_from, "bounds", "x", "bounds.x", true);
-	load_move_source_setting(array, settings_to, settings_from, "bounds", "y", "bounds.y", true);
-	load_move_source_setting(array, settings_to, settings_from, "crop", "left", "crop.left", false);
-	load_move_source_setting(array, settings_to, settings_from, "crop", "top", "crop.top", false);
-	load_move_source_setting(array, settings_to, settings_from, "crop", "right", "crop.right", false);
-	load_move_source_setting(array, settings_to, settings_from, "crop", "bottom", "crop.bottom", false);
-	load_move_source_setting(array, settings_to, settings_from, NULL, "rot", "rot", true);
+	load_move_source_setting(slots, array, settings_to, settings_from, "pos", "x", "pos.x", true);
+	load_move_source_setting(slots, array, settings_to, settings_from, "pos", "y", "pos.y", true);
+	load_move_source_setting(slots, array, settings_to, settings_from, "scale", "x", "scale.x", true);
+	load_move_source_setting(slots, array, settings_to, settings_from, "scale", "y", "scale.y", true);
+	load_move_source_setting(slots, array, settings_to, settings_from, "bounds", "x", "bounds.x", true);
+	load_move_source_setting(slots, array, settings_to, settings_from, "bounds", "y", "bounds.y", true);
+	load_move_source_setting(slots, array, settings_to, settings_from, "crop", "left", "crop.left", false);
+	load_move_source_setting(slots, array, settings_to, settings_from, "crop", "top", "crop.top", false);
+	load_move_source_setting(slots, array, settings_to, settings_from, "crop", "right", "crop.right", false);
+	load_move_source_setting(slots, array, settings_to, settings_from, "crop", "bottom", "crop.bottom", false);
+	load_move_source_setting(slots, array, settings_to, settings_from, NULL, "rot", "rot", true);
 }
 
-static void load_properties(obs_properties_t *props_from, obs_data_array_t *array, obs_data_t *settings_to,
-			    obs_data_t *settings_from)
+static void load_properties(struct move_value_schema *schema, struct move_value_slot **slots, obs_data_array_t *array,
+			    obs_data_t *settings_to, obs_data_t *settings_from)
 {
-	obs_property_t *prop_from = obs_properties_first(props_from);
-	for (; prop_from != NULL; obs_property_next(&prop_from)) {
-		const char *name = obs_property_name(prop_from);
-		if (!obs_property_visible(prop_from))
-			continue;
-
-		obs_data_t *setting = NULL;
-		const size_t count = obs_data_array_count(array);
-		for (size_t i = 0; i < count; i++) {
-			obs_data_t *item2 = obs_data_array_item(array, i);
-			const char *setting_name2 = obs_data_get_string(item2, S_SETTING_NAME);
-			if (strcmp(setting_name2, name) == 0) {
-				setting = item2;
-				obs_data_addref(setting);
-			}
-			obs_data_release(item2);
-		}
-
-		const enum obs_property_type prop_type = obs_property_get_type(prop_from);
-		if (prop_type == OBS_PROPERTY_GROUP) {
-			load_properties(obs_property_group_content(prop_from), array, settings_to, settings_from);
-		} else if (prop_type == OBS_PROPERTY_INT) {
-			if (!setting) {
-				setting = obs_data_create();
-				obs_data_set_string(setting, S_SETTING_NAME, name);
-				obs_data_array_push_back(array, setting);
-			}
+	for (size_t i = 0; i < schema->props.num; i++) {
+		const char *name = schema->props.array[i]->name;
+		const enum obs_property_type prop_type = schema->props.array[i]->type;
+		obs_data_t *setting = move_value_slot_get(slots, array, name);
+		if (prop_type == OBS_PROPERTY_INT) {
 			obs_data_set_int(setting, S_VALUE_TYPE, MOVE_VALUE_INT);
 			if (obs_data_has_default_value(settings_from, name))
 				obs_data_set_default_int(settings_to, name, obs_data_get_default_int(settings_from, name));
@@ -156,11 +301,6 @@ static void load_properties(obs_properties_t *props_from, obs_data_array_t *arra
 			const long long from = obs_data_get_int(settings_from, name);
 			obs_data_set_int(setting, S_SETTING_FROM, from);
 		} else if (prop_type == OBS_PROPERTY_FLOAT) {
-			if (!setting) {
-				setting = obs_data_create();
-				obs_data_set_string(setting, S_SETTING_NAME, name);
-				obs_data_array_push_back(array, setting);
-			}
 			obs_data_set_int(setting, S_VALUE_TYPE, MOVE_VALUE_FLOAT);
 			if (obs_data_has_default_value(settings_from, name))
 				obs_data_set_default_double(settings_to, name, obs_data_get_default_double(settings_from, name));
@@ -168,12 +308,7 @@ static void load_properties(obs_properties_t *props_from, obs_data_array_t *arra
 			obs_data_set_double(setting, S_SETTING_TO, to);
 			const double from = obs_data_get_double(settings_from, name);
 			obs_data_set_double(setting, S_SETTING_FROM, from);
-		} else if (prop_type == OBS_PROPERTY_COLOR || prop_type == OBS_PROPERTY_COLOR_ALPHA) {
-			if (!setting) {
-				setting = obs_data_create();
-				obs_data_set_string(setting, S_SETTING_NAME, name);
-				obs_data_array_push_back(array, setting);
-			}
+		} else {
 			obs_data_set_int(setting, S_VALUE_TYPE,
 					 prop_type == OBS_PROPERTY_COLOR ? MOVE_VALUE_COLOR : MOVE_VALUE_COLOR_ALPHA);
 			if (obs_data_has_default_value(settings_from, name))
@@ -182,56 +317,288 @@ static void load_properties(obs_properties_t *props_from, obs_data_array_t *arra
 			const long long from = obs_data_get_int(settings_from, name);
 			obs_data_set_int(setting, S_SETTING_FROM, from);
 		}
-		if (setting) {
-			obs_data_release(setting);
+	}
+}
+
+static void move_values_load_settings(struct move_value_info *move_value, obs_source_t *source, obs_data_t *settings_to,
+				      obs_data_t *settings_from)
+{
+	struct move_value_slot *slots = NULL;
+	move_value_slots_init(&slots, move_value->settings);
+	const char *source_id = obs_source_get_unversioned_id(source);
+	if (source_id && strcmp(source_id, MOVE_SOURCE_FILTER_ID) == 0) {
+		load_move_source_properties(&slots, move_value->settings, settings_to, settings_from);
+	}
+	load_properties(&move_value->schema, &slots, move_value->settings, settings_to, settings_from);
+	move_value_slots_free(&slots);
+}
+
+static struct vec4 *color_ramp_build(struct vec4 *ramp, const struct vec4 *from, const struct vec4 *to, long long color_space)
+{
+	if (color_space != MOVE_VALUE_COLOR_SPACE_OKLAB && color_space != MOVE_VALUE_COLOR_SPACE_OKLCH) {
+		bfree(ramp);
+		return NULL;
+	}
+	if (!ramp)
+		ramp = bmalloc(sizeof(struct vec4) * COLOR_RAMP_SIZE);
+	for (size_t i = 0; i < COLOR_RAMP_SIZE; i++)
+		color_mix(&ramp[i], from, to, (float)i / (float)(COLOR_RAMP_SIZE - 1), color_space);
+	return ramp;
+}
+
+static void color_ramp_get(struct vec4 *dst, const struct vec4 *ramp, const struct vec4 *from, const struct vec4 *to, float t,
+			   long long color_space)
+{
+	if (!ramp || t < 0.0f || t > 1.0f) {
+		color_mix(dst, from, to, t, color_space);
+		return;
+	}
+	const float f = t * (float)(COLOR_RAMP_SIZE - 1);
+	size_t i = (size_t)f;
+	if (i >= COLOR_RAMP_SIZE - 1)
+		i = COLOR_RAMP_SIZE - 2;
+	color_mix(dst, &ramp[i], &ramp[i + 1], f - (float)i, MOVE_VALUE_COLOR_SPACE_LINEAR);
+}
+
+static void move_values_free_targets(struct move_value_target *targets, size_t num)
+{
+	for (size_t i = 0; i < num; i++) {
+		bfree(targets[i].setting_name);
+		bfree(targets[i].ramp);
+	}
+}
+
+static void move_values_clear_lanes(struct move_value_info *move_value)
+{
+	pthread_mutex_lock(&move_value->lanes_mutex);
+	move_values_free_targets(move_value->targets.array, move_value->targets.num);
+	move_value->targets.num = 0;
+	move_value->lanes_from.num = 0;
+	move_value->lanes_to.num = 0;
+	move_value->lanes.num = 0;
+	pthread_mutex_unlock(&move_value->lanes_mutex);
+}
+
+static void move_values_build_lanes(struct move_value_info *move_value)
+{
+	DARRAY(struct move_value_target) targets;
+	DARRAY(double) lanes_from;
+	DARRAY(double) lanes_to;
+	DARRAY(double) lanes;
+	da_init(targets);
+	da_init(lanes_from);
+	da_init(lanes_to);
+	da_init(lanes);
+	const size_t count = obs_data_array_count(move_value->settings);
+	for (size_t i = 0; i < count; i++) {
+		obs_data_t *item = obs_data_array_item(move_value->settings, i);
+		const long long value_type = obs_data_get_int(item, S_VALUE_TYPE);
+		if (value_type != MOVE_VALUE_INT && value_type != MOVE_VALUE_FLOAT && value_type != MOVE_VALUE_COLOR &&
+		    value_type != MOVE_VALUE_COLOR_ALPHA) {
+			obs_data_release(item);
+			continue;
+		}
+		struct move_value_target *target = da_push_back_new(targets);
+		target->setting_name = bstrdup(obs_data_get_string(item, S_SETTING_NAME));
+		target->value_type = value_type;
+		target->lane = lanes_from.num;
+		target->ramp = NULL;
+		target->ramp_space = move_value->color_space;
+		if (value_type == MOVE_VALUE_INT || value_type == MOVE_VALUE_FLOAT) {
+			double from, to;
+			if (value_type == MOVE_VALUE_INT) {
+				from = (double)obs_data_get_int(item, S_SETTING_FROM);
+				to = (double)obs_data_get_int(item, S_SETTING_TO);
+			} else {
+				from = obs_data_get_double(item, S_SETTING_FROM);
+				to = obs_data_get_double(item, S_SETTING_TO);
+			}
+			da_push_back(lanes_from, &from);
+			da_push_back(lanes_to, &to);
+		} else {
+			struct vec4 color_from;
+			vec4_from_rgba(&color_from, (uint32_t)obs_data_get_int(item, S_SETTING_FROM));
+			gs_float3_srgb_nonlinear_to_linear(color_from.ptr);
+			struct vec4 color_to;
+			vec4_from_rgba(&color_to, (uint32_t)obs_data_get_int(item, S_SETTING_TO));
+			gs_float3_srgb_nonlinear_to_linear(color_to.ptr);
+			target->ramp = color_ramp_build(NULL, &color_from, &color_to, target->ramp_space);
+			for (size_t j = 0; j < 4; j++) {
+				const double from = color_from.ptr[j];
+				const double to = color_to.ptr[j];
+				da_push_back(lanes_from, &from);
+				da_push_back(lanes_to, &to);
+			}
 		}
+		obs_data_release(item);
 	}
+	da_resize(lanes, lanes_from.num);
+
+	pthread_mutex_lock(&move_value->lanes_mutex);
+	move_values_free_targets(move_value->targets.array, move_value->targets.num);
+	da_move(move_value->targets, targets);
+	da_move(move_value->lanes_from, lanes_from);
+	da_move(move_value->lanes_to, lanes_to);
+	da_move(move_value->lanes, lanes);
+	pthread_mutex_unlock(&move_value->lanes_mutex);
+}
+
+static void move_values_lerp(double *dst, const double *from, const double *to, size_t count, double t)
+{
+	for (size_t i = 0; i < count; i++)
+		dst[i] = (1.0 - t) * from[i] + t * to[i];
 }
 
 void move_values_load_properties(struct move_value_info *move_value, obs_source_t *source, obs_data_t *settings)
 {
 	if (source && source != move_value->move_filter.source) {
-		obs_properties_t *sps = obs_source_properties(source);
+		// the schema is loaded from the UI thread and from starts, which can come from the tick
+		pthread_mutex_lock(&move_value->lanes_mutex);
+		move_value_schema_load(&move_value->schema, source);
 		size_t index = 0;
 		while (index < obs_data_array_count(move_value->settings)) {
 			obs_data_t *item = obs_data_array_item(move_value->settings, index);
 			const char *setting_name = obs_data_get_string(item, S_SETTING_NAME);
+			const bool found = move_value_schema_has(&move_value->schema, setting_name);
 			obs_data_release(item);
-			if (obs_properties_get(sps, setting_name) == NULL) {
+			if (!found) {
 				obs_data_array_erase(move_value->settings, index);
 			} else {
 				index++;
 			}
 		}
 		obs_data_t *data_from = obs_source_get_settings(source);
-		const char *source_id = obs_source_get_unversioned_id(source);
-		if (source_id && strcmp(source_id, MOVE_SOURCE_FILTER_ID) == 0) {
-			load_move_source_properties(move_value->settings, settings, data_from);
-		}
-		load_properties(sps, move_value->settings, settings, data_from);
+		move_values_load_settings(move_value, source, settings, data_from);
 		obs_data_release(data_from);
-		obs_properties_destroy(sps);
+		pthread_mutex_unlock(&move_value->lanes_mutex);
 	} else {
 		while (obs_data_array_count(move_value->settings)) {
 			obs_data_array_erase(move_value->settings, 0);
 		}
 	}
+	move_values_build_lanes(move_value);
 }
 
-long long rand_between(long long a, long long b)
+static uint64_t splitmix64(uint64_t *x)
+{
+	uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return z ^ (z >> 31);
+}
+
+static inline uint64_t rotl64(const uint64_t x, int k)
+{
+	return (x << k) | (x >> (64 - k));
+}
+
+static void rng_seed(struct move_value_rng *rng, uint64_t seed)
+{
+	for (size_t i = 0; i < 4; i++)
+		rng->s[i] = splitmix64(&seed);
+	rng->bag_size = 0;
+	rng->bag_pos = 0;
+}
+
+// xoshiro256**
+static uint64_t rng_next(struct move_value_rng *rng)
+{
+	const uint64_t result = rotl64(rng->s[1] * 5, 7) * 9;
+	const uint64_t t = rng->s[1] << 17;
+	rng->s[2] ^= rng->s[0];
+	rng->s[3] ^= rng->s[1];
+	rng->s[1] ^= rng->s[2];
+	rng->s[0] ^= rng->s[3];
+	rng->s[2] ^= t;
+	rng->s[3] = rotl64(rng->s[3], 45);
+	return result;
+}
+
+static double rng_double(struct move_value_rng *rng)
+{
+	return (double)(rng_next(rng) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// multiply-shift with rejection of the low products that would favour some results
+static uint32_t rng_below(struct move_value_rng *rng, uint32_t n)
+{
+	uint64_t m = (rng_next(rng) >> 32) * (uint64_t)n;
+	if ((uint32_t)m < n) {
+		const uint32_t threshold = (0u - n) % n;
+		while ((uint32_t)m < threshold)
+			m = (rng_next(rng) >> 32) * (uint64_t)n;
+	}
+	return (uint32_t)(m >> 32);
+}
+
+// rejects the top values that do not fill a whole range, so every result is equally likely
+static uint64_t rng_range(struct move_value_rng *rng, uint64_t range)
+{
+	const uint64_t threshold = (0 - range) % range;
+	uint64_t r = rng_next(rng);
+	while (r < threshold)
+		r = rng_next(rng);
+	return r % range;
+}
+
+// draws every slot of the bag once before refilling, and never the same slot twice in a row
+static uint32_t rng_bag_next(struct move_value_rng *rng, uint32_t size)
+{
+	if (rng->bag_size != size || rng->bag_pos >= rng->bag_size) {
+		for (uint32_t i = 0; i < size; i++)
+			rng->bag[i] = i;
+		for (uint32_t i = size - 1; i > 0; i--) {
+			const uint32_t j = rng_below(rng, i + 1);
+			const uint32_t tmp = rng->bag[i];
+			rng->bag[i] = rng->bag[j];
+			rng->bag[j] = tmp;
+		}
+		if (size > 1 && rng->bag_size == size && rng->bag[0] == rng->bag_last) {
+			const uint32_t j = 1 + rng_below(rng, size - 1);
+			rng->bag[0] = rng->bag[j];
+			rng->bag[j] = rng->bag_last;
+		}
+		rng->bag_size = size;
+		rng->bag_pos = 0;
+	}
+	rng->bag_last = rng->bag[rng->bag_pos++];
+	return rng->bag_last;
+}
+
+// with a random sequence the value lands in a bag slot that was not drawn recently
+static double rand_unit(struct move_value_info *move_value)
+{
+	if (!move_value->random_sequence)
+		return rng_double(&move_value->rng);
+	return ((double)rng_bag_next(&move_value->rng, RANDOM_BAG_SIZE) + rng_double(&move_value->rng)) / (double)RANDOM_BAG_SIZE;
+}
+
+static long long rand_between(struct move_value_info *move_value, long long a, long long b)
 {
 	if (a == b)
 		return a;
-	return b > a ? a + rand() % (b - a) : b + rand() % (a - b);
+	const long long min = b > a ? a : b;
+	const uint64_t range = b > a ? (uint64_t)(b - a) : (uint64_t)(a - b);
+	if (!move_value->random_sequence)
+		return min + (long long)rng_range(&move_value->rng, range);
+	if (range <= RANDOM_BAG_SIZE)
+		return min + (long long)rng_bag_next(&move_value->rng, (uint32_t)range);
+	return min + (long long)(rand_unit(move_value) * (double)range);
 }
 
-float rand_between_float(float a, float b)
+static double rand_between_double(struct move_value_info *move_value, double a, double b)
 {
-	return b > a ? a + (b - a) * (float)rand() / (float)RAND_MAX : b + (a - b) * (float)rand() / (float)RAND_MAX;
+	const double f = rand_unit(move_value);
+	return b > a ? a + (b - a) * f : b + (a - b) * f;
 }
-double rand_between_double(double a, double b)
+
+// with a random sequence the components draw their slots from the same bag
+static void rand_between_floats(struct move_value_info *move_value, float *dst, const float *a, const float *b, size_t count)
 {
-	return b > a ? a + (b - a) * (double)rand() / (double)RAND_MAX : b + (a - b) * (double)rand() / (double)RAND_MAX;
+	for (size_t i = 0; i < count; i++) {
+		const float f = (float)rand_unit(move_value);
+		dst[i] = b[i] > a[i] ? a[i] + (b[i] - a[i]) * f : b[i] + (a[i] - b[i]) * f;
+	}
 }
 
 double parse_text(long long format_type, const char *format, const char *text)
@@ -323,7 +690,7 @@ void move_value_start(struct move_value_info *move_value)
 		}
 
 		if (move_value->move_value_type == MOVE_VALUE_TYPE_RANDOM) {
-			move_value->int_to = rand_between(move_value->int_min, move_value->int_max);
+			move_value->int_to = rand_between(move_value, move_value->int_min, move_value->int_max);
 		} else if (move_value->move_value_type == MOVE_VALUE_TYPE_SETTING_ADD) {
 			move_value->int_to = move_value->int_from + move_value->int_value;
 		} else {
@@ -338,7 +705,7 @@ void move_value_start(struct move_value_info *move_value)
 			move_value->double_from = obs_data_get_double(ss, move_value->setting_name);
 		}
 		if (move_value->move_value_type == MOVE_VALUE_TYPE_RANDOM) {
-			move_value->double_to = rand_between_double(move_value->double_min, move_value->double_max);
+			move_value->double_to = rand_between_double(move_value, move_value->double_min, move_value->double_max);
 		} else if (move_value->move_value_type == MOVE_VALUE_TYPE_SETTING_ADD) {
 			move_value->double_to = move_value->double_from + move_value->double_value;
 		} else {
@@ -348,10 +715,8 @@ void move_value_start(struct move_value_info *move_value)
 		vec4_from_rgba(&move_value->color_from, (uint32_t)obs_data_get_int(ss, move_value->setting_name));
 		gs_float3_srgb_nonlinear_to_linear(move_value->color_from.ptr);
 		if (move_value->move_value_type == MOVE_VALUE_TYPE_RANDOM) {
-			move_value->color_to.w = rand_between_float(move_value->color_min.w, move_value->color_max.w);
-			move_value->color_to.x = rand_between_float(move_value->color_min.x, move_value->color_max.x);
-			move_value->color_to.y = rand_between_float(move_value->color_min.y, move_value->color_max.y);
-			move_value->color_to.z = rand_between_float(move_value->color_min.z, move_value->color_max.z);
+			rand_between_floats(move_value, move_value->color_to.ptr, move_value->color_min.ptr,
+					    move_value->color_max.ptr, 4);
 		} else if (move_value->move_value_type == MOVE_VALUE_TYPE_SETTING_ADD) {
 			move_value->color_to.w = move_value->color_from.w + move_value->color_value.w;
 			move_value->color_to.x = move_value->color_from.x + move_value->color_value.x;
@@ -361,13 +726,16 @@ void move_value_start(struct move_value_info *move_value)
 			vec4_copy(&move_value->color_to, &move_value->color_value);
 		}
 		gs_float3_srgb_nonlinear_to_linear(move_value->color_to.ptr);
+		move_value->color_ramp_space = move_value->color_space;
+		move_value->color_ramp = color_ramp_build(move_value->color_ramp, &move_value->color_from, &move_value->color_to,
+							  move_value->color_ramp_space);
 
 	} else if (move_value->value_type == MOVE_VALUE_TEXT) {
 		const char *text_from = obs_data_get_string(ss, move_value->setting_name);
 		move_value->double_from = parse_text(move_value->format_type, move_value->format, text_from);
 
 		if (move_value->move_value_type == MOVE_VALUE_TYPE_RANDOM) {
-			move_value->double_to = rand_between_double(move_value->double_min, move_value->double_max);
+			move_value->double_to = rand_between_double(move_value, move_value->double_min, move_value->double_max);
 		} else if (move_value->move_value_type == MOVE_VALUE_TYPE_SETTING_ADD) {
 			move_value->double_to = move_value->double_from + move_value->double_value;
 		} else if (move_value->move_value_type == MOVE_VALUE_TYPE_TYPING) {
@@ -437,6 +805,7 @@ void move_value_update(void *data, obs_data_t *settings)
 		bfree(move_value->setting_name);
 
 		move_value->setting_name = bstrdup(setting_name);
+		move_value->setting_component = move_source_component_find(setting_name);
 	}
 
 	if (obs_data_has_user_value(settings, S_SINGLE_SETTING)) {
@@ -446,12 +815,26 @@ void move_value_update(void *data, obs_data_t *settings)
 		obs_data_unset_user_value(settings, S_SINGLE_SETTING);
 	}
 
+	move_value->color_space = obs_data_get_int(settings, S_COLOR_SPACE);
+
+	const long long random_seed = obs_data_get_int(settings, S_SETTING_RANDOM_SEED);
+	if (!move_value->rng_seeded || move_value->random_seed != random_seed) {
+		move_value->random_seed = random_seed;
+		rng_seed(&move_value->rng, random_seed ? (uint64_t)random_seed : os_gettime_ns() ^ (uint64_t)(uintptr_t)move_value);
+		move_value->rng_seeded = true;
+	}
+	move_value->random_sequence = obs_data_get_bool(settings, S_SETTING_RANDOM_SEQUENCE);
+
 	if (obs_data_get_int(settings, S_MOVE_VALUE_TYPE) != MOVE_VALUE_TYPE_SETTINGS) {
 		obs_data_array_release(move_value->settings);
 		move_value->settings = NULL;
+		move_values_clear_lanes(move_value);
 	} else if (parent) {
 		if (!move_value->settings)
 			move_value->settings = obs_data_array_create();
+		pthread_mutex_lock(&move_value->lanes_mutex);
+		move_value_schema_clear(&move_value->schema);
+		pthread_mutex_unlock(&move_value->lanes_mutex);
 		obs_source_t *source = NULL;
 		if (move_value->setting_filter_name && strlen(move_value->setting_filter_name)) {
 			source = obs_weak_source_get_source(move_value->filter);
@@ -515,6 +898,7 @@ void move_value_update(void *data, obs_data_t *settings)
 static void *move_value_create(obs_data_t *settings, obs_source_t *source)
 {
 	struct move_value_info *move_value = bzalloc(sizeof(struct move_value_info));
+	pthread_mutex_init(&move_value->lanes_mutex, NULL);
 	move_filter_init(&move_value->move_filter, source, (void (*)(void *))move_value_start);
 	if ((obs_get_source_output_flags(obs_source_get_id(source)) & OBS_SOURCE_VIDEO) == 0) {
 		move_value_update(move_value, settings);
@@ -537,6 +921,15 @@ static void move_value_destroy(void *data)
 	bfree(move_value->setting_filter_name);
 	bfree(move_value->setting_name);
 	obs_data_array_release(move_value->settings);
+	move_value_schema_clear(&move_value->schema);
+	da_free(move_value->schema.props);
+	move_values_clear_lanes(move_value);
+	da_free(move_value->targets);
+	bfree(move_value->color_ramp);
+	da_free(move_value->lanes_from);
+	da_free(move_value->lanes_to);
+	da_free(move_value->lanes);
+	pthread_mutex_destroy(&move_value->lanes_mutex);
 	bfree(move_value);
 }
 
@@ -601,94 +994,19 @@ bool move_value_get_value(obs_properties_t *props, obs_property_t *property, voi
 	const enum obs_property_type prop_type = obs_property_get_type(sp);
 	if (prop_type == OBS_PROPERTY_INVALID) {
 		const char *source_id = obs_source_get_unversioned_id(source);
-		if (source_id && strcmp(source_id, MOVE_SOURCE_FILTER_ID) == 0) {
-			if (strcmp(move_value->setting_name, "pos.x") == 0) {
-				obs_data_t *pos = obs_data_get_obj(ss, "pos");
-				const double value = obs_data_get_double(pos, "x");
-				obs_data_release(pos);
-				obs_data_set_double(settings, S_SETTING_FLOAT, value);
-				obs_data_set_double(settings, S_SETTING_FLOAT_MIN, value);
-				obs_data_set_double(settings, S_SETTING_FLOAT_MAX, value);
-				settings_changed = true;
-			} else if (strcmp(move_value->setting_name, "pos.y") == 0) {
-				obs_data_t *pos = obs_data_get_obj(ss, "pos");
-				const double value = obs_data_get_double(pos, "y");
-				obs_data_release(pos);
-				obs_data_set_double(settings, S_SETTING_FLOAT, value);
-				obs_data_set_double(settings, S_SETTING_FLOAT_MIN, value);
-				obs_data_set_double(settings, S_SETTING_FLOAT_MAX, value);
-				settings_changed = true;
-			} else if (strcmp(move_value->setting_name, "scale.x") == 0) {
-				obs_data_t *scale = obs_data_get_obj(ss, "scale");
-				const double value = obs_data_get_double(scale, "x");
-				obs_data_release(scale);
-				obs_data_set_double(settings, S_SETTING_FLOAT, value);
-				obs_data_set_double(settings, S_SETTING_FLOAT_MIN, value);
-				obs_data_set_double(settings, S_SETTING_FLOAT_MAX, value);
-				settings_changed = true;
-			} else if (strcmp(move_value->setting_name, "scale.y") == 0) {
-				obs_data_t *scale = obs_data_get_obj(ss, "scale");
-				const double value = obs_data_get_double(scale, "y");
-				obs_data_release(scale);
-				obs_data_set_double(settings, S_SETTING_FLOAT, value);
-				obs_data_set_double(settings, S_SETTING_FLOAT_MIN, value);
-				obs_data_set_double(settings, S_SETTING_FLOAT_MAX, value);
-				settings_changed = true;
-			} else if (strcmp(move_value->setting_name, "bounds.x") == 0) {
-				obs_data_t *bounds = obs_data_get_obj(ss, "bounds");
-				const double value = obs_data_get_double(bounds, "x");
-				obs_data_release(bounds);
-				obs_data_set_double(settings, S_SETTING_FLOAT, value);
-				obs_data_set_double(settings, S_SETTING_FLOAT_MIN, value);
-				obs_data_set_double(settings, S_SETTING_FLOAT_MAX, value);
-				settings_changed = true;
-			} else if (strcmp(move_value->setting_name, "bounds.y") == 0) {
-				obs_data_t *bounds = obs_data_get_obj(ss, "bounds");
-				const double value = obs_data_get_double(bounds, "y");
-				obs_data_release(bounds);
-				obs_data_set_double(settings, S_SETTING_FLOAT, value);
-				obs_data_set_double(settings, S_SETTING_FLOAT_MIN, value);
-				obs_data_set_double(settings, S_SETTING_FLOAT_MAX, value);
-				settings_changed = true;
-			} else if (strcmp(move_value->setting_name, "crop.left") == 0) {
-				obs_data_t *crop = obs_data_get_obj(ss, "crop");
-				const long long value = obs_data_get_int(crop, "left");
-				obs_data_release(crop);
-				obs_data_set_int(settings, S_SETTING_INT, value);
-				obs_data_set_int(settings, S_SETTING_INT_MIN, value);
-				obs_data_set_int(settings, S_SETTING_INT_MAX, value);
-				settings_changed = true;
-			} else if (strcmp(move_value->setting_name, "crop.top") == 0) {
-				obs_data_t *crop = obs_data_get_obj(ss, "crop");
-				const long long value = obs_data_get_int(crop, "top");
-				obs_data_release(crop);
-				obs_data_set_int(settings, S_SETTING_INT, value);
-				obs_data_set_int(settings, S_SETTING_INT_MIN, value);
-				obs_data_set_int(settings, S_SETTING_INT_MAX, value);
-				settings_changed = true;
-			} else if (strcmp(move_value->setting_name, "crop.right") == 0) {
-				obs_data_t *crop = obs_data_get_obj(ss, "crop");
-				const long long value = obs_data_get_int(crop, "right");
-				obs_data_release(crop);
-				obs_data_set_int(settings, S_SETTING_INT, value);
-				obs_data_set_int(settings, S_SETTING_INT_MIN, value);
-				obs_data_set_int(settings, S_SETTING_INT_MAX, value);
-				settings_changed = true;
-			} else if (strcmp(move_value->setting_name, "crop.bottom") == 0) {
-				obs_data_t *crop = obs_data_get_obj(ss, "crop");
-				const long long value = obs_data_get_int(crop, "bottom");
-				obs_data_release(crop);
-				obs_data_set_int(settings, S_SETTING_INT, value);
-				obs_data_set_int(settings, S_SETTING_INT_MIN, value);
-				obs_data_set_int(settings, S_SETTING_INT_MAX, value);
-				settings_changed = true;
-			} else if (strcmp(move_value->setting_name, "rot") == 0) {
-				const double value = obs_data_get_double(ss, "rot");
+		if (source_id && strcmp(source_id, MOVE_SOURCE_FILTER_ID) == 0 && move_value->setting_component >= 0) {
+			double value = 0.0;
+			move_source_component_get(ss, move_value->setting_component, &value);
+			if (move_value->setting_component >= MOVE_SOURCE_CROP_LEFT) {
+				obs_data_set_int(settings, S_SETTING_INT, (long long)value);
+				obs_data_set_int(settings, S_SETTING_INT_MIN, (long long)value);
+				obs_data_set_int(settings, S_SETTING_INT_MAX, (long long)value);
+			} else {
 				obs_data_set_double(settings, S_SETTING_FLOAT, value);
 				obs_data_set_double(settings, S_SETTING_FLOAT_MIN, value);
 				obs_data_set_double(settings, S_SETTING_FLOAT_MAX, value);
-				settings_changed = true;
 			}
+			settings_changed = true;
 		}
 	} else if (prop_type == OBS_PROPERTY_INT) {
 		const long long value = obs_data_get_int(ss, move_value->setting_name);
@@ -760,89 +1078,13 @@ bool move_value_get_values(obs_properties_t *props, obs_property_t *property, vo
 		const long long value_type = obs_data_get_int(item, S_VALUE_TYPE);
 		obs_data_release(item);
 		if (is_move_source) {
-			if (strcmp(name, "pos.x") == 0) {
-				obs_data_t *pos = obs_data_get_obj(ss, "pos");
-				if (pos) {
-					const double value = obs_data_get_double(pos, "x");
-					obs_data_set_double(settings, name, value);
-					obs_data_release(pos);
-					continue;
-				}
-			} else if (strcmp(name, "pos.y") == 0) {
-				obs_data_t *pos = obs_data_get_obj(ss, "pos");
-				if (pos) {
-					const double value = obs_data_get_double(pos, "y");
-					obs_data_set_double(settings, name, value);
-					obs_data_release(pos);
-					continue;
-				}
-			} else if (strcmp(name, "scale.x") == 0) {
-				obs_data_t *scale = obs_data_get_obj(ss, "scale");
-				if (scale) {
-					const double value = obs_data_get_double(scale, "x");
+			const int component = move_source_component_find(name);
+			double value;
+			if (component >= 0 && move_source_component_get(ss, component, &value)) {
+				if (component >= MOVE_SOURCE_CROP_LEFT)
+					obs_data_set_int(settings, name, (long long)value);
+				else
 					obs_data_set_double(settings, name, value);
-					obs_data_release(scale);
-					continue;
-				}
-			} else if (strcmp(name, "scale.y") == 0) {
-				obs_data_t *scale = obs_data_get_obj(ss, "scale");
-				if (scale) {
-					const double value = obs_data_get_double(scale, "y");
-					obs_data_set_double(settings, name, value);
-					obs_data_release(scale);
-					continue;
-				}
-			} else if (strcmp(name, "bounds.x") == 0) {
-				obs_data_t *bounds = obs_data_get_obj(ss, "bounds");
-				if (bounds) {
-					const double value = obs_data_get_double(bounds, "x");
-					obs_data_set_double(settings, name, value);
-					obs_data_release(bounds);
-					continue;
-				}
-			} else if (strcmp(name, "bounds.y") == 0) {
-				obs_data_t *bounds = obs_data_get_obj(ss, "bounds");
-				if (bounds) {
-					const double value = obs_data_get_double(bounds, "y");
-					obs_data_set_double(settings, name, value);
-					obs_data_release(bounds);
-					continue;
-				}
-			} else if (strcmp(name, "crop.left") == 0) {
-				obs_data_t *crop = obs_data_get_obj(ss, "crop");
-				if (crop) {
-					const long long value = obs_data_get_int(crop, "left");
-					obs_data_set_int(settings, name, value);
-					obs_data_release(crop);
-					continue;
-				}
-			} else if (strcmp(name, "crop.top") == 0) {
-				obs_data_t *crop = obs_data_get_obj(ss, "crop");
-				if (crop) {
-					const long long value = obs_data_get_int(crop, "top");
-					obs_data_set_int(settings, name, value);
-					obs_data_release(crop);
-					continue;
-				}
-			} else if (strcmp(name, "crop.right") == 0) {
-				obs_data_t *crop = obs_data_get_obj(ss, "crop");
-				if (crop) {
-					const long long value = obs_data_get_int(crop, "right");
-					obs_data_set_int(settings, name, value);
-					obs_data_release(crop);
-					continue;
-				}
-			} else if (strcmp(name, "crop.bottom") == 0) {
-				obs_data_t *crop = obs_data_get_obj(ss, "crop");
-				if (crop) {
-					const long long value = obs_data_get_int(crop, "bottom");
-					obs_data_set_int(settings, name, value);
-					obs_data_release(crop);
-					continue;
-				}
-			} else if (strcmp(name, "rot") == 0) {
-				const double value = obs_data_get_double(ss, "rot");
-				obs_data_set_double(settings, name, value);
 				continue;
 			}
 		}
@@ -863,12 +1105,12 @@ bool move_value_get_values(obs_properties_t *props, obs_property_t *property, vo
 	}
 
 	if (count > 0) {
-		if (is_move_source) {
-			load_move_source_properties(move_value->settings, settings, ss);
-		}
-		obs_properties_t *sps = obs_source_properties(source);
-		load_properties(sps, move_value->settings, settings, ss);
-		obs_properties_destroy(sps);
+		pthread_mutex_lock(&move_value->lanes_mutex);
+		move_value_schema_clear(&move_value->schema);
+		move_value_schema_load(&move_value->schema, source);
+		move_values_load_settings(move_value, source, settings, ss);
+		pthread_mutex_unlock(&move_value->lanes_mutex);
+		move_values_build_lanes(move_value);
 	}
 	obs_data_release(ss);
 	obs_data_release(settings);
@@ -1050,9 +1292,9 @@ bool move_value_format_type_changed(void *data, obs_properties_t *props, obs_pro
 	return true;
 }
 
-bool move_value_setting_changed(void *data, obs_properties_t *props, obs_property_t *property, obs_data_t *settings)
+static bool move_value_setting_changed_internal(void *data, obs_properties_t *props, obs_property_t *property,
+						obs_data_t *settings)
 {
-	UNUSED_PARAMETER(property);
 	struct move_value_info *move_value = data;
 	bool refresh = false;
 	const char *setting_name = obs_data_get_string(settings, S_SETTING_NAME);
@@ -1061,6 +1303,7 @@ bool move_value_setting_changed(void *data, obs_properties_t *props, obs_propert
 
 		bfree(move_value->setting_name);
 		move_value->setting_name = bstrdup(setting_name);
+		move_value->setting_component = move_source_component_find(setting_name);
 	}
 
 	obs_source_t *source;
@@ -1672,6 +1915,35 @@ bool move_value_setting_changed(void *data, obs_properties_t *props, obs_propert
 	return true;
 }
 
+// the color space only applies to color values, either the single setting or one of the settings
+static bool move_value_color_space_changed(struct move_value_info *move_value, obs_properties_t *props, obs_data_t *settings)
+{
+	bool color = false;
+	if (obs_data_get_int(settings, S_MOVE_VALUE_TYPE) == MOVE_VALUE_TYPE_SETTINGS) {
+		const size_t count = obs_data_array_count(move_value->settings);
+		for (size_t i = 0; i < count && !color; i++) {
+			obs_data_t *item = obs_data_array_item(move_value->settings, i);
+			const long long value_type = obs_data_get_int(item, S_VALUE_TYPE);
+			color = value_type == MOVE_VALUE_COLOR || value_type == MOVE_VALUE_COLOR_ALPHA;
+			obs_data_release(item);
+		}
+	} else {
+		const long long value_type = obs_data_get_int(settings, S_VALUE_TYPE);
+		color = value_type == MOVE_VALUE_COLOR || value_type == MOVE_VALUE_COLOR_ALPHA;
+	}
+	obs_property_t *p = obs_properties_get(props, S_COLOR_SPACE);
+	if (obs_property_visible(p) == color)
+		return false;
+	obs_property_set_visible(p, color);
+	return true;
+}
+
+bool move_value_setting_changed(void *data, obs_properties_t *props, obs_property_t *property, obs_data_t *settings)
+{
+	const bool refresh = move_value_setting_changed_internal(data, props, property, settings);
+	return move_value_color_space_changed(data, props, settings) || refresh;
+}
+
 bool move_value_type_changed(void *data, obs_properties_t *props, obs_property_t *property, obs_data_t *settings)
 {
 	bool refresh = false;
@@ -1682,6 +1954,13 @@ bool move_value_type_changed(void *data, obs_properties_t *props, obs_property_t
 		obs_property_set_visible(p, move_value_type != MOVE_VALUE_TYPE_SETTINGS);
 		refresh = true;
 	}
+	p = obs_properties_get(props, S_SETTING_RANDOM_SEED);
+	if (obs_property_visible(p) != (move_value_type == MOVE_VALUE_TYPE_RANDOM)) {
+		obs_property_set_visible(p, move_value_type == MOVE_VALUE_TYPE_RANDOM);
+		obs_property_set_visible(obs_properties_get(props, S_SETTING_RANDOM_SEQUENCE),
+					 move_value_type == MOVE_VALUE_TYPE_RANDOM);
+		refresh = true;
+	}
 	p = obs_properties_get(props, S_SETTINGS);
 	if (obs_property_visible(p) != (move_value_type == MOVE_VALUE_TYPE_SETTINGS)) {
 		obs_property_set_visible(p, move_value_type == MOVE_VALUE_TYPE_SETTINGS);
@@ -1729,6 +2008,11 @@ static obs_properties_t *move_value_properties(void *data)
 
 	obs_property_set_modified_callback2(p, move_value_type_changed, data);
 
+	p = obs_properties_add_list(ppts, S_COLOR_SPACE, obs_module_text("ColorSpace"), OBS_COMBO_TYPE_LIST, OBS_COMBO_FORMAT_INT);
+	obs_property_list_add_int(p, obs_module_text("ColorSpace.Linear"), MOVE_VALUE_COLOR_SPACE_LINEAR);
+	obs_property_list_add_int(p, obs_module_text("ColorSpace.Oklab"), MOVE_VALUE_COLOR_SPACE_OKLAB);
+	obs_property_list_add_int(p, obs_module_text("ColorSpace.Oklch"), MOVE_VALUE_COLOR_SPACE_OKLCH);
+
 	obs_properties_t *setting_value = obs_properties_create();
 
 	p = obs_properties_add_list(setting_value, S_SETTING_NAME, obs_module_text("Setting"), OBS_COMBO_TYPE_LIST,
@@ -1765,6 +2049,10 @@ static obs_properties_t *move_value_properties(void *data)
 	obs_property_set_visible(p, false);
 	p = obs_properties_add_float(setting_value, S_SETTING_FLOAT_MAX, obs_module_text("MaxValue"), 0, 0, 0);
 	obs_property_set_visible(p, false);
+	p = obs_properties_add_int(setting_value, S_SETTING_RANDOM_SEED, obs_module_text("RandomSeed"), 0, INT_MAX, 1);
+	obs_property_set_visible(p, false);
+	p = obs_properties_add_bool(setting_value, S_SETTING_RANDOM_SEQUENCE, obs_module_text("RandomSequence"));
+	obs_property_set_visible(p, false);
 	p = obs_properties_add_color(setting_value, S_SETTING_COLOR, obs_module_text("Value"));
 	obs_property_set_visible(p, false);
 	p = obs_properties_add_color(setting_value, S_SETTING_COLOR_MIN, obs_module_text("MinValue"));
@@ -1815,7 +2103,6 @@ static const char *move_value_get_name(void *type_data)
 	return obs_module_text("MoveValueFilter");
 }
 
-float get_eased(float f, long long easing, long long easing_function);
 void vec2_bezier(struct vec2 *dst, struct vec2 *begin, struct vec2 *control, struct vec2 *end, const float t);
 
 void move_value_stop(struct move_value_info *move_value)
@@ -1823,7 +2110,7 @@ void move_value_stop(struct move_value_info *move_value)
 	move_filter_stop(&move_value->move_filter);
 }
 
-void move_value_tick(void *data, float seconds)
+static void move_value_tick_internal(void *data, float seconds)
 {
 	struct move_value_info *move_value = data;
 	float t;
@@ -1844,42 +2131,37 @@ void move_value_tick(void *data, float seconds)
 	const bool is_move_source = source_id && strcmp(source_id, MOVE_SOURCE_FILTER_ID) == 0;
 	bool update = true;
 	if (move_value->settings) {
-		const size_t count = obs_data_array_count(move_value->settings);
 		if (is_move_source) {
 			obs_data_set_string(ss, S_TRANSFORM_TEXT, "");
 		}
-		for (size_t i = 0; i < count; i++) {
-			obs_data_t *item = obs_data_array_item(move_value->settings, i);
-			const char *setting_name = obs_data_get_string(item, S_SETTING_NAME);
-			const long long value_type = obs_data_get_int(item, S_VALUE_TYPE);
-			if (value_type == MOVE_VALUE_INT) {
-				const long long int_from = obs_data_get_int(item, S_SETTING_FROM);
-				const long long int_to = obs_data_get_int(item, S_SETTING_TO);
-				const long long value_int = (long long)((1.0 - t) * (double)int_from + t * (double)int_to);
-				obs_data_set_int(ss, setting_name, value_int);
-			} else if (value_type == MOVE_VALUE_FLOAT) {
-				const double double_from = obs_data_get_double(item, S_SETTING_FROM);
-				const double double_to = obs_data_get_double(item, S_SETTING_TO);
-				const double value_double = ((1.0 - t) * double_from + t * double_to);
-				obs_data_set_double(ss, setting_name, value_double);
-			} else if (value_type == MOVE_VALUE_COLOR || value_type == MOVE_VALUE_COLOR_ALPHA) {
-				struct vec4 color_from;
-				vec4_from_rgba(&color_from, (uint32_t)obs_data_get_int(item, S_SETTING_FROM));
-				gs_float3_srgb_nonlinear_to_linear(color_from.ptr);
-				struct vec4 color_to;
-				vec4_from_rgba(&color_to, (uint32_t)obs_data_get_int(item, S_SETTING_TO));
-				gs_float3_srgb_nonlinear_to_linear(color_to.ptr);
+		pthread_mutex_lock(&move_value->lanes_mutex);
+		move_values_lerp(move_value->lanes.array, move_value->lanes_from.array, move_value->lanes_to.array,
+				 move_value->lanes.num, t);
+		for (size_t i = 0; i < move_value->targets.num; i++) {
+			const struct move_value_target *target = move_value->targets.array + i;
+			const double *value = move_value->lanes.array + target->lane;
+			if (target->value_type == MOVE_VALUE_INT) {
+				obs_data_set_int(ss, target->setting_name, (long long)value[0]);
+			} else if (target->value_type == MOVE_VALUE_FLOAT) {
+				obs_data_set_double(ss, target->setting_name, value[0]);
+			} else {
 				struct vec4 color;
-				color.w = (1.0f - t) * color_from.w + t * color_to.w;
-				color.x = (1.0f - t) * color_from.x + t * color_to.x;
-				color.y = (1.0f - t) * color_from.y + t * color_to.y;
-				color.z = (1.0f - t) * color_from.z + t * color_to.z;
+				if (target->ramp) {
+					const double *from = move_value->lanes_from.array + target->lane;
+					const double *to = move_value->lanes_to.array + target->lane;
+					struct vec4 color_from;
+					struct vec4 color_to;
+					vec4_set(&color_from, (float)from[0], (float)from[1], (float)from[2], (float)from[3]);
+					vec4_set(&color_to, (float)to[0], (float)to[1], (float)to[2], (float)to[3]);
+					color_ramp_get(&color, target->ramp, &color_from, &color_to, t, target->ramp_space);
+				} else {
+					vec4_set(&color, (float)value[0], (float)value[1], (float)value[2], (float)value[3]);
+				}
 				gs_float3_srgb_linear_to_nonlinear(color.ptr);
-				const long long value_int = vec4_to_rgba(&color);
-				obs_data_set_int(ss, setting_name, value_int);
+				obs_data_set_int(ss, target->setting_name, vec4_to_rgba(&color));
 			}
-			obs_data_release(item);
 		}
+		pthread_mutex_unlock(&move_value->lanes_mutex);
 	} else if (move_value->value_type == MOVE_VALUE_INT) {
 		const long long value_int = (long long)((1.0 - t) * (double)move_value->int_from + t * (double)move_value->int_to);
 		if (strcmp(move_value->setting_name, VOLUME_SETTING) == 0) {
@@ -1890,22 +2172,8 @@ void move_value_tick(void *data, float seconds)
 			update = false;
 		} else if (is_move_source) {
 			obs_data_set_string(ss, S_TRANSFORM_TEXT, "");
-			if (strcmp(move_value->setting_name, "crop.left") == 0) {
-				obs_data_t *crop = obs_data_get_obj(ss, "crop");
-				obs_data_set_int(crop, "left", value_int);
-				obs_data_release(crop);
-			} else if (strcmp(move_value->setting_name, "crop.top") == 0) {
-				obs_data_t *crop = obs_data_get_obj(ss, "crop");
-				obs_data_set_int(crop, "top", value_int);
-				obs_data_release(crop);
-			} else if (strcmp(move_value->setting_name, "crop.right") == 0) {
-				obs_data_t *crop = obs_data_get_obj(ss, "crop");
-				obs_data_set_int(crop, "right", value_int);
-				obs_data_release(crop);
-			} else if (strcmp(move_value->setting_name, "crop.bottom") == 0) {
-				obs_data_t *crop = obs_data_get_obj(ss, "crop");
-				obs_data_set_int(crop, "bottom", value_int);
-				obs_data_release(crop);
+			if (move_value->setting_component >= 0) {
+				move_source_component_set(ss, move_value->setting_component, (double)value_int);
 			} else {
 				obs_data_set_int(ss, move_value->setting_name, value_int);
 			}
@@ -1922,30 +2190,8 @@ void move_value_tick(void *data, float seconds)
 			update = false;
 		} else if (is_move_source) {
 			obs_data_set_string(ss, S_TRANSFORM_TEXT, "");
-			if (strcmp(move_value->setting_name, "pos.x") == 0) {
-				obs_data_t *pos = obs_data_get_obj(ss, "pos");
-				obs_data_set_double(pos, "x", value_double);
-				obs_data_release(pos);
-			} else if (strcmp(move_value->setting_name, "pos.y") == 0) {
-				obs_data_t *pos = obs_data_get_obj(ss, "pos");
-				obs_data_set_double(pos, "y", value_double);
-				obs_data_release(pos);
-			} else if (strcmp(move_value->setting_name, "scale.x") == 0) {
-				obs_data_t *scale = obs_data_get_obj(ss, "scale");
-				obs_data_set_double(scale, "x", value_double);
-				obs_data_release(scale);
-			} else if (strcmp(move_value->setting_name, "scale.y") == 0) {
-				obs_data_t *scale = obs_data_get_obj(ss, "scale");
-				obs_data_set_double(scale, "y", value_double);
-				obs_data_release(scale);
-			} else if (strcmp(move_value->setting_name, "bounds.x") == 0) {
-				obs_data_t *bounds = obs_data_get_obj(ss, "bounds");
-				obs_data_set_double(bounds, "x", value_double);
-				obs_data_release(bounds);
-			} else if (strcmp(move_value->setting_name, "bounds.y") == 0) {
-				obs_data_t *bounds = obs_data_get_obj(ss, "bounds");
-				obs_data_set_double(bounds, "y", value_double);
-				obs_data_release(bounds);
+			if (move_value->setting_component >= 0) {
+				move_source_component_set(ss, move_value->setting_component, value_double);
 			} else {
 				obs_data_set_double(ss, move_value->setting_name, value_double);
 			}
@@ -1954,10 +2200,8 @@ void move_value_tick(void *data, float seconds)
 		}
 	} else if (move_value->value_type == MOVE_VALUE_COLOR || move_value->value_type == MOVE_VALUE_COLOR_ALPHA) {
 		struct vec4 color;
-		color.w = (1.0f - t) * move_value->color_from.w + t * move_value->color_to.w;
-		color.x = (1.0f - t) * move_value->color_from.x + t * move_value->color_to.x;
-		color.y = (1.0f - t) * move_value->color_from.y + t * move_value->color_to.y;
-		color.z = (1.0f - t) * move_value->color_from.z + t * move_value->color_to.z;
+		color_ramp_get(&color, move_value->color_ramp, &move_value->color_from, &move_value->color_to, t,
+			       move_value->color_ramp_space);
 		gs_float3_srgb_linear_to_nonlinear(color.ptr);
 		const long long value_int = vec4_to_rgba(&color);
 		obs_data_set_int(ss, move_value->setting_name, value_int);
@@ -2047,6 +2291,13 @@ void move_value_tick(void *data, float seconds)
 	}
 }
 
+void move_value_tick(void *data, float seconds)
+{
+	MOVE_PERF_BEGIN(tick_start);
+	move_value_tick_internal(data, seconds);
+	MOVE_PERF_END(MOVE_PERF_VALUE_TICK, tick_start);
+}
+
 struct obs_source_info move_value_filter = {
 	.id = MOVE_VALUE_FILTER_ID,
 	.type = OBS_SOURCE_TYPE_FILTER,
@@ -2060,6 +2311,8 @@ struct obs_source_info move_value_filter = {
 	.video_tick = move_value_tick,
 	.update = move_value_update,
 	.load = move_value_update,
+	.filter_add = move_filter_add,
+	.filter_remove = move_filter_remove,
 	.activate = move_filter_activate,
 	.deactivate = move_filter_deactivate,
 	.show = move_filter_show,
@@ -2079,6 +2332,8 @@ struct obs_source_info move_audio_value_filter = {
 	.video_tick = move_value_tick,
 	.update = move_value_update,
 	.load = move_value_update,
+	.filter_add = move_filter_add,
+	.filter_remove = move_filter_remove,
 	.activate = move_filter_activate,
 	.deactivate = move_filter_deactivate,
 	.show = move_filter_show,
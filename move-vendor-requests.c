@@ -0,0 +1,151 @@
+#include "move-transition.h"
+#include "obs-websocket-api.h"
+
+#define MOVE_VENDOR_START 0
+#define MOVE_VENDOR_STOP 1
+#define MOVE_VENDOR_REVERSE 2
+#define MOVE_VENDOR_SEEK 3
+
+static const long long move_vendor_actions[] = {MOVE_VENDOR_START, MOVE_VENDOR_STOP, MOVE_VENDOR_REVERSE, MOVE_VENDOR_SEEK};
+
+struct move_vendor_control {
+	long long action;
+	float t;
+	size_t count;
+};
+
+static bool move_vendor_control_filter(struct move_vendor_control *control, obs_source_t *filter)
+{
+	if (!filter || obs_source_removed(filter) || !is_move_filter(obs_source_get_unversioned_id(filter)))
+		return false;
+	struct move_filter *move_filter = obs_obj_get_data(filter);
+	if (!move_filter)
+		return false;
+	if (control->action == MOVE_VENDOR_START) {
+		move_filter_start(move_filter);
+	} else if (control->action == MOVE_VENDOR_STOP) {
+		move_filter_stop(move_filter);
+	} else if (control->action == MOVE_VENDOR_REVERSE) {
+		if (move_filter->moving) {
+			move_filter_turn_around(move_filter);
+		} else {
+			move_filter->reverse = !move_filter->reverse;
+			move_filter_start(move_filter);
+		}
+	} else if (control->action == MOVE_VENDOR_SEEK) {
+		if (!move_filter->moving)
+			return false;
+		move_filter_seek(move_filter, control->t);
+	}
+	control->count++;
+	return true;
+}
+
+static void move_vendor_control_enum(obs_source_t *parent, obs_source_t *child, void *param)
+{
+	UNUSED_PARAMETER(parent);
+	move_vendor_control_filter(param, child);
+}
+
+static void move_vendor_failed(obs_data_array_t *failed, const char *source_name, const char *filter_name)
+{
+	obs_data_t *item = obs_data_create();
+	obs_data_set_string(item, "source", source_name);
+	obs_data_set_string(item, "filter", filter_name);
+	obs_data_array_push_back(failed, item);
+	obs_data_release(item);
+}
+
+// request: {"filters": [{"source": "", "filter": "", "t": 0.5}], "t": 0.5}, an empty filter name targets every move filter on the source
+static void move_vendor_control(obs_data_t *request_data, obs_data_t *response_data, void *priv)
+{
+	struct move_vendor_control control = {*(const long long *)priv, (float)obs_data_get_double(request_data, "t"), 0};
+	const float t = control.t;
+	obs_data_array_t *failed = obs_data_array_create();
+	obs_data_array_t *filters = obs_data_get_array(request_data, "filters");
+	const size_t count = obs_data_array_count(filters);
+	for (size_t i = 0; i < count; i++) {
+		obs_data_t *item = obs_data_array_item(filters, i);
+		const char *source_name = obs_data_get_string(item, "source");
+		const char *filter_name = obs_data_get_string(item, "filter");
+		control.t = obs_data_has_user_value(item, "t") ? (float)obs_data_get_double(item, "t") : t;
+		obs_source_t *source = obs_get_source_by_name(source_name);
+		bool found = false;
+		if (source && !strlen(filter_name)) {
+			const size_t before = control.count;
+			obs_source_enum_filters(source, move_vendor_control_enum, &control);
+			found = control.count > before;
+		} else if (source) {
+			obs_source_t *filter = obs_source_get_filter_by_name(source, filter_name);
+			found = move_vendor_control_filter(&control, filter);
+			obs_source_release(filter);
+		}
+		if (!found)
+			move_vendor_failed(failed, source_name, filter_name);
+		obs_source_release(source);
+		obs_data_release(item);
+	}
+	obs_data_array_release(filters);
+	obs_data_set_int(response_data, "count", (long long)control.count);
+	obs_data_set_array(response_data, "failed", failed);
+	obs_data_array_release(failed);
+}
+
+static void move_vendor_snapshot_filter(obs_source_t *parent, obs_source_t *child, void *param)
+{
+	if (obs_source_removed(child) || !is_move_filter(obs_source_get_unversioned_id(child)))
+		return;
+	struct move_filter *move_filter = obs_obj_get_data(child);
+	if (!move_filter || !move_filter->moving || !obs_source_enabled(child))
+		return;
+	obs_data_t *item = obs_data_create();
+	obs_data_set_string(item, "source", obs_source_get_name(parent));
+	obs_data_set_string(item, "filter", obs_source_get_name(child));
+	obs_data_set_string(item, "id", obs_source_get_unversioned_id(child));
+	obs_data_set_double(item, "t", move_filter_progress(move_filter));
+	obs_data_set_int(item, "remaining_ms", (long long)move_filter_remaining(move_filter));
+	obs_data_set_bool(item, "reverse", move_filter->reverse);
+	obs_data_array_push_back(param, item);
+	obs_data_release(item);
+}
+
+static bool move_vendor_snapshot_source(void *data, obs_source_t *source)
+{
+	obs_source_enum_filters(source, move_vendor_snapshot_filter, data);
+	return true;
+}
+
+static void move_vendor_snapshot(obs_data_t *request_data, obs_data_t *response_data, void *priv)
+{
+	UNUSED_PARAMETER(request_data);
+	UNUSED_PARAMETER(priv);
+	obs_data_array_t *moves = obs_data_array_create();
+	obs_enum_sources(move_vendor_snapshot_source, moves);
+	obs_enum_scenes(move_vendor_snapshot_source, moves);
+	obs_data_set_array(response_data, "moves", moves);
+	obs_data_array_release(moves);
+}
+
+#ifdef MOVE_PERF
+// request: {"reset": true} starts a new measuring window after returning the current one
+static void move_vendor_perf(obs_data_t *request_data, obs_data_t *response_data, void *priv)
+{
+	UNUSED_PARAMETER(priv);
+	move_perf_get(response_data, obs_data_get_bool(request_data, "reset"));
+}
+#endif
+
+void move_vendor_load(obs_websocket_vendor vendor)
+{
+	if (!vendor)
+		return;
+	obs_websocket_vendor_register_request(vendor, "start", move_vendor_control, (void *)&move_vendor_actions[MOVE_VENDOR_START]);
+	obs_websocket_vendor_register_request(vendor, "stop", move_vendor_control, (void *)&move_vendor_actions[MOVE_VENDOR_STOP]);
+	obs_websocket_vendor_register_request(vendor, "reverse", move_vendor_control,
+					      (void *)&move_vendor_actions[MOVE_VENDOR_REVERSE]);
+	obs_websocket_vendor_register_request(vendor, "seek", move_vendor_control, (void *)&move_vendor_actions[MOVE_VENDOR_SEEK]);
+	obs_websocket_vendor_register_request(vendor, "snapshot", move_vendor_snapshot, NULL);
+#ifdef MOVE_PERF
+	obs_websocket_vendor_register_request(vendor, "perf", move_vendor_perf, NULL);
+#endif
+}
@@ -0,0 +1,352 @@
+// matches synthetic scenes with the transition matching code, reports time and allocations and compares with golden files
+#include "move-match.h"
+#include "fake-obs.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define FULL_LISTING_MAX 100
+#define BENCH_MAX_RUNS 10000
+#define BENCH_TIME_NS 500000000ULL
+
+static uint64_t rng_state;
+
+static uint64_t rng_next(void)
+{
+	uint64_t z = (rng_state += 0x9e3779b97f4a7c15ULL);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return z ^ (z >> 31);
+}
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+struct bench_scenes {
+	obs_scene_t *scene_a;
+	obs_scene_t *scene_b;
+};
+
+static obs_source_t *input(const char *id, const char *name)
+{
+	return fake_source_create(id, name, OBS_SOURCE_TYPE_INPUT, NULL);
+}
+
+static obs_source_t *input_with(const char *id, const char *name, const char *key, const char *value)
+{
+	obs_data_t *settings = obs_data_create();
+	obs_data_set_string(settings, key, value);
+	obs_source_t *source = fake_source_create(id, name, OBS_SOURCE_TYPE_INPUT, settings);
+	obs_data_release(settings);
+	return source;
+}
+
+// every eighth item exercises one of the match functions, scene b gets its items in a shuffled order
+static void bench_scenes_generate(struct bench_scenes *scenes, size_t count)
+{
+	char name[128];
+	char other[128];
+	rng_state = count;
+	snprintf(name, sizeof(name), "Scene A %zu", count);
+	scenes->scene_a = fake_scene_create(name, false);
+	snprintf(name, sizeof(name), "Scene B %zu", count);
+	scenes->scene_b = fake_scene_create(name, false);
+
+	obs_source_t **items_b = malloc(sizeof(obs_source_t *) * count * 2);
+	bool *hidden_b = calloc(count * 2, sizeof(bool));
+	size_t count_b = 0;
+	for (size_t i = 0; i < count; i++) {
+		obs_source_t *a = NULL;
+		obs_source_t *b = NULL;
+		switch (i % 8) {
+		case 0:
+			snprintf(name, sizeof(name), "Shared %zu", i);
+			a = b = input("color_source", name);
+			break;
+		case 1:
+			snprintf(name, sizeof(name), "Logo %zu", i);
+			a = input("image_source", name);
+			snprintf(other, sizeof(other), "Logo %zu Clone", i);
+			b = input_with("source-clone", other, "clone", name);
+			break;
+		case 2:
+			snprintf(name, sizeof(name), "Cam%zux 1", i);
+			a = input("dshow_input", name);
+			snprintf(name, sizeof(name), "Cam%zux (2)", i);
+			b = input("dshow_input", name);
+			break;
+		case 3:
+			snprintf(name, sizeof(name), "Title%zu Left", i);
+			a = input("text_ft2_source", name);
+			snprintf(name, sizeof(name), "Title%zu Right", i);
+			b = input("text_ft2_source", name);
+			break;
+		case 4:
+			snprintf(name, sizeof(name), "Lower%zu", i);
+			a = input("text_ft2_source", name);
+			snprintf(name, sizeof(name), "Lower%zu Third", i);
+			b = input("text_ft2_source", name);
+			break;
+		case 5:
+			snprintf(other, sizeof(other), "/media/%zu.png", i);
+			snprintf(name, sizeof(name), "Img%zua", i);
+			a = input_with("image_source", name, "file", other);
+			snprintf(name, sizeof(name), "Img%zub", i);
+			b = input_with("image_source", name, "file", other);
+			break;
+		case 6: {
+			snprintf(name, sizeof(name), "Nested %zu", i);
+			obs_source_t *shared = input("color_source", name);
+			snprintf(name, sizeof(name), "Group%zu", i);
+			obs_scene_t *nested_a = fake_scene_create(name, false);
+			fake_scene_add(nested_a, shared, true);
+			snprintf(name, sizeof(name), "Nest%zu", i);
+			obs_scene_t *nested_b = fake_scene_create(name, (i / 8) % 2 == 1);
+			fake_scene_add(nested_b, shared, true);
+			a = obs_scene_get_source(nested_a);
+			b = obs_scene_get_source(nested_b);
+			break;
+		}
+		default:
+			snprintf(name, sizeof(name), "OnlyA%zu", i);
+			a = input("color_source", name);
+			snprintf(name, sizeof(name), "OnlyB%zu", i);
+			b = input("color_source", name);
+			hidden_b[count_b] = (i / 8) % 3 == 0;
+			break;
+		}
+		obs_sceneitem_t *item = fake_scene_add(scenes->scene_a, a, true);
+		if (i % 16 == 6)
+			fake_sceneitem_set_scale(item, -1.0f, 1.0f);
+		items_b[count_b++] = b;
+	}
+	for (size_t i = count_b; i > 1; i--) {
+		const size_t j = (size_t)(rng_next() % i);
+		obs_source_t *source = items_b[i - 1];
+		items_b[i - 1] = items_b[j];
+		items_b[j] = source;
+		const bool hidden = hidden_b[i - 1];
+		hidden_b[i - 1] = hidden_b[j];
+		hidden_b[j] = hidden;
+	}
+	for (size_t i = 0; i < count_b; i++)
+		fake_scene_add(scenes->scene_b, items_b[i], !hidden_b[i]);
+	free(items_b);
+	free(hidden_b);
+}
+
+static void move_init(struct move_info *move, struct bench_scenes *scenes)
+{
+	memset(move, 0, sizeof(struct move_info));
+	da_init(move->items_a);
+	da_init(move->items_b);
+	move->part_match = true;
+	move->number_match = true;
+	move->last_word_match = true;
+	move->nested_scenes = true;
+	move->scene_source_a = obs_scene_get_source(scenes->scene_a);
+	move->scene_source_b = obs_scene_get_source(scenes->scene_b);
+}
+
+// the matching part of move_start_init
+static void move_match(struct move_info *move, struct bench_scenes *scenes)
+{
+	obs_scene_enum_items(scenes->scene_a, add_item, move);
+	move->item_pos = 0;
+	move_match_scene_items(move, scenes->scene_b);
+}
+
+static void move_clear(struct move_info *move)
+{
+	for (size_t i = 0; i < move->items_a.num; i++) {
+		struct move_item *item = move->items_a.array[i];
+		obs_sceneitem_release(item->item_a);
+		item->item_a = NULL;
+	}
+	for (size_t i = 0; i < move->items_b.num; i++) {
+		struct move_item *item = move->items_b.array[i];
+		obs_sceneitem_release(item->item_b);
+		item->item_b = NULL;
+	}
+	// an item is in items_a, items_b or both
+	for (size_t i = 0; i < move->items_a.num; i++) {
+		struct move_item *item = move->items_a.array[i];
+		da_erase_item(move->items_b, &item);
+		bfree(item->transition_name);
+		bfree(item);
+	}
+	for (size_t i = 0; i < move->items_b.num; i++) {
+		bfree(move->items_b.array[i]->transition_name);
+		bfree(move->items_b.array[i]);
+	}
+	da_free(move->items_a);
+	da_free(move->items_b);
+}
+
+static const char *item_name(obs_sceneitem_t *item)
+{
+	return item ? obs_source_get_name(obs_sceneitem_get_source(item)) : "-";
+}
+
+static uint64_t fnv1a(uint64_t hash, const char *str)
+{
+	for (; *str; str++) {
+		hash ^= (uint8_t)*str;
+		hash *= 0x100000001b3ULL;
+	}
+	return hash;
+}
+
+static char *move_result(struct move_info *move, size_t count)
+{
+	size_t size = 256 + (count <= FULL_LISTING_MAX ? move->items_a.num * 512 : 0);
+	char *result = malloc(size);
+	result[0] = 0;
+	char line[512];
+	uint64_t hash = 0xcbf29ce484222325ULL;
+	size_t len = 0;
+	size_t matched = 0;
+	for (size_t i = 0; i < move->items_a.num; i++) {
+		struct move_item *item = move->items_a.array[i];
+		if (item->item_a && item->item_b)
+			matched++;
+		snprintf(line, sizeof(line), "%s -> %s%s%s%s\n", item_name(item->item_a), item_name(item->item_b),
+			 item->move_scene ? " scene" : "", item->scene_flip_horizontal ? " flip_h" : "",
+			 item->scene_flip_vertical ? " flip_v" : "");
+		hash = fnv1a(hash, line);
+		if (count <= FULL_LISTING_MAX) {
+			memcpy(result + len, line, strlen(line) + 1);
+			len += strlen(line);
+		}
+	}
+	char summary[256];
+	snprintf(summary, sizeof(summary), "items %zu\nitems_a %zu\nitems_b %zu\nmatched %zu\nhash %016" PRIx64 "\n", count,
+		 move->items_a.num, move->items_b.num, matched, hash);
+	const size_t summary_len = strlen(summary);
+	memmove(result + summary_len, result, len + 1);
+	memcpy(result, summary, summary_len);
+	result[summary_len + len] = 0;
+	return result;
+}
+
+static char *read_file(const char *path)
+{
+	FILE *f = fopen(path, "rb");
+	if (!f)
+		return NULL;
+	fseek(f, 0, SEEK_END);
+	const long size = ftell(f);
+	fseek(f, 0, SEEK_SET);
+	char *data = malloc((size_t)size + 1);
+	const size_t read = fread(data, 1, (size_t)size, f);
+	data[read] = 0;
+	fclose(f);
+	return data;
+}
+
+static bool check_golden(const char *golden_dir, bool update, size_t count, const char *result)
+{
+	if (!golden_dir)
+		return true;
+	char path[1024];
+	snprintf(path, sizeof(path), "%s/match-%zu.txt", golden_dir, count);
+	if (update) {
+		FILE *f = fopen(path, "wb");
+		if (!f) {
+			fprintf(stderr, "cannot write %s\n", path);
+			return false;
+		}
+		fputs(result, f);
+		fclose(f);
+		return true;
+	}
+	char *golden = read_file(path);
+	if (!golden) {
+		fprintf(stderr, "missing golden file %s\n", path);
+		return false;
+	}
+	const bool same = strcmp(golden, result) == 0;
+	if (!same)
+		fprintf(stderr, "match result for %zu items differs from %s:\n%s", count, path, result);
+	free(golden);
+	return same;
+}
+
+static bool bench(size_t count, const char *golden_dir, bool update)
+{
+	struct bench_scenes scenes;
+	struct move_info move;
+	bench_scenes_generate(&scenes, count);
+
+	// the first run is checked against the golden file, further runs only add timings
+	const long allocs_before = bnum_allocs();
+	move_init(&move, &scenes);
+	const uint64_t calls_before = fake_obs_alloc_calls();
+	uint64_t start = now_ns();
+	move_match(&move, &scenes);
+	uint64_t best = now_ns() - start;
+	uint64_t total = best;
+	size_t runs = 1;
+	const uint64_t calls = fake_obs_alloc_calls() - calls_before;
+	char *result = move_result(&move, count);
+	move_clear(&move);
+
+	bool ok = check_golden(golden_dir, update, count, result);
+	free(result);
+	if (bnum_allocs() != allocs_before || fake_obs_sceneitem_refs() != 0) {
+		fprintf(stderr, "%zu items: %ld allocations and %ld scene item references left after clearing\n", count,
+			bnum_allocs() - allocs_before, fake_obs_sceneitem_refs());
+		ok = false;
+	}
+
+	while (runs < BENCH_MAX_RUNS && total < BENCH_TIME_NS) {
+		runs++;
+		move_init(&move, &scenes);
+		start = now_ns();
+		move_match(&move, &scenes);
+		const uint64_t elapsed = now_ns() - start;
+		move_clear(&move);
+		total += elapsed;
+		if (elapsed < best)
+			best = elapsed;
+	}
+	printf("%6zu items: %12.3f us best %12.3f us mean %8" PRIu64 " allocations per match (%zu runs)\n", count,
+	       (double)best / 1000.0, (double)total / (double)runs / 1000.0, calls, runs);
+	fake_obs_reset();
+	return ok;
+}
+
+int main(int argc, char **argv)
+{
+	const char *golden_dir = NULL;
+	bool update = false;
+	bool ok = true;
+	size_t sizes = 0;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--golden") == 0 && i + 1 < argc) {
+			golden_dir = argv[++i];
+		} else if (strcmp(argv[i], "--update") == 0) {
+			update = true;
+		} else {
+			const size_t count = (size_t)strtoull(argv[i], NULL, 10);
+			if (!count) {
+				fprintf(stderr, "usage: %s [--golden dir [--update]] [items...]\n", argv[0]);
+				return 2;
+			}
+			ok = bench(count, golden_dir, update) && ok;
+			sizes++;
+		}
+	}
+	if (!sizes) {
+		const size_t defaults[] = {10, 100, 1000, 10000};
+		for (size_t i = 0; i < sizeof(defaults) / sizeof(defaults[0]); i++)
+			ok = bench(defaults[i], golden_dir, update) && ok;
+	}
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,231 @@
+// drives many move source filters through the shared source tick at once, measures the frame cost and checks the commits
+#include "move-transition.h"
+#include "fake-obs.h"
+#include <util/threading.h>
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define FRAME_BASE 1000000000000ULL
+#define BENCH_FRAMES 600
+#define BENCH_SCENES 4
+
+struct move_source_info;
+extern struct obs_source_info move_source_filter;
+void move_source_start(struct move_source_info *move_source);
+void move_sources_load(void);
+void move_sources_unload(void);
+
+// set up by the module load in move-transition.c
+extern pthread_mutex_t udp_servers_mutex;
+void move_filter_hotkeys_load(void);
+void move_filter_hotkeys_unload(void);
+
+// move-transition.c and move-scene-index.c pull in the rest of the plugin, the bench provides what the source filter uses
+bool move_exit = false;
+
+void vec2_bezier(struct vec2 *dst, struct vec2 *begin, struct vec2 *control, struct vec2 *end, const float t)
+{
+	const float p = 1.0f - t;
+	dst->x = p * p * begin->x + 2.0f * p * t * control->x + t * t * end->x;
+	dst->y = p * p * begin->y + 2.0f * p * t * control->y + t * t * end->y;
+}
+
+obs_sceneitem_t *move_scene_find_item(obs_scene_t *scene, const char *name)
+{
+	return obs_scene_find_source(scene, name);
+}
+
+// only reached when building properties, which the bench never does
+bool prop_list_add_sceneitem(obs_scene_t *scene, obs_sceneitem_t *item, void *data)
+{
+	UNUSED_PARAMETER(scene);
+	UNUSED_PARAMETER(item);
+	UNUSED_PARAMETER(data);
+	return true;
+}
+
+static uint64_t rng_state;
+
+static uint64_t rng_next(void)
+{
+	uint64_t z = (rng_state += 0x9e3779b97f4a7c15ULL);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return z ^ (z >> 31);
+}
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+struct bench_move {
+	obs_source_t *source;
+	obs_sceneitem_t *item;
+	void *data;
+	struct vec2 pos_to;
+};
+
+static obs_data_t *bench_settings(const char *source_name, const struct vec2 *pos_to)
+{
+	obs_data_t *settings = obs_data_create();
+	move_source_filter.get_defaults(settings);
+	obs_data_set_string(settings, S_SOURCE, source_name);
+	obs_data_set_int(settings, S_DURATION, 300 + (long long)(rng_next() % 2000));
+	obs_data_set_int(settings, S_LOOP_MODE, LOOP_MODE_PING_PONG);
+	obs_data_t *pos = obs_data_create();
+	obs_data_set_double(pos, "x", pos_to->x);
+	obs_data_set_double(pos, "y", pos_to->y);
+	obs_data_set_obj(settings, S_POS, pos);
+	obs_data_release(pos);
+	obs_data_t *scale = obs_data_create();
+	obs_data_set_double(scale, "x", 1.0);
+	obs_data_set_double(scale, "y", 1.0);
+	obs_data_set_obj(settings, S_SCALE, scale);
+	obs_data_release(scale);
+	return settings;
+}
+
+static bool bench_on_path(const struct bench_move *move)
+{
+	struct obs_transform_info info;
+	obs_sceneitem_get_info2(move->item, &info);
+	// items start at the origin and move in a straight line towards pos_to
+	const float along = fabsf(move->pos_to.x) > fabsf(move->pos_to.y) ? info.pos.x / move->pos_to.x
+									     : info.pos.y / move->pos_to.y;
+	return along >= -1e-4f && along <= 1.0001f && fabsf(info.pos.x - along * move->pos_to.x) < 1e-2f &&
+	       fabsf(info.pos.y - along * move->pos_to.y) < 1e-2f;
+}
+
+static bool bench(size_t count)
+{
+	fake_obs_reset();
+	rng_state = count;
+	const long allocs = bnum_allocs();
+	move_sources_load();
+
+	obs_scene_t *scenes[BENCH_SCENES];
+	char name[64];
+	for (size_t i = 0; i < BENCH_SCENES; i++) {
+		snprintf(name, sizeof(name), "Scene %zu", i);
+		scenes[i] = fake_scene_create(name, false);
+	}
+	struct bench_move *moves = calloc(count, sizeof(struct bench_move));
+	for (size_t i = 0; i < count; i++) {
+		struct bench_move *move = &moves[i];
+		obs_scene_t *scene = scenes[i % BENCH_SCENES];
+		snprintf(name, sizeof(name), "Item %zu", i);
+		move->item = fake_scene_add(scene, fake_source_create("color_source", name, OBS_SOURCE_TYPE_INPUT, NULL), true);
+		vec2_set(&move->pos_to, (float)(rng_next() % 1920), (float)(1 + rng_next() % 1080));
+		obs_data_t *settings = bench_settings(name, &move->pos_to);
+		snprintf(name, sizeof(name), "Move %zu", i);
+		move->source = fake_source_create(MOVE_SOURCE_FILTER_ID, name, OBS_SOURCE_TYPE_FILTER, settings);
+		fake_source_add_filter(obs_scene_get_source(scene), move->source);
+		move->data = move_source_filter.create(settings, move->source);
+		fake_source_set_data(move->source, move->data);
+		// the deferred update libobs applies on the next frame
+		move_source_filter.update(move->data, settings);
+		obs_data_release(settings);
+	}
+
+	const uint64_t interval = 1000000000ULL / 60;
+	const float seconds = (float)interval / 1000000000.0f;
+	fake_obs_set_video_frame_time(FRAME_BASE);
+	fake_obs_tick(0.0f);
+	for (size_t i = 0; i < count; i++)
+		move_source_start(moves[i].data);
+
+	bool ok = true;
+	uint64_t alloc_calls = 0;
+	uint64_t atomic_updates = 0;
+	uint64_t elapsed = 0;
+	uint64_t best = UINT64_MAX;
+	for (uint64_t frame = 1; frame <= BENCH_FRAMES; frame++) {
+		// the first frame grows the shared arrays, the rest must not allocate
+		if (frame == 2)
+			alloc_calls = fake_obs_alloc_calls();
+		if (frame == BENCH_FRAMES / 2) {
+			// an item whose removal signal has not reached the filter yet is staged without a scene
+			fake_sceneitem_detach(moves[0].item);
+		}
+		fake_obs_set_video_frame_time(FRAME_BASE + frame * interval + rng_next() % (interval / 4));
+		const uint64_t updates = fake_obs_atomic_updates();
+		const uint64_t start = now_ns();
+		fake_obs_tick(seconds);
+		const uint64_t frame_ns = now_ns() - start;
+		elapsed += frame_ns;
+		if (frame_ns < best)
+			best = frame_ns;
+		atomic_updates += fake_obs_atomic_updates() - updates;
+		if (fake_obs_sceneitem_refs() != 0) {
+			fprintf(stderr, "%zu moves: frame %" PRIu64 " left %ld scene item references\n", count, frame,
+				fake_obs_sceneitem_refs());
+			ok = false;
+			break;
+		}
+	}
+	const uint64_t tick_allocs = fake_obs_alloc_calls() - alloc_calls;
+
+	// the first scene has nothing left to commit once its only item is detached
+	const size_t scenes_used = count < BENCH_SCENES ? count : BENCH_SCENES;
+	const uint64_t detached_frames = count <= BENCH_SCENES ? BENCH_FRAMES - BENCH_FRAMES / 2 + 1 : 0;
+	if (ok && atomic_updates != (uint64_t)scenes_used * BENCH_FRAMES - detached_frames) {
+		fprintf(stderr, "%zu moves: %" PRIu64 " scene updates, expected one per scene per frame\n", count,
+			atomic_updates);
+		ok = false;
+	}
+	if (tick_allocs) {
+		fprintf(stderr, "%zu moves: ticks made %" PRIu64 " allocations\n", count, tick_allocs);
+		ok = false;
+	}
+	for (size_t i = 1; i < count; i++) {
+		if (!bench_on_path(&moves[i])) {
+			fprintf(stderr, "%zu moves: item %zu left its path\n", count, i);
+			ok = false;
+			break;
+		}
+	}
+	printf("%6zu moves: %.1f us per frame (best %.1f us), %.1f ns per move, %" PRIu64 " allocations%s\n", count,
+	       (double)elapsed / BENCH_FRAMES / 1000.0, (double)best / 1000.0, (double)elapsed / (double)(count * BENCH_FRAMES),
+	       tick_allocs, ok ? "" : " FAILED");
+
+	for (size_t i = 0; i < count; i++)
+		move_source_filter.destroy(moves[i].data);
+	free(moves);
+	move_sources_unload();
+	fake_obs_reset();
+	if (bnum_allocs() != allocs) {
+		fprintf(stderr, "%zu moves: %ld allocations leaked\n", count, bnum_allocs() - allocs);
+		ok = false;
+	}
+	return ok;
+}
+
+int main(int argc, char **argv)
+{
+	bool ok = true;
+
+	pthread_mutex_init(&udp_servers_mutex, NULL);
+	move_filter_hotkeys_load();
+
+	for (int i = 1; i < argc; i++) {
+		const size_t count = (size_t)strtoull(argv[i], NULL, 10);
+		if (!count) {
+			fprintf(stderr, "usage: %s [moves...]\n", argv[0]);
+			return 2;
+		}
+		ok = bench(count) && ok;
+	}
+	if (argc < 2)
+		ok = bench(200) && ok;
+
+	move_filter_hotkeys_unload();
+	pthread_mutex_destroy(&udp_servers_mutex);
+	return ok ? 0 : 1;
+}
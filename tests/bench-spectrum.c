@@ -0,0 +1,144 @@
+// feeds synthetic audio through the audio move spectrum, checks the band levels and measures the fft per window size
+#include "audio-move-spectrum.h"
+#include "fake-obs.h"
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_SAMPLE_RATE 48000
+#define BENCH_CHANNELS 2
+// what libobs hands to audio capture callbacks at once
+#define BENCH_FRAMES 1024
+#define BENCH_SECONDS 20
+#define LEVEL_TOLERANCE 0.05
+
+static uint64_t rng_state;
+
+static uint64_t rng_next(void)
+{
+	uint64_t z = (rng_state += 0x9e3779b97f4a7c15ULL);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return z ^ (z >> 31);
+}
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+struct bench_tone {
+	double frequency;
+	double amplitude;
+};
+
+// sines on both channels with a little noise so the fft never sees exact zeros
+static void bench_fill(float **planes, uint64_t offset, const struct bench_tone *tones, size_t tones_num)
+{
+	for (uint32_t i = 0; i < BENCH_FRAMES; i++) {
+		const double time = (double)(offset + i) / (double)BENCH_SAMPLE_RATE;
+		double v = 0.0;
+		for (size_t t = 0; t < tones_num; t++)
+			v += tones[t].amplitude * sin(2.0 * M_PI * tones[t].frequency * time);
+		for (size_t ch = 0; ch < BENCH_CHANNELS; ch++) {
+			const double noise = ((double)(rng_next() >> 11) / 9007199254740992.0 - 0.5) * 1e-4;
+			planes[ch][i] = (float)(v + noise);
+		}
+	}
+}
+
+static bool check_level(size_t size, const char *name, float level, double expected)
+{
+	const bool ok = fabs((double)level - expected) <= LEVEL_TOLERANCE * (expected > 0.1 ? expected : 0.1);
+	if (!ok)
+		fprintf(stderr, "%zu window: %s level %.4f, expected %.4f\n", size, name, (double)level, expected);
+	return ok;
+}
+
+static bool bench(size_t size)
+{
+	rng_state = size;
+	const long allocs = bnum_allocs();
+	struct audio_move_spectrum *spectrum = audio_move_spectrum_create(size, BENCH_CHANNELS, BENCH_SAMPLE_RATE);
+
+	float *planes[BENCH_CHANNELS];
+	struct audio_data audio_data = {.frames = BENCH_FRAMES};
+	for (size_t ch = 0; ch < BENCH_CHANNELS; ch++) {
+		planes[ch] = malloc(sizeof(float) * BENCH_FRAMES);
+		audio_data.data[ch] = (uint8_t *)planes[ch];
+	}
+
+	// bass at 100 Hz and a mid tone at 1 kHz, the treble band stays silent
+	const struct bench_tone tones[] = {{100.0, 0.5}, {1000.0, 0.25}};
+	const uint64_t packets = (uint64_t)BENCH_SECONDS * BENCH_SAMPLE_RATE / BENCH_FRAMES;
+	const uint64_t alloc_calls = fake_obs_alloc_calls();
+	uint64_t elapsed = 0;
+	for (uint64_t p = 0; p < packets; p++) {
+		bench_fill(planes, p * BENCH_FRAMES, tones, sizeof(tones) / sizeof(tones[0]));
+		const uint64_t start = now_ns();
+		audio_move_spectrum_capture(spectrum, &audio_data, false);
+		elapsed += now_ns() - start;
+	}
+	const uint64_t capture_allocs = fake_obs_alloc_calls() - alloc_calls;
+
+	uint64_t updates = 0;
+	bool ok = true;
+	// smaller windows have bins too wide to keep the 100 Hz tone inside the bass band
+	if (BENCH_SAMPLE_RATE / size <= 50) {
+		ok = check_level(size, "bass", audio_move_spectrum_band(spectrum, 20.0, 250.0, &updates), 0.5) && ok;
+		ok = check_level(size, "mid", audio_move_spectrum_band(spectrum, 250.0, 4000.0, &updates), 0.25) && ok;
+		ok = check_level(size, "treble", audio_move_spectrum_band(spectrum, 4000.0, 20000.0, &updates), 0.0) && ok;
+	}
+	audio_move_spectrum_band(spectrum, 0.0, 0.0, &updates);
+	const uint64_t expected_updates = packets * BENCH_FRAMES / (size / 2);
+	if (updates != expected_updates) {
+		fprintf(stderr, "%zu window: %" PRIu64 " analyses, expected %" PRIu64 "\n", size, updates, expected_updates);
+		ok = false;
+	}
+	if (capture_allocs) {
+		fprintf(stderr, "%zu window: captures made %" PRIu64 " allocations\n", size, capture_allocs);
+		ok = false;
+	}
+
+	audio_move_spectrum_capture(spectrum, &audio_data, true);
+	for (uint64_t p = 0; p < size / BENCH_FRAMES + 1; p++)
+		audio_move_spectrum_capture(spectrum, &audio_data, true);
+	ok = check_level(size, "muted", audio_move_spectrum_band(spectrum, 0.0, 0.0, &updates), 0.0) && ok;
+
+	const double audio_ns = (double)packets * BENCH_FRAMES * 1e9 / BENCH_SAMPLE_RATE;
+	printf("%6zu window: %.1f us per analysis, %.1f ns per sample, %.4f%% of real time, %" PRIu64 " allocations%s\n", size,
+	       (double)elapsed / (double)expected_updates / 1000.0, (double)elapsed / (double)(packets * BENCH_FRAMES),
+	       100.0 * (double)elapsed / audio_ns, capture_allocs, ok ? "" : " FAILED");
+
+	for (size_t ch = 0; ch < BENCH_CHANNELS; ch++)
+		free(planes[ch]);
+	audio_move_spectrum_destroy(spectrum);
+	if (bnum_allocs() != allocs) {
+		fprintf(stderr, "%zu window: %ld allocations leaked\n", size, bnum_allocs() - allocs);
+		ok = false;
+	}
+	return ok;
+}
+
+int main(int argc, char **argv)
+{
+	bool ok = true;
+	for (int i = 1; i < argc; i++) {
+		const size_t size = (size_t)strtoull(argv[i], NULL, 10);
+		if (size < 4 || (size & (size - 1))) {
+			fprintf(stderr, "usage: %s [window sizes, powers of two...]\n", argv[0]);
+			return 2;
+		}
+		ok = bench(size) && ok;
+	}
+	if (argc < 2) {
+		ok = bench(1024) && ok;
+		ok = bench(2048) && ok;
+	}
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,1004 @@
+#include "fake-obs.h"
+#include "obs-frontend-api.h"
+#include "obs-module.h"
+#include "util/threading.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// fake objects use plain malloc so only allocations made by the code under test are counted
+static uint64_t alloc_calls = 0;
+static long allocs = 0;
+static long sceneitem_refs = 0;
+
+void *bmalloc(size_t size)
+{
+	alloc_calls++;
+	allocs++;
+	return malloc(size ? size : 1);
+}
+
+void *brealloc(void *ptr, size_t size)
+{
+	alloc_calls++;
+	if (!ptr)
+		allocs++;
+	return realloc(ptr, size ? size : 1);
+}
+
+void bfree(void *ptr)
+{
+	if (ptr)
+		allocs--;
+	free(ptr);
+}
+
+long bnum_allocs(void)
+{
+	return allocs;
+}
+
+uint64_t fake_obs_alloc_calls(void)
+{
+	return alloc_calls;
+}
+
+long fake_obs_sceneitem_refs(void)
+{
+	return sceneitem_refs;
+}
+
+void blog(int log_level, const char *format, ...)
+{
+	if (log_level > LOG_WARNING)
+		return;
+	va_list args;
+	va_start(args, format);
+	vfprintf(stderr, format, args);
+	va_end(args);
+	fputc('\n', stderr);
+}
+
+static char *fake_strdup(const char *str)
+{
+	const size_t len = strlen(str ? str : "");
+	char *dup = malloc(len + 1);
+	memcpy(dup, str ? str : "", len + 1);
+	return dup;
+}
+
+enum fake_data_type {
+	FAKE_DATA_STRING,
+	FAKE_DATA_INT,
+	FAKE_DATA_DOUBLE,
+	FAKE_DATA_BOOL,
+	FAKE_DATA_OBJ,
+};
+
+struct fake_data_item {
+	char *name;
+	enum fake_data_type type;
+	char *string;
+	long long integer;
+	double number;
+	bool boolean;
+	obs_data_t *obj;
+};
+
+struct obs_data {
+	long refs;
+	struct fake_data_item *items;
+	size_t num;
+	char *json;
+};
+
+obs_data_t *obs_data_create(void)
+{
+	obs_data_t *data = calloc(1, sizeof(obs_data_t));
+	data->refs = 1;
+	return data;
+}
+
+void obs_data_addref(obs_data_t *data)
+{
+	if (data)
+		data->refs++;
+}
+
+void obs_data_release(obs_data_t *data)
+{
+	if (!data || --data->refs > 0)
+		return;
+	for (size_t i = 0; i < data->num; i++) {
+		free(data->items[i].name);
+		free(data->items[i].string);
+		obs_data_release(data->items[i].obj);
+	}
+	free(data->items);
+	free(data->json);
+	free(data);
+}
+
+static struct fake_data_item *fake_data_find(obs_data_t *data, const char *name)
+{
+	if (!data || !name)
+		return NULL;
+	for (size_t i = 0; i < data->num; i++) {
+		if (strcmp(data->items[i].name, name) == 0)
+			return &data->items[i];
+	}
+	return NULL;
+}
+
+static struct fake_data_item *fake_data_set(obs_data_t *data, const char *name, enum fake_data_type type)
+{
+	struct fake_data_item *item = fake_data_find(data, name);
+	if (!item) {
+		data->items = realloc(data->items, sizeof(struct fake_data_item) * (data->num + 1));
+		item = &data->items[data->num++];
+		memset(item, 0, sizeof(struct fake_data_item));
+		item->name = fake_strdup(name);
+	}
+	free(item->string);
+	item->string = NULL;
+	obs_data_release(item->obj);
+	item->obj = NULL;
+	item->type = type;
+	free(data->json);
+	data->json = NULL;
+	return item;
+}
+
+void obs_data_set_string(obs_data_t *data, const char *name, const char *val)
+{
+	fake_data_set(data, name, FAKE_DATA_STRING)->string = fake_strdup(val);
+}
+
+void obs_data_set_int(obs_data_t *data, const char *name, long long val)
+{
+	fake_data_set(data, name, FAKE_DATA_INT)->integer = val;
+}
+
+void obs_data_set_double(obs_data_t *data, const char *name, double val)
+{
+	fake_data_set(data, name, FAKE_DATA_DOUBLE)->number = val;
+}
+
+void obs_data_set_bool(obs_data_t *data, const char *name, bool val)
+{
+	fake_data_set(data, name, FAKE_DATA_BOOL)->boolean = val;
+}
+
+void obs_data_set_obj(obs_data_t *data, const char *name, obs_data_t *obj)
+{
+	obs_data_addref(obj);
+	fake_data_set(data, name, FAKE_DATA_OBJ)->obj = obj;
+}
+
+const char *obs_data_get_string(obs_data_t *data, const char *name)
+{
+	struct fake_data_item *item = fake_data_find(data, name);
+	return item && item->type == FAKE_DATA_STRING ? item->string : "";
+}
+
+long long obs_data_get_int(obs_data_t *data, const char *name)
+{
+	struct fake_data_item *item = fake_data_find(data, name);
+	if (!item)
+		return 0;
+	return item->type == FAKE_DATA_DOUBLE ? (long long)item->number : item->integer;
+}
+
+double obs_data_get_double(obs_data_t *data, const char *name)
+{
+	struct fake_data_item *item = fake_data_find(data, name);
+	if (!item)
+		return 0.0;
+	return item->type == FAKE_DATA_INT ? (double)item->integer : item->number;
+}
+
+bool obs_data_get_bool(obs_data_t *data, const char *name)
+{
+	struct fake_data_item *item = fake_data_find(data, name);
+	return item && item->type == FAKE_DATA_BOOL && item->boolean;
+}
+
+obs_data_t *obs_data_get_obj(obs_data_t *data, const char *name)
+{
+	struct fake_data_item *item = fake_data_find(data, name);
+	if (!item || item->type != FAKE_DATA_OBJ)
+		return NULL;
+	obs_data_addref(item->obj);
+	return item->obj;
+}
+
+static void fake_json_append(char **json, size_t *len, const char *str)
+{
+	const size_t add = strlen(str);
+	*json = realloc(*json, *len + add + 1);
+	memcpy(*json + *len, str, add + 1);
+	*len += add;
+}
+
+static void fake_json_append_string(char **json, size_t *len, const char *str)
+{
+	fake_json_append(json, len, "\"");
+	for (const char *c = str; *c; c++) {
+		const char part[3] = {*c == '"' || *c == '\\' ? '\\' : *c, *c == '"' || *c == '\\' ? *c : 0, 0};
+		fake_json_append(json, len, part);
+	}
+	fake_json_append(json, len, "\"");
+}
+
+const char *obs_data_get_json(obs_data_t *data)
+{
+	if (!data)
+		return NULL;
+	if (data->json)
+		return data->json;
+	size_t len = 0;
+	fake_json_append(&data->json, &len, "{");
+	for (size_t i = 0; i < data->num; i++) {
+		struct fake_data_item *item = &data->items[i];
+		char value[64];
+		if (i)
+			fake_json_append(&data->json, &len, ",");
+		fake_json_append_string(&data->json, &len, item->name);
+		fake_json_append(&data->json, &len, ":");
+		if (item->type == FAKE_DATA_STRING) {
+			fake_json_append_string(&data->json, &len, item->string);
+			continue;
+		}
+		if (item->type == FAKE_DATA_OBJ) {
+			fake_json_append(&data->json, &len, obs_data_get_json(item->obj));
+			continue;
+		}
+		if (item->type == FAKE_DATA_INT)
+			snprintf(value, sizeof(value), "%lld", item->integer);
+		else if (item->type == FAKE_DATA_DOUBLE)
+			snprintf(value, sizeof(value), "%g", item->number);
+		else
+			snprintf(value, sizeof(value), "%s", item->boolean ? "true" : "false");
+		fake_json_append(&data->json, &len, value);
+	}
+	fake_json_append(&data->json, &len, "}");
+	return data->json;
+}
+
+void obs_data_set_default_int(obs_data_t *data, const char *name, long long val)
+{
+	// the fake has no separate defaults, a default only fills a value that was not set
+	if (!fake_data_find(data, name))
+		obs_data_set_int(data, name, val);
+}
+
+void obs_data_set_default_bool(obs_data_t *data, const char *name, bool val)
+{
+	if (!fake_data_find(data, name))
+		obs_data_set_bool(data, name, val);
+}
+
+void obs_data_set_default_double(obs_data_t *data, const char *name, double val)
+{
+	if (!fake_data_find(data, name))
+		obs_data_set_double(data, name, val);
+}
+
+bool obs_data_has_user_value(obs_data_t *data, const char *name)
+{
+	return fake_data_find(data, name) != NULL;
+}
+
+void obs_data_unset_user_value(obs_data_t *data, const char *name)
+{
+	struct fake_data_item *item = fake_data_find(data, name);
+	if (!item)
+		return;
+	free(item->name);
+	free(item->string);
+	obs_data_release(item->obj);
+	memmove(item, item + 1, sizeof(struct fake_data_item) * (size_t)(data->items + data->num - item - 1));
+	data->num--;
+	free(data->json);
+	data->json = NULL;
+}
+
+struct fake_call_item {
+	const char *name;
+	bool boolean;
+	const char *string;
+	void *ptr;
+};
+
+struct calldata {
+	struct fake_call_item items[4];
+	size_t num;
+};
+
+static const struct fake_call_item *fake_calldata_find(const calldata_t *data, const char *name)
+{
+	for (size_t i = 0; i < data->num; i++) {
+		if (strcmp(data->items[i].name, name) == 0)
+			return &data->items[i];
+	}
+	return NULL;
+}
+
+bool calldata_bool(const calldata_t *data, const char *name)
+{
+	const struct fake_call_item *item = fake_calldata_find(data, name);
+	return item && item->boolean;
+}
+
+const char *calldata_string(const calldata_t *data, const char *name)
+{
+	const struct fake_call_item *item = fake_calldata_find(data, name);
+	return item ? item->string : NULL;
+}
+
+void *calldata_ptr(const calldata_t *data, const char *name)
+{
+	const struct fake_call_item *item = fake_calldata_find(data, name);
+	return item ? item->ptr : NULL;
+}
+
+struct fake_connection {
+	char *signal;
+	signal_callback_t callback;
+	void *data;
+};
+
+struct signal_handler {
+	struct fake_connection *connections;
+	size_t num;
+};
+
+void signal_handler_connect(signal_handler_t *handler, const char *signal, signal_callback_t callback, void *data)
+{
+	if (!handler)
+		return;
+	handler->connections = realloc(handler->connections, sizeof(struct fake_connection) * (handler->num + 1));
+	handler->connections[handler->num].signal = fake_strdup(signal);
+	handler->connections[handler->num].callback = callback;
+	handler->connections[handler->num].data = data;
+	handler->num++;
+}
+
+void signal_handler_disconnect(signal_handler_t *handler, const char *signal, signal_callback_t callback, void *data)
+{
+	if (!handler)
+		return;
+	for (size_t i = 0; i < handler->num; i++) {
+		struct fake_connection *connection = &handler->connections[i];
+		if (connection->callback == callback && connection->data == data && strcmp(connection->signal, signal) == 0) {
+			free(connection->signal);
+			memmove(connection, connection + 1, sizeof(struct fake_connection) * (handler->num - i - 1));
+			handler->num--;
+			return;
+		}
+	}
+}
+
+static void fake_signal_emit(signal_handler_t *handler, const char *signal, calldata_t *data)
+{
+	for (size_t i = 0; i < handler->num; i++) {
+		if (strcmp(handler->connections[i].signal, signal) == 0)
+			handler->connections[i].callback(handler->connections[i].data, data);
+	}
+}
+
+static void fake_signal_free(signal_handler_t *handler)
+{
+	for (size_t i = 0; i < handler->num; i++)
+		free(handler->connections[i].signal);
+	free(handler->connections);
+}
+
+struct obs_source {
+	char *id;
+	char *name;
+	enum obs_source_type type;
+	obs_data_t *settings;
+	bool enabled;
+	bool muted;
+	float volume;
+	void *data;
+	signal_handler_t signals;
+	obs_source_t *parent;
+	obs_scene_t *scene;
+	obs_source_t **filters;
+	size_t filters_num;
+	obs_source_t *next;
+};
+
+struct obs_scene {
+	obs_source_t *source;
+	bool group;
+	obs_sceneitem_t **items;
+	size_t num;
+};
+
+struct obs_scene_item {
+	obs_scene_t *parent;
+	obs_source_t *source;
+	int order_position;
+	bool visible;
+	struct obs_transform_info info;
+	struct obs_sceneitem_crop crop;
+	int defer_update;
+};
+
+static obs_source_t *sources = NULL;
+static obs_sceneitem_t **detached = NULL;
+static size_t detached_num = 0;
+static signal_handler_t global_signals;
+static uint64_t atomic_updates = 0;
+
+obs_source_t *fake_source_create(const char *id, const char *name, enum obs_source_type type, obs_data_t *settings)
+{
+	obs_source_t *source = calloc(1, sizeof(obs_source_t));
+	source->id = fake_strdup(id);
+	source->name = fake_strdup(name);
+	source->type = type;
+	source->enabled = true;
+	source->volume = 1.0f;
+	source->settings = settings ? settings : obs_data_create();
+	if (settings)
+		obs_data_addref(settings);
+	source->next = sources;
+	sources = source;
+	return source;
+}
+
+void fake_source_set_enabled(obs_source_t *source, bool enabled)
+{
+	source->enabled = enabled;
+}
+
+void fake_source_set_data(obs_source_t *source, void *data)
+{
+	source->data = data;
+}
+
+void fake_source_add_filter(obs_source_t *source, obs_source_t *filter)
+{
+	filter->parent = source;
+	source->filters = realloc(source->filters, sizeof(obs_source_t *) * (source->filters_num + 1));
+	source->filters[source->filters_num++] = filter;
+}
+
+obs_scene_t *fake_scene_create(const char *name, bool group)
+{
+	obs_source_t *source = fake_source_create(group ? "group" : "scene", name, OBS_SOURCE_TYPE_SCENE, NULL);
+	source->scene = calloc(1, sizeof(obs_scene_t));
+	source->scene->source = source;
+	source->scene->group = group;
+	return source->scene;
+}
+
+obs_sceneitem_t *fake_scene_add(obs_scene_t *scene, obs_source_t *source, bool visible)
+{
+	obs_sceneitem_t *item = calloc(1, sizeof(obs_sceneitem_t));
+	item->parent = scene;
+	item->source = source;
+	item->order_position = (int)scene->num;
+	item->visible = visible;
+	vec2_set(&item->info.scale, 1.0f, 1.0f);
+	scene->items = realloc(scene->items, sizeof(obs_sceneitem_t *) * (scene->num + 1));
+	scene->items[scene->num++] = item;
+	return item;
+}
+
+void fake_sceneitem_set_scale(obs_sceneitem_t *item, float x, float y)
+{
+	vec2_set(&item->info.scale, x, y);
+}
+
+// like libobs removing an item, the item loses its scene before any remove signal reaches listeners
+void fake_sceneitem_detach(obs_sceneitem_t *item)
+{
+	obs_scene_t *scene = item->parent;
+	if (!scene)
+		return;
+	for (size_t i = 0; i < scene->num; i++) {
+		if (scene->items[i] == item) {
+			memmove(&scene->items[i], &scene->items[i + 1], sizeof(obs_sceneitem_t *) * (scene->num - i - 1));
+			scene->num--;
+			break;
+		}
+	}
+	item->parent = NULL;
+	detached = realloc(detached, sizeof(obs_sceneitem_t *) * (detached_num + 1));
+	detached[detached_num++] = item;
+}
+
+void fake_obs_reset(void)
+{
+	while (sources) {
+		obs_source_t *source = sources;
+		sources = source->next;
+		if (source->scene) {
+			for (size_t i = 0; i < source->scene->num; i++)
+				free(source->scene->items[i]);
+			free(source->scene->items);
+			free(source->scene);
+		}
+		obs_data_release(source->settings);
+		fake_signal_free(&source->signals);
+		free(source->filters);
+		free(source->id);
+		free(source->name);
+		free(source);
+	}
+	for (size_t i = 0; i < detached_num; i++)
+		free(detached[i]);
+	free(detached);
+	detached = NULL;
+	detached_num = 0;
+	fake_signal_free(&global_signals);
+	memset(&global_signals, 0, sizeof(global_signals));
+	sceneitem_refs = 0;
+	atomic_updates = 0;
+}
+
+const char *obs_source_get_name(const obs_source_t *source)
+{
+	return source ? source->name : NULL;
+}
+
+const char *obs_source_get_unversioned_id(const obs_source_t *source)
+{
+	return source ? source->id : NULL;
+}
+
+enum obs_source_type obs_source_get_type(const obs_source_t *source)
+{
+	return source ? source->type : OBS_SOURCE_TYPE_INPUT;
+}
+
+obs_data_t *obs_source_get_settings(const obs_source_t *source)
+{
+	if (!source)
+		return NULL;
+	obs_data_addref(source->settings);
+	return source->settings;
+}
+
+bool obs_source_enabled(const obs_source_t *source)
+{
+	return source && source->enabled;
+}
+
+// like libobs the enable signal is emitted on the thread that changes the state
+void obs_source_set_enabled(obs_source_t *source, bool enabled)
+{
+	if (!source || source->enabled == enabled)
+		return;
+	source->enabled = enabled;
+	calldata_t data = {.items = {{.name = "source", .ptr = source}, {.name = "enabled", .boolean = enabled}}, .num = 2};
+	fake_signal_emit(&source->signals, "enable", &data);
+}
+
+bool obs_source_removed(const obs_source_t *source)
+{
+	UNUSED_PARAMETER(source);
+	return false;
+}
+
+// sources are owned by the fake until fake_obs_reset, so references are not counted
+obs_source_t *obs_source_get_ref(obs_source_t *source)
+{
+	return source;
+}
+
+void obs_source_release(obs_source_t *source)
+{
+	UNUSED_PARAMETER(source);
+}
+
+// libobs defers the update of video sources to the next frame, tests apply it through the source info themselves
+void obs_source_update(obs_source_t *source, obs_data_t *settings)
+{
+	UNUSED_PARAMETER(source);
+	UNUSED_PARAMETER(settings);
+}
+
+uint32_t obs_source_get_output_flags(const obs_source_t *source)
+{
+	UNUSED_PARAMETER(source);
+	return OBS_SOURCE_VIDEO;
+}
+
+uint32_t obs_source_get_width(obs_source_t *source)
+{
+	return source && source->scene ? 1920 : 0;
+}
+
+uint32_t obs_source_get_height(obs_source_t *source)
+{
+	return source && source->scene ? 1080 : 0;
+}
+
+void obs_source_skip_video_filter(obs_source_t *filter)
+{
+	UNUSED_PARAMETER(filter);
+}
+
+float obs_source_get_volume(const obs_source_t *source)
+{
+	return source ? source->volume : 0.0f;
+}
+
+void obs_source_set_volume(obs_source_t *source, float volume)
+{
+	if (source)
+		source->volume = volume;
+}
+
+bool obs_source_muted(const obs_source_t *source)
+{
+	return source && source->muted;
+}
+
+void obs_source_set_muted(obs_source_t *source, bool muted)
+{
+	if (source)
+		source->muted = muted;
+}
+
+// the fake has no media sources
+enum obs_media_state obs_source_media_get_state(obs_source_t *source)
+{
+	UNUSED_PARAMETER(source);
+	return OBS_MEDIA_STATE_NONE;
+}
+
+int64_t obs_source_media_get_duration(obs_source_t *source)
+{
+	UNUSED_PARAMETER(source);
+	return 0;
+}
+
+void obs_source_media_set_time(obs_source_t *source, int64_t ms)
+{
+	UNUSED_PARAMETER(source);
+	UNUSED_PARAMETER(ms);
+}
+
+void obs_source_media_play_pause(obs_source_t *source, bool pause)
+{
+	UNUSED_PARAMETER(source);
+	UNUSED_PARAMETER(pause);
+}
+
+void obs_source_media_restart(obs_source_t *source)
+{
+	UNUSED_PARAMETER(source);
+}
+
+void obs_source_media_stop(obs_source_t *source)
+{
+	UNUSED_PARAMETER(source);
+}
+
+void obs_source_media_next(obs_source_t *source)
+{
+	UNUSED_PARAMETER(source);
+}
+
+void obs_source_media_previous(obs_source_t *source)
+{
+	UNUSED_PARAMETER(source);
+}
+
+signal_handler_t *obs_source_get_signal_handler(const obs_source_t *source)
+{
+	return source ? (signal_handler_t *)&source->signals : NULL;
+}
+
+obs_source_t *obs_filter_get_parent(const obs_source_t *filter)
+{
+	return filter ? filter->parent : NULL;
+}
+
+obs_source_t *obs_source_get_filter_by_name(obs_source_t *source, const char *name)
+{
+	if (!source || !name)
+		return NULL;
+	for (size_t i = 0; i < source->filters_num; i++) {
+		if (strcmp(source->filters[i]->name, name) == 0)
+			return source->filters[i];
+	}
+	return NULL;
+}
+
+void *obs_obj_get_data(void *obj)
+{
+	return obj ? ((obs_source_t *)obj)->data : NULL;
+}
+
+bool obs_source_is_scene(const obs_source_t *source)
+{
+	return source && source->scene && !source->scene->group;
+}
+
+bool obs_source_is_group(const obs_source_t *source)
+{
+	return source && source->scene && source->scene->group;
+}
+
+void obs_source_enum_filters(obs_source_t *source, obs_source_enum_proc_t callback, void *param)
+{
+	if (!source)
+		return;
+	for (size_t i = 0; i < source->filters_num; i++)
+		callback(source, source->filters[i], param);
+}
+
+obs_scene_t *obs_scene_from_source(const obs_source_t *source)
+{
+	return obs_source_is_scene(source) ? source->scene : NULL;
+}
+
+obs_scene_t *obs_group_from_source(const obs_source_t *source)
+{
+	return obs_source_is_group(source) ? source->scene : NULL;
+}
+
+obs_source_t *obs_scene_get_source(const obs_scene_t *scene)
+{
+	return scene ? scene->source : NULL;
+}
+
+void obs_scene_release(obs_scene_t *scene)
+{
+	UNUSED_PARAMETER(scene);
+}
+
+void obs_scene_enum_items(obs_scene_t *scene, bool (*callback)(obs_scene_t *, obs_sceneitem_t *, void *), void *param)
+{
+	if (!scene)
+		return;
+	for (size_t i = 0; i < scene->num; i++) {
+		if (!callback(scene, scene->items[i], param))
+			break;
+	}
+}
+
+obs_sceneitem_t *obs_scene_find_source(obs_scene_t *scene, const char *name)
+{
+	if (!scene || !name)
+		return NULL;
+	for (size_t i = 0; i < scene->num; i++) {
+		if (strcmp(scene->items[i]->source->name, name) == 0)
+			return scene->items[i];
+	}
+	return NULL;
+}
+
+// the fake has no scene mutex, counting the updates is what lets tests see how commits are batched
+void obs_scene_atomic_update(obs_scene_t *scene, obs_scene_atomic_update_func func, void *data)
+{
+	if (!scene)
+		return;
+	atomic_updates++;
+	func(data, scene);
+}
+
+uint64_t fake_obs_atomic_updates(void)
+{
+	return atomic_updates;
+}
+
+void obs_sceneitem_addref(obs_sceneitem_t *item)
+{
+	if (item)
+		sceneitem_refs++;
+}
+
+void obs_sceneitem_release(obs_sceneitem_t *item)
+{
+	if (item)
+		sceneitem_refs--;
+}
+
+obs_source_t *obs_sceneitem_get_source(const obs_sceneitem_t *item)
+{
+	return item ? item->source : NULL;
+}
+
+obs_scene_t *obs_sceneitem_get_scene(const obs_sceneitem_t *item)
+{
+	return item ? item->parent : NULL;
+}
+
+bool obs_sceneitem_visible(const obs_sceneitem_t *item)
+{
+	return item && item->visible;
+}
+
+void obs_sceneitem_set_visible(obs_sceneitem_t *item, bool visible)
+{
+	if (item)
+		item->visible = visible;
+}
+
+void obs_sceneitem_get_scale(const obs_sceneitem_t *item, struct vec2 *scale)
+{
+	*scale = item->info.scale;
+}
+
+void obs_sceneitem_get_pos(const obs_sceneitem_t *item, struct vec2 *pos)
+{
+	*pos = item->info.pos;
+}
+
+float obs_sceneitem_get_rot(const obs_sceneitem_t *item)
+{
+	return item->info.rot;
+}
+
+enum obs_bounds_type obs_sceneitem_get_bounds_type(const obs_sceneitem_t *item)
+{
+	return item->info.bounds_type;
+}
+
+void obs_sceneitem_get_bounds(const obs_sceneitem_t *item, struct vec2 *bounds)
+{
+	*bounds = item->info.bounds;
+}
+
+void obs_sceneitem_get_crop(const obs_sceneitem_t *item, struct obs_sceneitem_crop *crop)
+{
+	*crop = item->crop;
+}
+
+void obs_sceneitem_set_crop(obs_sceneitem_t *item, const struct obs_sceneitem_crop *crop)
+{
+	item->crop = *crop;
+}
+
+void obs_sceneitem_get_info2(const obs_sceneitem_t *item, struct obs_transform_info *info)
+{
+	*info = item->info;
+}
+
+void obs_sceneitem_set_info2(obs_sceneitem_t *item, const struct obs_transform_info *info)
+{
+	item->info = *info;
+}
+
+void obs_sceneitem_defer_update_begin(obs_sceneitem_t *item)
+{
+	item->defer_update++;
+}
+
+void obs_sceneitem_defer_update_end(obs_sceneitem_t *item)
+{
+	item->defer_update--;
+}
+
+// libobs walks the item list here, the fake keeps the position so large benchmarks measure the plugin code
+int obs_sceneitem_get_order_position(obs_sceneitem_t *item)
+{
+	return item ? item->order_position : 0;
+}
+
+void obs_sceneitem_set_order_position(obs_sceneitem_t *item, int position)
+{
+	if (item)
+		item->order_position = position;
+}
+
+void obs_sceneitem_set_order(obs_sceneitem_t *item, enum obs_order_movement movement)
+{
+	if (!item)
+		return;
+	if (movement == OBS_ORDER_MOVE_UP)
+		item->order_position++;
+	else if (movement == OBS_ORDER_MOVE_DOWN && item->order_position > 0)
+		item->order_position--;
+}
+
+signal_handler_t *obs_get_signal_handler(void)
+{
+	return &global_signals;
+}
+
+obs_source_t *obs_get_source_by_name(const char *name)
+{
+	for (obs_source_t *source = sources; source && name; source = source->next) {
+		if (source->type != OBS_SOURCE_TYPE_FILTER && strcmp(source->name, name) == 0)
+			return source;
+	}
+	return NULL;
+}
+
+struct fake_tick_callback {
+	void (*tick)(void *param, float seconds);
+	void *param;
+};
+
+static struct fake_tick_callback tick_callbacks[8];
+static size_t tick_callbacks_num = 0;
+
+void obs_add_tick_callback(void (*tick)(void *param, float seconds), void *param)
+{
+	if (tick_callbacks_num < sizeof(tick_callbacks) / sizeof(tick_callbacks[0]))
+		tick_callbacks[tick_callbacks_num++] = (struct fake_tick_callback){tick, param};
+}
+
+void obs_remove_tick_callback(void (*tick)(void *param, float seconds), void *param)
+{
+	for (size_t i = 0; i < tick_callbacks_num; i++) {
+		if (tick_callbacks[i].tick == tick && tick_callbacks[i].param == param) {
+			tick_callbacks[i] = tick_callbacks[--tick_callbacks_num];
+			return;
+		}
+	}
+}
+
+// runs the tick callbacks the way the video thread does once per frame
+void fake_obs_tick(float seconds)
+{
+	for (size_t i = 0; i < tick_callbacks_num; i++)
+		tick_callbacks[i].tick(tick_callbacks[i].param, seconds);
+}
+
+static uint64_t video_frame_time = 0;
+
+void fake_obs_set_video_frame_time(uint64_t frame_time)
+{
+	video_frame_time = frame_time;
+}
+
+uint64_t obs_get_video_frame_time(void)
+{
+	return video_frame_time;
+}
+
+int obs_frontend_get_transition_duration(void)
+{
+	return 300;
+}
+
+const char *obs_module_text(const char *lookup_string)
+{
+	return lookup_string;
+}
+
+void os_set_thread_name(const char *name)
+{
+	UNUSED_PARAMETER(name);
+}
+
+static obs_hotkey_id hotkey_id = 0;
+
+obs_hotkey_id obs_hotkey_register_source(obs_source_t *source, const char *name, const char *description, obs_hotkey_func func,
+					 void *data)
+{
+	UNUSED_PARAMETER(source);
+	UNUSED_PARAMETER(name);
+	UNUSED_PARAMETER(description);
+	UNUSED_PARAMETER(func);
+	UNUSED_PARAMETER(data);
+	return hotkey_id++;
+}
+
+void obs_hotkey_unregister(obs_hotkey_id id)
+{
+	UNUSED_PARAMETER(id);
+}
+
+void obs_hotkey_set_name(obs_hotkey_id id, const char *name)
+{
+	UNUSED_PARAMETER(id);
+	UNUSED_PARAMETER(name);
+}
+
+void obs_hotkey_set_description(obs_hotkey_id id, const char *desc)
+{
+	UNUSED_PARAMETER(id);
+	UNUSED_PARAMETER(desc);
+}
@@ -0,0 +1,159 @@
+#include "obs-properties.h"
+
+// plugin units build their properties through these, the fake has no property ui so nothing is created
+
+obs_properties_t *obs_properties_create(void)
+{
+	return NULL;
+}
+
+obs_property_t *obs_properties_get(obs_properties_t *props, const char *property)
+{
+	UNUSED_PARAMETER(props);
+	UNUSED_PARAMETER(property);
+	return NULL;
+}
+
+obs_property_t *obs_properties_add_bool(obs_properties_t *props, const char *name, const char *description)
+{
+	UNUSED_PARAMETER(props);
+	UNUSED_PARAMETER(name);
+	UNUSED_PARAMETER(description);
+	return NULL;
+}
+
+obs_property_t *obs_properties_add_int(obs_properties_t *props, const char *name, const char *description, int min, int max,
+				       int step)
+{
+	UNUSED_PARAMETER(props);
+	UNUSED_PARAMETER(name);
+	UNUSED_PARAMETER(description);
+	UNUSED_PARAMETER(min);
+	UNUSED_PARAMETER(max);
+	UNUSED_PARAMETER(step);
+	return NULL;
+}
+
+obs_property_t *obs_properties_add_float_slider(obs_properties_t *props, const char *name, const char *description, double min,
+					       double max, double step)
+{
+	UNUSED_PARAMETER(props);
+	UNUSED_PARAMETER(name);
+	UNUSED_PARAMETER(description);
+	UNUSED_PARAMETER(min);
+	UNUSED_PARAMETER(max);
+	UNUSED_PARAMETER(step);
+	return NULL;
+}
+
+obs_property_t *obs_properties_add_text(obs_properties_t *props, const char *name, const char *description,
+					enum obs_text_type type)
+{
+	UNUSED_PARAMETER(props);
+	UNUSED_PARAMETER(name);
+	UNUSED_PARAMETER(description);
+	UNUSED_PARAMETER(type);
+	return NULL;
+}
+
+obs_property_t *obs_properties_add_list(obs_properties_t *props, const char *name, const char *description,
+					enum obs_combo_type type, enum obs_combo_format format)
+{
+	UNUSED_PARAMETER(props);
+	UNUSED_PARAMETER(name);
+	UNUSED_PARAMETER(description);
+	UNUSED_PARAMETER(type);
+	UNUSED_PARAMETER(format);
+	return NULL;
+}
+
+obs_property_t *obs_properties_add_button(obs_properties_t *props, const char *name, const char *text,
+					  obs_property_clicked_t callback)
+{
+	UNUSED_PARAMETER(props);
+	UNUSED_PARAMETER(name);
+	UNUSED_PARAMETER(text);
+	UNUSED_PARAMETER(callback);
+	return NULL;
+}
+
+obs_property_t *obs_properties_add_group(obs_properties_t *props, const char *name, const char *description,
+					 enum obs_group_type type, obs_properties_t *group)
+{
+	UNUSED_PARAMETER(props);
+	UNUSED_PARAMETER(name);
+	UNUSED_PARAMETER(description);
+	UNUSED_PARAMETER(type);
+	UNUSED_PARAMETER(group);
+	return NULL;
+}
+
+bool obs_property_visible(obs_property_t *p)
+{
+	UNUSED_PARAMETER(p);
+	return false;
+}
+
+void obs_property_set_visible(obs_property_t *p, bool visible)
+{
+	UNUSED_PARAMETER(p);
+	UNUSED_PARAMETER(visible);
+}
+
+void obs_property_set_long_description(obs_property_t *p, const char *long_description)
+{
+	UNUSED_PARAMETER(p);
+	UNUSED_PARAMETER(long_description);
+}
+
+void obs_property_int_set_suffix(obs_property_t *p, const char *suffix)
+{
+	UNUSED_PARAMETER(p);
+	UNUSED_PARAMETER(suffix);
+}
+
+void obs_property_float_set_suffix(obs_property_t *p, const char *suffix)
+{
+	UNUSED_PARAMETER(p);
+	UNUSED_PARAMETER(suffix);
+}
+
+void obs_property_text_set_info_type(obs_property_t *p, enum obs_text_info_type type)
+{
+	UNUSED_PARAMETER(p);
+	UNUSED_PARAMETER(type);
+}
+
+void obs_property_set_modified_callback(obs_property_t *p, obs_property_modified_t modified)
+{
+	UNUSED_PARAMETER(p);
+	UNUSED_PARAMETER(modified);
+}
+
+void obs_property_set_modified_callback2(obs_property_t *p, obs_property_modified2_t modified, void *priv)
+{
+	UNUSED_PARAMETER(p);
+	UNUSED_PARAMETER(modified);
+	UNUSED_PARAMETER(priv);
+}
+
+void obs_property_list_clear(obs_property_t *p)
+{
+	UNUSED_PARAMETER(p);
+}
+
+size_t obs_property_list_add_string(obs_property_t *p, const char *name, const char *val)
+{
+	UNUSED_PARAMETER(p);
+	UNUSED_PARAMETER(name);
+	UNUSED_PARAMETER(val);
+	return 0;
+}
+
+size_t obs_property_list_add_int(obs_property_t *p, const char *name, long long val)
+{
+	UNUSED_PARAMETER(p);
+	UNUSED_PARAMETER(name);
+	UNUSED_PARAMETER(val);
+	return 0;
+}
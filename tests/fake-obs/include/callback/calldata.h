@@ -0,0 +1,9 @@
+#pragma once
+
+#include "../util/c99defs.h"
+
+typedef struct calldata calldata_t;
+
+bool calldata_bool(const calldata_t *data, const char *name);
+const char *calldata_string(const calldata_t *data, const char *name);
+void *calldata_ptr(const calldata_t *data, const char *name);
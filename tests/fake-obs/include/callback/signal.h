@@ -0,0 +1,9 @@
+#pragma once
+
+#include "calldata.h"
+
+typedef struct signal_handler signal_handler_t;
+typedef void (*signal_callback_t)(void *data, calldata_t *cd);
+
+void signal_handler_connect(signal_handler_t *handler, const char *signal, signal_callback_t callback, void *data);
+void signal_handler_disconnect(signal_handler_t *handler, const char *signal, signal_callback_t callback, void *data);
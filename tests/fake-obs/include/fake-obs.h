@@ -0,0 +1,21 @@
+#pragma once
+
+// helpers for tests to build the objects that libobs would normally own
+#include "obs.h"
+
+void fake_obs_reset(void);
+uint64_t fake_obs_alloc_calls(void);
+long fake_obs_sceneitem_refs(void);
+void fake_obs_set_video_frame_time(uint64_t frame_time);
+uint64_t fake_obs_atomic_updates(void);
+void fake_obs_tick(float seconds);
+
+obs_source_t *fake_source_create(const char *id, const char *name, enum obs_source_type type, obs_data_t *settings);
+void fake_source_set_enabled(obs_source_t *source, bool enabled);
+void fake_source_set_data(obs_source_t *source, void *data);
+void fake_source_add_filter(obs_source_t *source, obs_source_t *filter);
+
+obs_scene_t *fake_scene_create(const char *name, bool group);
+obs_sceneitem_t *fake_scene_add(obs_scene_t *scene, obs_source_t *source, bool visible);
+void fake_sceneitem_set_scale(obs_sceneitem_t *item, float x, float y);
+void fake_sceneitem_detach(obs_sceneitem_t *item);
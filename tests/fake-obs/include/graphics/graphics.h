@@ -0,0 +1,8 @@
+#pragma once
+
+#include "vec2.h"
+#include "vec4.h"
+
+typedef struct gs_texture_render gs_texrender_t;
+typedef struct gs_sampler_state gs_samplerstate_t;
+typedef struct gs_effect gs_effect_t;
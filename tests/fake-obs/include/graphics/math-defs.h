@@ -0,0 +1,14 @@
+#pragma once
+
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.1415926535897932384626433832795
+#endif
+
+#define RAD(val) ((val) * 0.0174532925199432957692369076848f)
+#define DEG(val) ((val) * 57.295779513082320876798154814105f)
+#define LARGE_EPSILON 1e-2f
+#define EPSILON 1e-4f
+#define TINY_EPSILON 1e-5f
+#define M_INFINITE 3.4e38f
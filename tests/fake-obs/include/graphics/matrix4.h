@@ -0,0 +1,7 @@
+#pragma once
+
+#include "vec4.h"
+
+struct matrix4 {
+	struct vec4 x, y, z, t;
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+struct vec2 {
+	union {
+		struct {
+			float x, y;
+		};
+		float ptr[2];
+	};
+};
+
+static inline void vec2_set(struct vec2 *dst, float x, float y)
+{
+	dst->x = x;
+	dst->y = y;
+}
+
+static inline void vec2_copy(struct vec2 *dst, const struct vec2 *v)
+{
+	dst->x = v->x;
+	dst->y = v->y;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stdint.h>
+#include "math-defs.h"
+
+struct vec4 {
+	union {
+		struct {
+			float x, y, z, w;
+		};
+		float ptr[4];
+	};
+};
+
+static inline void vec4_set(struct vec4 *dst, float x, float y, float z, float w)
+{
+	dst->x = x;
+	dst->y = y;
+	dst->z = z;
+	dst->w = w;
+}
+
+static inline void vec4_from_rgba(struct vec4 *dst, uint32_t rgba)
+{
+	dst->x = (float)(rgba & 0xFF) / 255.0f;
+	dst->y = (float)((rgba >> 8) & 0xFF) / 255.0f;
+	dst->z = (float)((rgba >> 16) & 0xFF) / 255.0f;
+	dst->w = (float)((rgba >> 24) & 0xFF) / 255.0f;
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+#include "obs.h"
+
+int obs_frontend_get_transition_duration(void);
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "util/c99defs.h"
+
+typedef struct obs_source obs_source_t;
+typedef struct obs_hotkey obs_hotkey_t;
+typedef size_t obs_hotkey_id;
+
+#define OBS_INVALID_HOTKEY_ID (~(obs_hotkey_id)0)
+
+typedef void (*obs_hotkey_func)(void *data, obs_hotkey_id id, obs_hotkey_t *hotkey, bool pressed);
+
+obs_hotkey_id obs_hotkey_register_source(obs_source_t *source, const char *name, const char *description, obs_hotkey_func func,
+					 void *data);
+void obs_hotkey_unregister(obs_hotkey_id id);
+void obs_hotkey_set_name(obs_hotkey_id id, const char *name);
+void obs_hotkey_set_description(obs_hotkey_id id, const char *desc);
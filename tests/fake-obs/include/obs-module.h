@@ -0,0 +1,5 @@
+#pragma once
+
+#include "obs.h"
+
+const char *obs_module_text(const char *lookup_string);
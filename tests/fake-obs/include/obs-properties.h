@@ -0,0 +1,74 @@
+#pragma once
+
+#include "util/c99defs.h"
+
+// only declared so plugin units that build their properties link, the fake never creates any
+typedef struct obs_data obs_data_t;
+typedef struct obs_properties obs_properties_t;
+typedef struct obs_property obs_property_t;
+
+enum obs_combo_type {
+	OBS_COMBO_TYPE_INVALID,
+	OBS_COMBO_TYPE_EDITABLE,
+	OBS_COMBO_TYPE_LIST,
+	OBS_COMBO_TYPE_RADIO,
+};
+
+enum obs_combo_format {
+	OBS_COMBO_FORMAT_INVALID,
+	OBS_COMBO_FORMAT_INT,
+	OBS_COMBO_FORMAT_FLOAT,
+	OBS_COMBO_FORMAT_STRING,
+	OBS_COMBO_FORMAT_BOOL,
+};
+
+enum obs_text_type {
+	OBS_TEXT_DEFAULT,
+	OBS_TEXT_PASSWORD,
+	OBS_TEXT_MULTILINE,
+	OBS_TEXT_INFO,
+};
+
+enum obs_text_info_type {
+	OBS_TEXT_INFO_NORMAL,
+	OBS_TEXT_INFO_WARNING,
+	OBS_TEXT_INFO_ERROR,
+};
+
+enum obs_group_type {
+	OBS_COMBO_INVALID,
+	OBS_GROUP_NORMAL,
+	OBS_GROUP_CHECKABLE,
+};
+
+typedef bool (*obs_property_clicked_t)(obs_properties_t *props, obs_property_t *property, void *data);
+typedef bool (*obs_property_modified_t)(obs_properties_t *props, obs_property_t *property, obs_data_t *settings);
+typedef bool (*obs_property_modified2_t)(void *priv, obs_properties_t *props, obs_property_t *property, obs_data_t *settings);
+
+obs_properties_t *obs_properties_create(void);
+obs_property_t *obs_properties_get(obs_properties_t *props, const char *property);
+obs_property_t *obs_properties_add_bool(obs_properties_t *props, const char *name, const char *description);
+obs_property_t *obs_properties_add_int(obs_properties_t *props, const char *name, const char *description, int min, int max,
+				       int step);
+obs_property_t *obs_properties_add_float_slider(obs_properties_t *props, const char *name, const char *description, double min,
+					       double max, double step);
+obs_property_t *obs_properties_add_text(obs_properties_t *props, const char *name, const char *description,
+					enum obs_text_type type);
+obs_property_t *obs_properties_add_list(obs_properties_t *props, const char *name, const char *description,
+					enum obs_combo_type type, enum obs_combo_format format);
+obs_property_t *obs_properties_add_button(obs_properties_t *props, const char *name, const char *text,
+					  obs_property_clicked_t callback);
+obs_property_t *obs_properties_add_group(obs_properties_t *props, const char *name, const char *description,
+					 enum obs_group_type type, obs_properties_t *group);
+
+bool obs_property_visible(obs_property_t *p);
+void obs_property_set_visible(obs_property_t *p, bool visible);
+void obs_property_set_long_description(obs_property_t *p, const char *long_description);
+void obs_property_int_set_suffix(obs_property_t *p, const char *suffix);
+void obs_property_float_set_suffix(obs_property_t *p, const char *suffix);
+void obs_property_text_set_info_type(obs_property_t *p, enum obs_text_info_type type);
+void obs_property_set_modified_callback(obs_property_t *p, obs_property_modified_t modified);
+void obs_property_set_modified_callback2(obs_property_t *p, obs_property_modified2_t modified, void *priv);
+void obs_property_list_clear(obs_property_t *p);
+size_t obs_property_list_add_string(obs_property_t *p, const char *name, const char *val);
+size_t obs_property_list_add_int(obs_property_t *p, const char *name, long long val);
@@ -0,0 +1,205 @@
+#pragma once
+
+// declarations of the libobs api used by the code under test, implemented by fake-obs.c
+#include "util/c99defs.h"
+#include "util/bmem.h"
+#include "util/base.h"
+#include "graphics/graphics.h"
+#include "callback/signal.h"
+#include "obs-hotkey.h"
+#include "obs-properties.h"
+
+typedef struct obs_source obs_source_t;
+typedef struct obs_weak_source obs_weak_source_t;
+typedef struct obs_scene obs_scene_t;
+typedef struct obs_scene_item obs_sceneitem_t;
+typedef struct obs_data obs_data_t;
+typedef struct obs_data_array obs_data_array_t;
+
+enum obs_source_type {
+	OBS_SOURCE_TYPE_INPUT,
+	OBS_SOURCE_TYPE_FILTER,
+	OBS_SOURCE_TYPE_TRANSITION,
+	OBS_SOURCE_TYPE_SCENE,
+};
+
+enum obs_transition_scale_type {
+	OBS_TRANSITION_SCALE_MAX_ONLY,
+	OBS_TRANSITION_SCALE_ASPECT,
+	OBS_TRANSITION_SCALE_STRETCH,
+};
+
+enum obs_bounds_type {
+	OBS_BOUNDS_NONE,
+	OBS_BOUNDS_STRETCH,
+	OBS_BOUNDS_SCALE_INNER,
+	OBS_BOUNDS_SCALE_OUTER,
+	OBS_BOUNDS_SCALE_TO_WIDTH,
+	OBS_BOUNDS_SCALE_TO_HEIGHT,
+	OBS_BOUNDS_MAX_ONLY,
+};
+
+enum obs_order_movement {
+	OBS_ORDER_MOVE_UP,
+	OBS_ORDER_MOVE_DOWN,
+	OBS_ORDER_MOVE_TOP,
+	OBS_ORDER_MOVE_BOTTOM,
+};
+
+enum obs_media_state {
+	OBS_MEDIA_STATE_NONE,
+	OBS_MEDIA_STATE_PLAYING,
+	OBS_MEDIA_STATE_OPENING,
+	OBS_MEDIA_STATE_BUFFERING,
+	OBS_MEDIA_STATE_PAUSED,
+	OBS_MEDIA_STATE_STOPPED,
+	OBS_MEDIA_STATE_ENDED,
+	OBS_MEDIA_STATE_ERROR,
+};
+
+#define OBS_SOURCE_VIDEO (1 << 0)
+#define OBS_SOURCE_AUDIO (1 << 1)
+#define OBS_SOURCE_CONTROLLABLE_MEDIA (1 << 13)
+
+#define MAX_AV_PLANES 8
+#define MAX_AUDIO_CHANNELS 8
+
+struct audio_data {
+	uint8_t *data[MAX_AV_PLANES];
+	uint32_t frames;
+	uint64_t timestamp;
+};
+
+struct obs_sceneitem_crop {
+	int left;
+	int top;
+	int right;
+	int bottom;
+};
+
+struct obs_transform_info {
+	struct vec2 pos;
+	float rot;
+	struct vec2 scale;
+	uint32_t alignment;
+	enum obs_bounds_type bounds_type;
+	uint32_t bounds_alignment;
+	struct vec2 bounds;
+	bool crop_to_bounds;
+};
+
+// only the callbacks the plugin units under test fill in
+struct obs_source_info {
+	const char *id;
+	enum obs_source_type type;
+	uint32_t output_flags;
+	const char *(*get_name)(void *type_data);
+	void *(*create)(obs_data_t *settings, obs_source_t *source);
+	void (*destroy)(void *data);
+	uint32_t (*get_width)(void *data);
+	uint32_t (*get_height)(void *data);
+	void (*get_defaults)(obs_data_t *settings);
+	obs_properties_t *(*get_properties)(void *data);
+	void (*update)(void *data, obs_data_t *settings);
+	void (*activate)(void *data);
+	void (*deactivate)(void *data);
+	void (*show)(void *data);
+	void (*hide)(void *data);
+	void (*video_tick)(void *data, float seconds);
+	void (*video_render)(void *data, gs_effect_t *effect);
+	void (*save)(void *data, obs_data_t *settings);
+	void (*load)(void *data, obs_data_t *settings);
+	void (*filter_add)(void *data, obs_source_t *source);
+	void (*filter_remove)(void *data, obs_source_t *source);
+};
+
+obs_data_t *obs_data_create(void);
+void obs_data_addref(obs_data_t *data);
+void obs_data_release(obs_data_t *data);
+const char *obs_data_get_json(obs_data_t *data);
+void obs_data_set_string(obs_data_t *data, const char *name, const char *val);
+void obs_data_set_int(obs_data_t *data, const char *name, long long val);
+void obs_data_set_double(obs_data_t *data, const char *name, double val);
+void obs_data_set_bool(obs_data_t *data, const char *name, bool val);
+const char *obs_data_get_string(obs_data_t *data, const char *name);
+long long obs_data_get_int(obs_data_t *data, const char *name);
+double obs_data_get_double(obs_data_t *data, const char *name);
+bool obs_data_get_bool(obs_data_t *data, const char *name);
+void obs_data_set_default_int(obs_data_t *data, const char *name, long long val);
+void obs_data_set_default_bool(obs_data_t *data, const char *name, bool val);
+void obs_data_set_default_double(obs_data_t *data, const char *name, double val);
+bool obs_data_has_user_value(obs_data_t *data, const char *name);
+void obs_data_unset_user_value(obs_data_t *data, const char *name);
+void obs_data_set_obj(obs_data_t *data, const char *name, obs_data_t *obj);
+obs_data_t *obs_data_get_obj(obs_data_t *data, const char *name);
+
+void *obs_obj_get_data(void *obj);
+uint64_t obs_get_video_frame_time(void);
+signal_handler_t *obs_get_signal_handler(void);
+obs_source_t *obs_get_source_by_name(const char *name);
+void obs_add_tick_callback(void (*tick)(void *param, float seconds), void *param);
+void obs_remove_tick_callback(void (*tick)(void *param, float seconds), void *param);
+
+const char *obs_source_get_name(const obs_source_t *source);
+const char *obs_source_get_unversioned_id(const obs_source_t *source);
+enum obs_source_type obs_source_get_type(const obs_source_t *source);
+obs_data_t *obs_source_get_settings(const obs_source_t *source);
+bool obs_source_enabled(const obs_source_t *source);
+void obs_source_set_enabled(obs_source_t *source, bool enabled);
+bool obs_source_removed(const obs_source_t *source);
+obs_source_t *obs_source_get_ref(obs_source_t *source);
+void obs_source_release(obs_source_t *source);
+void obs_source_update(obs_source_t *source, obs_data_t *settings);
+uint32_t obs_source_get_output_flags(const obs_source_t *source);
+uint32_t obs_source_get_width(obs_source_t *source);
+uint32_t obs_source_get_height(obs_source_t *source);
+void obs_source_skip_video_filter(obs_source_t *filter);
+float obs_source_get_volume(const obs_source_t *source);
+void obs_source_set_volume(obs_source_t *source, float volume);
+bool obs_source_muted(const obs_source_t *source);
+void obs_source_set_muted(obs_source_t *source, bool muted);
+enum obs_media_state obs_source_media_get_state(obs_source_t *source);
+int64_t obs_source_media_get_duration(obs_source_t *source);
+void obs_source_media_set_time(obs_source_t *source, int64_t ms);
+void obs_source_media_play_pause(obs_source_t *source, bool pause);
+void obs_source_media_restart(obs_source_t *source);
+void obs_source_media_stop(obs_source_t *source);
+void obs_source_media_next(obs_source_t *source);
+void obs_source_media_previous(obs_source_t *source);
+signal_handler_t *obs_source_get_signal_handler(const obs_source_t *source);
+obs_source_t *obs_filter_get_parent(const obs_source_t *filter);
+obs_source_t *obs_source_get_filter_by_name(obs_source_t *source, const char *name);
+bool obs_source_is_scene(const obs_source_t *source);
+bool obs_source_is_group(const obs_source_t *source);
+typedef void (*obs_source_enum_proc_t)(obs_source_t *parent, obs_source_t *child, void *param);
+void obs_source_enum_filters(obs_source_t *source, obs_source_enum_proc_t callback, void *param);
+
+obs_scene_t *obs_scene_from_source(const obs_source_t *source);
+obs_scene_t *obs_group_from_source(const obs_source_t *source);
+obs_source_t *obs_scene_get_source(const obs_scene_t *scene);
+void obs_scene_release(obs_scene_t *scene);
+void obs_scene_enum_items(obs_scene_t *scene, bool (*callback)(obs_scene_t *, obs_sceneitem_t *, void *), void *param);
+obs_sceneitem_t *obs_scene_find_source(obs_scene_t *scene, const char *name);
+typedef void (*obs_scene_atomic_update_func)(void *, obs_scene_t *scene);
+void obs_scene_atomic_update(obs_scene_t *scene, obs_scene_atomic_update_func func, void *data);
+
+void obs_sceneitem_addref(obs_sceneitem_t *item);
+void obs_sceneitem_release(obs_sceneitem_t *item);
+obs_source_t *obs_sceneitem_get_source(const obs_sceneitem_t *item);
+obs_scene_t *obs_sceneitem_get_scene(const obs_sceneitem_t *item);
+bool obs_sceneitem_visible(const obs_sceneitem_t *item);
+void obs_sceneitem_get_scale(const obs_sceneitem_t *item, struct vec2 *scale);
+int obs_sceneitem_get_order_position(obs_sceneitem_t *item);
+void obs_sceneitem_set_visible(obs_sceneitem_t *item, bool visible);
+void obs_sceneitem_set_order(obs_sceneitem_t *item, enum obs_order_movement movement);
+void obs_sceneitem_set_order_position(obs_sceneitem_t *item, int position);
+void obs_sceneitem_get_pos(const obs_sceneitem_t *item, struct vec2 *pos);
+float obs_sceneitem_get_rot(const obs_sceneitem_t *item);
+enum obs_bounds_type obs_sceneitem_get_bounds_type(const obs_sceneitem_t *item);
+void obs_sceneitem_get_bounds(const obs_sceneitem_t *item, struct vec2 *bounds);
+void obs_sceneitem_get_crop(const obs_sceneitem_t *item, struct obs_sceneitem_crop *crop);
+void obs_sceneitem_set_crop(obs_sceneitem_t *item, const struct obs_sceneitem_crop *crop);
+void obs_sceneitem_get_info2(const obs_sceneitem_t *item, struct obs_transform_info *info);
+void obs_sceneitem_set_info2(obs_sceneitem_t *item, const struct obs_transform_info *info);
+void obs_sceneitem_defer_update_begin(obs_sceneitem_t *item);
+void obs_sceneitem_defer_update_end(obs_sceneitem_t *item);
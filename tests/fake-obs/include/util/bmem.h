@@ -0,0 +1,34 @@
+#pragma once
+
+#include "c99defs.h"
+#include <string.h>
+
+void *bmalloc(size_t size);
+void *brealloc(void *ptr, size_t size);
+void bfree(void *ptr);
+long bnum_allocs(void);
+
+static inline void *bzalloc(size_t size)
+{
+	void *mem = bmalloc(size);
+	if (mem)
+		memset(mem, 0, size);
+	return mem;
+}
+
+static inline char *bstrdup_n(const char *str, size_t n)
+{
+	if (!str)
+		return NULL;
+	char *dup = (char *)bmalloc(n + 1);
+	memcpy(dup, str, n);
+	dup[n] = 0;
+	return dup;
+}
+
+static inline char *bstrdup(const char *str)
+{
+	if (!str)
+		return NULL;
+	return bstrdup_n(str, strlen(str));
+}
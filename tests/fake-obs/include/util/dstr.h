@@ -0,0 +1,44 @@
+#pragma once
+
+#include "bmem.h"
+
+struct dstr {
+	char *array;
+	size_t len;
+	size_t capacity;
+};
+
+static inline void dstr_free(struct dstr *dst)
+{
+	bfree(dst->array);
+	dst->array = NULL;
+	dst->len = 0;
+	dst->capacity = 0;
+}
+
+static inline void dstr_ncat(struct dstr *dst, const char *array, size_t len)
+{
+	if (!array || !len)
+		return;
+	if (dst->len + len + 1 > dst->capacity) {
+		dst->capacity = (dst->len + len + 1) * 2;
+		dst->array = (char *)brealloc(dst->array, dst->capacity);
+	}
+	memcpy(dst->array + dst->len, array, len);
+	dst->len += len;
+	dst->array[dst->len] = 0;
+}
+
+static inline void dstr_cat(struct dstr *dst, const char *array)
+{
+	if (array)
+		dstr_ncat(dst, array, strlen(array));
+}
+
+static inline void dstr_copy(struct dstr *dst, const char *array)
+{
+	if (dst->array)
+		dst->array[0] = 0;
+	dst->len = 0;
+	dstr_cat(dst, array);
+}
@@ -0,0 +1,186 @@
+#include "move-color.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+static int failures = 0;
+
+#define CHECK_NEAR(what, value, expected, tolerance)                                                                  \
+	do {                                                                                                            \
+		const double v = (value);                                                                               \
+		const double e = (expected);                                                                            \
+		if (fabs(v - e) > (tolerance)) {                                                                        \
+			fprintf(stderr, "%s:%d %s: got %.6f expected %.6f\n", __FILE__, __LINE__, what, v, e);         \
+			failures++;                                                                                     \
+		}                                                                                                       \
+	} while (false)
+
+static float srgb_to_linear(float x)
+{
+	return x <= 0.04045f ? x / 12.92f : powf((x + 0.055f) / 1.055f, 2.4f);
+}
+
+static void srgb(struct vec4 *dst, float r, float g, float b)
+{
+	vec4_set(dst, srgb_to_linear(r), srgb_to_linear(g), srgb_to_linear(b), 1.0f);
+}
+
+static double lch_chroma(const struct vec4 *lab)
+{
+	return sqrt((double)lab->y * lab->y + (double)lab->z * lab->z);
+}
+
+static double lch_hue(const struct vec4 *lab)
+{
+	const double h = atan2(lab->z, lab->y) * 180.0 / M_PI;
+	return h < 0.0 ? h + 360.0 : h;
+}
+
+static void lch(struct vec4 *dst, float l, float c, float h)
+{
+	struct vec4 lab;
+	vec4_set(&lab, l, c * cosf(h * (float)M_PI / 180.0f), c * sinf(h * (float)M_PI / 180.0f), 1.0f);
+	oklab_to_linear(dst, &lab);
+}
+
+// reference values from the CSS Color 4 OKLab conversion
+static const struct {
+	const char *name;
+	float r, g, b;
+	double l, a, bb, c, h;
+} references[] = {
+	{"white", 1.0f, 1.0f, 1.0f, 1.0, 0.0, 0.0, 0.0, -1.0},
+	{"red", 1.0f, 0.0f, 0.0f, 0.627955, 0.224863, 0.125846, 0.257683, 29.2339},
+	{"green", 0.0f, 1.0f, 0.0f, 0.866440, -0.233888, 0.179498, 0.294827, 142.4953},
+	{"blue", 0.0f, 0.0f, 1.0f, 0.452014, -0.032457, -0.311528, 0.313214, 264.0520},
+	{"gray", 0.5f, 0.5f, 0.5f, 0.598181, 0.0, 0.0, 0.0, -1.0},
+};
+
+static void test_references(void)
+{
+	for (size_t i = 0; i < sizeof(references) / sizeof(references[0]); i++) {
+		struct vec4 color;
+		struct vec4 lab;
+		srgb(&color, references[i].r, references[i].g, references[i].b);
+		linear_to_oklab(&lab, &color);
+		CHECK_NEAR(references[i].name, lab.x, references[i].l, 5e-4);
+		CHECK_NEAR(references[i].name, lab.y, references[i].a, 5e-4);
+		CHECK_NEAR(references[i].name, lab.z, references[i].bb, 5e-4);
+		CHECK_NEAR(references[i].name, lch_chroma(&lab), references[i].c, 5e-4);
+		if (references[i].h >= 0.0)
+			CHECK_NEAR(references[i].name, lch_hue(&lab), references[i].h, 0.05);
+
+		struct vec4 back;
+		oklab_to_linear(&back, &lab);
+		for (size_t j = 0; j < 4; j++)
+			CHECK_NEAR(references[i].name, back.ptr[j], color.ptr[j], 1e-4);
+	}
+}
+
+static void test_linear_mix(void)
+{
+	struct vec4 from, to, mid;
+	vec4_set(&from, 0.0f, 0.2f, 1.0f, 0.0f);
+	vec4_set(&to, 1.0f, 0.6f, 0.0f, 1.0f);
+	color_mix(&mid, &from, &to, 0.25f, MOVE_VALUE_COLOR_SPACE_LINEAR);
+	CHECK_NEAR("linear x", mid.x, 0.25, 1e-6);
+	CHECK_NEAR("linear y", mid.y, 0.3, 1e-6);
+	CHECK_NEAR("linear z", mid.z, 0.75, 1e-6);
+	CHECK_NEAR("linear w", mid.w, 0.25, 1e-6);
+}
+
+static void test_endpoints(void)
+{
+	const long long spaces[] = {MOVE_VALUE_COLOR_SPACE_LINEAR, MOVE_VALUE_COLOR_SPACE_OKLAB, MOVE_VALUE_COLOR_SPACE_OKLCH};
+	struct vec4 from, to, mix;
+	srgb(&from, 1.0f, 0.5f, 0.0f);
+	srgb(&to, 0.2f, 0.4f, 0.9f);
+	for (size_t i = 0; i < 3; i++) {
+		color_mix(&mix, &from, &to, 0.0f, spaces[i]);
+		for (size_t j = 0; j < 4; j++)
+			CHECK_NEAR("endpoint from", mix.ptr[j], from.ptr[j], 1e-4);
+		color_mix(&mix, &from, &to, 1.0f, spaces[i]);
+		for (size_t j = 0; j < 4; j++)
+			CHECK_NEAR("endpoint to", mix.ptr[j], to.ptr[j], 1e-4);
+	}
+}
+
+static void test_oklab_mix(void)
+{
+	struct vec4 from, to, mix, lab, lab_from, lab_to;
+	srgb(&from, 1.0f, 0.0f, 0.0f);
+	srgb(&to, 0.0f, 0.0f, 1.0f);
+	color_mix(&mix, &from, &to, 0.5f, MOVE_VALUE_COLOR_SPACE_OKLAB);
+	linear_to_oklab(&lab, &mix);
+	linear_to_oklab(&lab_from, &from);
+	linear_to_oklab(&lab_to, &to);
+	CHECK_NEAR("oklab L", lab.x, (lab_from.x + lab_to.x) / 2.0, 1e-3);
+	CHECK_NEAR("oklab a", lab.y, (lab_from.y + lab_to.y) / 2.0, 1e-3);
+	CHECK_NEAR("oklab b", lab.z, (lab_from.z + lab_to.z) / 2.0, 1e-3);
+}
+
+static void test_oklch_hue_shortest_path(void)
+{
+	struct vec4 from, to, mix, lab;
+
+	// 340 and 20 degrees meet at 0, not at 180
+	lch(&from, 0.6f, 0.1f, 340.0f);
+	lch(&to, 0.6f, 0.1f, 20.0f);
+	color_mix(&mix, &from, &to, 0.5f, MOVE_VALUE_COLOR_SPACE_OKLCH);
+	linear_to_oklab(&lab, &mix);
+	CHECK_NEAR("zero L", lab.x, 0.6, 1e-3);
+	CHECK_NEAR("zero C", lch_chroma(&lab), 0.1, 1e-3);
+	CHECK_NEAR("zero h", fmod(lch_hue(&lab) + 180.0, 360.0), 180.0, 0.1);
+
+	// 160 and 200 degrees have to wrap around the atan2 seam and meet at 180, not at 0
+	lch(&from, 0.6f, 0.1f, 160.0f);
+	lch(&to, 0.6f, 0.1f, 200.0f);
+	color_mix(&mix, &from, &to, 0.5f, MOVE_VALUE_COLOR_SPACE_OKLCH);
+	linear_to_oklab(&lab, &mix);
+	CHECK_NEAR("wrap C", lch_chroma(&lab), 0.1, 1e-3);
+	CHECK_NEAR("wrap h", lch_hue(&lab), 180.0, 0.1);
+
+	// the same pair the other way around
+	color_mix(&mix, &to, &from, 0.25f, MOVE_VALUE_COLOR_SPACE_OKLCH);
+	linear_to_oklab(&lab, &mix);
+	CHECK_NEAR("wrap back h", lch_hue(&lab), 190.0, 0.1);
+
+	// red to blue goes through magenta, the midpoint is clamped to the gamut so only the hue range is checked
+	srgb(&from, 1.0f, 0.0f, 0.0f);
+	srgb(&to, 0.0f, 0.0f, 1.0f);
+	color_mix(&mix, &from, &to, 0.5f, MOVE_VALUE_COLOR_SPACE_OKLCH);
+	linear_to_oklab(&lab, &mix);
+	const double hue = lch_hue(&lab);
+	if (hue < 290.0 || hue > 350.0) {
+		fprintf(stderr, "red to blue midpoint hue %.2f is not on the magenta side\n", hue);
+		failures++;
+	}
+}
+
+static void test_oklch_gray_keeps_hue(void)
+{
+	struct vec4 from, to, mix, lab, lab_to;
+	srgb(&from, 1.0f, 1.0f, 1.0f);
+	lch(&to, 0.7f, 0.1f, 200.0f);
+	linear_to_oklab(&lab_to, &to);
+	color_mix(&mix, &from, &to, 0.5f, MOVE_VALUE_COLOR_SPACE_OKLCH);
+	linear_to_oklab(&lab, &mix);
+	CHECK_NEAR("gray h", lch_hue(&lab), lch_hue(&lab_to), 0.5);
+	CHECK_NEAR("gray C", lch_chroma(&lab), 0.05, 1e-3);
+}
+
+int main(void)
+{
+	test_references();
+	test_linear_mix();
+	test_endpoints();
+	test_oklab_mix();
+	test_oklch_hue_shortest_path();
+	test_oklch_gray_keeps_hue();
+	if (failures) {
+		fprintf(stderr, "%d color checks failed\n", failures);
+		return 1;
+	}
+	printf("color checks passed\n");
+	return 0;
+}
@@ -0,0 +1,576 @@
+// steps move_filter_tick through scripted video frame times, checks the produced t against the timeline and measures tick cost
+#include "move-transition.h"
+#include "fake-obs.h"
+#include <util/threading.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#define FRAME_BASE 1000000000000ULL
+#define FRAME_MAX 200000
+#define T_TOLERANCE 1e-6
+#define BENCH_FRAMES 600
+
+// set up by the module load in move-transition.c
+extern pthread_mutex_t udp_servers_mutex;
+void move_filter_hotkeys_load(void);
+void move_filter_hotkeys_unload(void);
+
+static uint64_t rng_state;
+
+static uint64_t rng_next(void)
+{
+	uint64_t z = (rng_state += 0x9e3779b97f4a7c15ULL);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return z ^ (z >> 31);
+}
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+struct tick_scenario {
+	const char *name;
+	// frames per second as a fraction so 59.94 is exact
+	uint64_t fps_num;
+	uint64_t fps_den;
+	uint64_t duration;
+	uint64_t start_delay;
+	uint64_t end_delay;
+	long long loop_mode;
+	long long loop_count;
+	// the end of the first move starts a second one with the same timing
+	bool chain;
+	// started by enabling the filter so the start goes through the enable signal
+	bool enable;
+	// percent of the frame interval the frame times move around
+	uint64_t jitter;
+	// about one in so many frames drops one to three frames
+	uint64_t drop;
+};
+
+static const struct tick_scenario scenarios[] = {
+	{"60fps", 60, 1, 1000, 0, 0, LOOP_MODE_NONE, 0, false, false, 0, 0},
+	{"59.94fps", 60000, 1001, 1000, 0, 0, LOOP_MODE_NONE, 0, false, false, 0, 0},
+	{"240fps-delays", 240, 1, 700, 150, 250, LOOP_MODE_NONE, 0, false, false, 0, 0},
+	{"jitter", 60, 1, 1000, 100, 0, LOOP_MODE_NONE, 0, false, false, 40, 0},
+	{"dropped", 60, 1, 1000, 0, 100, LOOP_MODE_NONE, 0, false, false, 0, 7},
+	{"jitter-dropped-240fps", 240, 1, 500, 0, 0, LOOP_MODE_NONE, 0, false, false, 30, 5},
+	{"ping-pong", 240, 1, 400, 50, 100, LOOP_MODE_PING_PONG, 3, false, false, 20, 11},
+	{"ping-pong-even", 60, 1, 400, 50, 100, LOOP_MODE_PING_PONG, 2, false, false, 20, 11},
+	{"loop", 30, 1, 333, 0, 0, LOOP_MODE_LOOP, 4, false, false, 0, 3},
+	{"chain", 60, 1, 250, 0, 0, LOOP_MODE_NONE, 0, true, false, 25, 4},
+	{"enable", 60, 1, 500, 0, 0, LOOP_MODE_NONE, 0, false, true, 10, 0},
+	{"long", 60, 1, 600000, 0, 0, LOOP_MODE_NONE, 0, false, false, 5, 0},
+};
+
+struct tick_filter {
+	struct move_filter move_filter;
+	obs_source_t *source;
+};
+
+// what a derived filter does in its start callback before setting up its own state
+static void tick_filter_start(void *data)
+{
+	move_filter_start_internal(data);
+}
+
+static void tick_filter_create(struct tick_filter *filter, obs_source_t *parent, const char *name, obs_data_t *settings,
+			       bool enabled)
+{
+	memset(filter, 0, sizeof(*filter));
+	filter->source = fake_source_create(MOVE_VALUE_FILTER_ID, name, OBS_SOURCE_TYPE_FILTER, settings);
+	fake_source_set_enabled(filter->source, enabled);
+	fake_source_set_data(filter->source, &filter->move_filter);
+	fake_source_add_filter(parent, filter->source);
+	move_filter_init(&filter->move_filter, filter->source, tick_filter_start);
+	move_filter_update(&filter->move_filter, settings);
+}
+
+static obs_data_t *tick_settings(const struct tick_scenario *scenario, const char *next_move)
+{
+	obs_data_t *settings = obs_data_create();
+	move_filter_defaults(settings);
+	obs_data_set_bool(settings, S_ENABLED_MATCH_MOVING, scenario->enable);
+	obs_data_set_bool(settings, S_CUSTOM_DURATION, true);
+	obs_data_set_int(settings, S_DURATION, (long long)scenario->duration);
+	obs_data_set_int(settings, S_START_DELAY, (long long)scenario->start_delay);
+	obs_data_set_int(settings, S_END_DELAY, (long long)scenario->end_delay);
+	obs_data_set_int(settings, S_LOOP_MODE, scenario->loop_mode);
+	obs_data_set_int(settings, S_LOOP_COUNT, scenario->loop_count);
+	obs_data_set_string(settings, S_NEXT_MOVE, next_move);
+	return settings;
+}
+
+// like a derived filter tick, the end of the move is handled after the last t was used
+static bool tick_filter_tick(struct tick_filter *filter, float seconds, float *t)
+{
+	if (!move_filter_tick(&filter->move_filter, seconds, t))
+		return false;
+	if (!filter->move_filter.moving)
+		move_filter_ended(&filter->move_filter);
+	return true;
+}
+
+struct tick_sample {
+	uint64_t frame_time;
+	uint64_t elapsed;
+	size_t filter;
+	float t;
+};
+
+struct tick_curve {
+	struct tick_sample *samples;
+	size_t num;
+	size_t capacity;
+};
+
+static void tick_curve_add(struct tick_curve *curve, uint64_t frame_time, uint64_t elapsed, size_t filter, float t)
+{
+	if (curve->num == curve->capacity) {
+		curve->capacity = curve->capacity ? curve->capacity * 2 : 1024;
+		curve->samples = realloc(curve->samples, sizeof(struct tick_sample) * curve->capacity);
+	}
+	curve->samples[curve->num++] = (struct tick_sample){frame_time, elapsed, filter, t};
+}
+
+static bool write_curve(const char *dir, const char *name, const struct tick_curve *curve)
+{
+	if (mkdir(dir, 0755) != 0 && errno != EEXIST) {
+		fprintf(stderr, "unable to create %s\n", dir);
+		return false;
+	}
+	char path[1024];
+	snprintf(path, sizeof(path), "%s/%s.csv", dir, name);
+	FILE *file = fopen(path, "w");
+	if (!file) {
+		fprintf(stderr, "unable to write %s\n", path);
+		return false;
+	}
+	fprintf(file, "frame_time,elapsed,filter,t\n");
+	for (size_t i = 0; i < curve->num; i++) {
+		const struct tick_sample *sample = &curve->samples[i];
+		fprintf(file, "%" PRIu64 ",%" PRIu64 ",%zu,%.9f\n", sample->frame_time, sample->elapsed, sample->filter,
+			(double)sample->t);
+	}
+	fclose(file);
+	return true;
+}
+
+static uint64_t scenario_cycles(const struct tick_scenario *scenario)
+{
+	return scenario->loop_mode != LOOP_MODE_NONE && scenario->loop_count ? (uint64_t)scenario->loop_count : 1;
+}
+
+static uint64_t scenario_total(const struct tick_scenario *scenario)
+{
+	return (scenario->start_delay + scenario->duration + scenario->end_delay) * 1000000ULL;
+}
+
+// t the timeline asks for after elapsed ns of a move that has not ended yet, false while it waits in a delay
+// except on the frame a loop wrapped on, that one already shows the start of the next cycle
+static bool expected_t(const struct tick_scenario *scenario, uint64_t elapsed, bool wrapped, double *t)
+{
+	const uint64_t total = scenario_total(scenario);
+	const uint64_t cycle = elapsed / total;
+	const uint64_t offset = elapsed % total;
+	const bool reverse = scenario->loop_mode == LOOP_MODE_PING_PONG && (cycle & 1);
+	const uint64_t delay = (reverse ? scenario->end_delay : scenario->start_delay) * 1000000ULL;
+	if (offset < delay && !wrapped)
+		return false;
+	double progress = offset < delay ? 0.0 : (double)(offset - delay) / (double)(scenario->duration * 1000000ULL);
+	if (progress > 1.0)
+		progress = 1.0;
+	*t = reverse ? 1.0 - progress : progress;
+	return true;
+}
+
+static float expected_end(const struct tick_scenario *scenario)
+{
+	return scenario->loop_mode == LOOP_MODE_PING_PONG && !(scenario_cycles(scenario) & 1) ? 0.0f : 1.0f;
+}
+
+struct tick_state {
+	bool ended;
+	uint64_t cycle;
+};
+
+// compares one tick of a filter with the timeline, elapsed is the time since the move of that filter started
+static bool check_tick(const struct tick_scenario *scenario, struct tick_state *state, size_t filter, uint64_t elapsed,
+		       bool produced, float t, bool was_moving, bool moving, double *max_error)
+{
+	if (elapsed >= scenario_cycles(scenario) * scenario_total(scenario)) {
+		// the first frame at or past the end stops the move on exactly its end value
+		state->ended = true;
+		if (produced && t == expected_end(scenario) && was_moving && !moving)
+			return true;
+		fprintf(stderr, "%s: filter %zu at %" PRIu64 " ns produced %d t %.9f moving %d, expected end %.1f\n",
+			scenario->name, filter, elapsed, produced, (double)t, moving, (double)expected_end(scenario));
+		return false;
+	}
+	const uint64_t cycle = elapsed / scenario_total(scenario);
+	double expected;
+	const bool active = expected_t(scenario, elapsed, cycle != state->cycle, &expected);
+	state->cycle = cycle;
+	if (produced != active || !moving) {
+		fprintf(stderr, "%s: filter %zu at %" PRIu64 " ns produced %d moving %d, expected %d\n", scenario->name, filter,
+			elapsed, produced, moving, active);
+		return false;
+	}
+	if (!produced)
+		return true;
+	const double error = fabs((double)t - expected);
+	if (error > *max_error)
+		*max_error = error;
+	if (error <= T_TOLERANCE)
+		return true;
+	fprintf(stderr, "%s: filter %zu at %" PRIu64 " ns t %.9f expected %.9f\n", scenario->name, filter, elapsed, (double)t,
+		expected);
+	return false;
+}
+
+static uint64_t frame_time_at(const struct tick_scenario *scenario, uint64_t frame)
+{
+	return FRAME_BASE + frame * scenario->fps_den * 1000000000ULL / scenario->fps_num;
+}
+
+static bool run_scenario(const struct tick_scenario *scenario, const char *curves_dir)
+{
+	fake_obs_reset();
+	rng_state = 0x5eed;
+	const long allocs = bnum_allocs();
+
+	obs_source_t *parent = fake_source_create("color_source", "Source", OBS_SOURCE_TYPE_INPUT, NULL);
+	obs_data_t *settings = tick_settings(scenario, scenario->chain ? "Move B" : "");
+	obs_data_t *settings_b = tick_settings(scenario, "");
+	struct tick_filter filters[2];
+	const size_t filter_count = scenario->chain ? 2 : 1;
+	tick_filter_create(&filters[0], parent, "Move A", settings, !scenario->enable);
+	if (scenario->chain)
+		tick_filter_create(&filters[1], parent, "Move B", settings_b, true);
+
+	const uint64_t interval = scenario->fps_den * 1000000000ULL / scenario->fps_num;
+	const uint64_t end = scenario_cycles(scenario) * scenario_total(scenario);
+	struct tick_curve curve = {0};
+	uint64_t start_time = 0;
+	uint64_t previous_time = FRAME_BASE;
+	uint64_t frame = 0;
+	uint64_t frames = 0;
+	uint64_t ticks_after_end = 0;
+	double max_error = 0.0;
+	struct tick_state states[2] = {{false, 0}, {false, 0}};
+	bool ok = true;
+
+	while (ok && frame < FRAME_MAX && ticks_after_end < 5) {
+		uint64_t frame_time = frame_time_at(scenario, frame);
+		if (scenario->jitter && frame) {
+			const uint64_t range = interval * scenario->jitter / 100;
+			frame_time = frame_time - range + rng_next() % (2 * range + 1);
+		}
+		// the wall clock seconds passed to the tick are noisy, only the frame times may drive the move
+		const double noise = 0.5 + (double)(rng_next() % 100) / 100.0;
+		const float seconds = (float)((double)(frame_time - previous_time) / 1000000000.0 * noise);
+		previous_time = frame_time;
+		fake_obs_set_video_frame_time(frame_time);
+
+		// frame 0 lets the filters see their initial enabled state, the move starts on frame 1
+		if (frame == 1) {
+			start_time = frame_time;
+			if (scenario->enable)
+				obs_source_set_enabled(filters[0].source, true);
+			else
+				move_filter_start(&filters[0].move_filter);
+		}
+
+		const uint64_t elapsed = start_time ? frame_time - start_time : 0;
+		for (size_t i = 0; i < filter_count && ok; i++) {
+			const bool was_moving = filters[i].move_filter.moving;
+			float t = -1.0f;
+			const bool produced = tick_filter_tick(&filters[i], seconds, &t);
+			const bool moving = filters[i].move_filter.moving;
+			if (!start_time || states[i].ended)
+				continue;
+			// the chained move runs on the time the first one ran past its end
+			if (i == 1 && elapsed < end) {
+				if (produced) {
+					fprintf(stderr, "%s: chained move produced t %.9f early\n", scenario->name, (double)t);
+					ok = false;
+				}
+				continue;
+			}
+			const uint64_t move_elapsed = i == 1 ? elapsed - end : elapsed;
+			if (produced)
+				tick_curve_add(&curve, frame_time, move_elapsed, i, t);
+			ok = check_tick(scenario, &states[i], i, move_elapsed, produced, t, was_moving, moving, &max_error);
+		}
+		if (states[filter_count - 1].ended)
+			ticks_after_end++;
+
+		frames++;
+		frame++;
+		if (scenario->drop && frame > 1 && rng_next() % scenario->drop == 0)
+			frame += 1 + rng_next() % 3;
+	}
+
+	if (ok && !states[filter_count - 1].ended) {
+		fprintf(stderr, "%s: move did not end after %" PRIu64 " frames\n", scenario->name, frames);
+		ok = false;
+	}
+	for (size_t i = 0; i < filter_count && ok; i++) {
+		if (filters[i].move_filter.moving) {
+			fprintf(stderr, "%s: filter %zu still moving after its end\n", scenario->name, i);
+			ok = false;
+		}
+	}
+	if (ok && curves_dir)
+		ok = write_curve(curves_dir, scenario->name, &curve);
+
+	printf("%-24s %7" PRIu64 " frames %7zu samples, max t error %.2e%s\n", scenario->name, frames, curve.num, max_error,
+	       ok ? "" : " FAILED");
+
+	for (size_t i = 0; i < filter_count; i++)
+		move_filter_destroy(&filters[i].move_filter);
+	obs_data_release(settings);
+	obs_data_release(settings_b);
+	free(curve.samples);
+	fake_obs_reset();
+	if (bnum_allocs() != allocs) {
+		fprintf(stderr, "%s: %ld allocations leaked\n", scenario->name, bnum_allocs() - allocs);
+		ok = false;
+	}
+	return ok;
+}
+
+// a ping-pong stopped in a reverse cycle and one that ended on a reverse cycle both have to start forward again
+static bool run_restart(const struct tick_scenario *scenario)
+{
+	fake_obs_reset();
+	const long allocs = bnum_allocs();
+
+	obs_source_t *parent = fake_source_create("color_source", "Source", OBS_SOURCE_TYPE_INPUT, NULL);
+	obs_data_t *settings = tick_settings(scenario, "");
+	struct tick_filter filter;
+	tick_filter_create(&filter, parent, "Move A", settings, true);
+
+	uint64_t frame = 0;
+	float t;
+	fake_obs_set_video_frame_time(frame_time_at(scenario, frame++));
+	tick_filter_tick(&filter, 0.0f, &t);
+
+	const uint64_t total = scenario_total(scenario);
+	uint64_t start_time = frame_time_at(scenario, frame);
+	fake_obs_set_video_frame_time(start_time);
+	move_filter_start(&filter.move_filter);
+	while (frame_time_at(scenario, frame) - start_time < total + total / 2) {
+		fake_obs_set_video_frame_time(frame_time_at(scenario, frame++));
+		tick_filter_tick(&filter, 0.0f, &t);
+	}
+	bool ok = filter.move_filter.moving && filter.move_filter.reverse;
+	if (!ok)
+		fprintf(stderr, "%s restart: the move did not reach its reverse cycle\n", scenario->name);
+	move_filter_stop(&filter.move_filter);
+
+	double max_error = 0.0;
+	for (size_t run = 0; run < 2 && ok; run++) {
+		struct tick_state state = {false, 0};
+		start_time = frame_time_at(scenario, frame);
+		fake_obs_set_video_frame_time(start_time);
+		move_filter_start(&filter.move_filter);
+		while (ok && !state.ended) {
+			const uint64_t frame_time = frame_time_at(scenario, frame++);
+			fake_obs_set_video_frame_time(frame_time);
+			const bool was_moving = filter.move_filter.moving;
+			t = -1.0f;
+			const bool produced = tick_filter_tick(&filter, 0.0f, &t);
+			ok = check_tick(scenario, &state, 0, frame_time - start_time, produced, t, was_moving,
+					filter.move_filter.moving, &max_error);
+		}
+	}
+	printf("%-24s restarted forward%s\n", scenario->name, ok ? "" : " FAILED");
+
+	move_filter_destroy(&filter.move_filter);
+	obs_data_release(settings);
+	fake_obs_reset();
+	if (bnum_allocs() != allocs) {
+		fprintf(stderr, "%s restart: %ld allocations leaked\n", scenario->name, bnum_allocs() - allocs);
+		ok = false;
+	}
+	return ok;
+}
+
+// turning a running move around keeps t where it was and runs it back to exactly 0
+static bool run_turn_around(void)
+{
+	const struct tick_scenario scenario = {"turn-around", 60, 1, 1000, 100, 200, LOOP_MODE_NONE, 0, false, false, 0, 0};
+	fake_obs_reset();
+	const long allocs = bnum_allocs();
+
+	obs_source_t *parent = fake_source_create("color_source", "Source", OBS_SOURCE_TYPE_INPUT, NULL);
+	obs_data_t *settings = tick_settings(&scenario, "");
+	struct tick_filter filter;
+	tick_filter_create(&filter, parent, "Move A", settings, true);
+
+	uint64_t frame = 0;
+	float t = 0.0f;
+	fake_obs_set_video_frame_time(frame_time_at(&scenario, frame++));
+	tick_filter_tick(&filter, 0.0f, &t);
+	const uint64_t start_time = frame_time_at(&scenario, frame);
+	fake_obs_set_video_frame_time(start_time);
+	move_filter_start(&filter.move_filter);
+	while (frame_time_at(&scenario, frame) - start_time < 400000000ULL) {
+		fake_obs_set_video_frame_time(frame_time_at(&scenario, frame++));
+		tick_filter_tick(&filter, 0.0f, &t);
+	}
+
+	const float step = 1000.0f / 60.0f / (float)scenario.duration;
+	float previous = t;
+	move_filter_turn_around(&filter.move_filter);
+	bool ok = true;
+	uint64_t frames = 0;
+	while (ok && filter.move_filter.moving && frames++ < 200) {
+		fake_obs_set_video_frame_time(frame_time_at(&scenario, frame++));
+		if (!tick_filter_tick(&filter, 0.0f, &t))
+			continue;
+		if (t > previous || previous - t > step * 1.01f) {
+			fprintf(stderr, "turn-around: t went from %.6f to %.6f\n", (double)previous, (double)t);
+			ok = false;
+		}
+		previous = t;
+	}
+	if (ok && (filter.move_filter.moving || t != 0.0f)) {
+		fprintf(stderr, "turn-around: ended on t %.9f moving %d\n", (double)t, filter.move_filter.moving);
+		ok = false;
+	}
+	printf("%-24s %7" PRIu64 " frames back%s\n", scenario.name, frames, ok ? "" : " FAILED");
+
+	move_filter_destroy(&filter.move_filter);
+	obs_data_release(settings);
+	fake_obs_reset();
+	if (bnum_allocs() != allocs) {
+		fprintf(stderr, "turn-around: %ld allocations leaked\n", bnum_allocs() - allocs);
+		ok = false;
+	}
+	return ok;
+}
+
+// ticks many looping filters over a few seconds of 60 fps video with some jitter
+static bool bench(size_t count)
+{
+	fake_obs_reset();
+	rng_state = count;
+	const long allocs = bnum_allocs();
+
+	obs_source_t *parent = fake_source_create("color_source", "Source", OBS_SOURCE_TYPE_INPUT, NULL);
+	struct tick_filter *filters = calloc(count, sizeof(struct tick_filter));
+	char name[64];
+	for (size_t i = 0; i < count; i++) {
+		const struct tick_scenario scenario = {NULL, 60, 1, 300 + rng_next() % 2000, 0, 0, LOOP_MODE_PING_PONG, 0,
+						       false, false, 0, 0};
+		obs_data_t *settings = tick_settings(&scenario, "");
+		snprintf(name, sizeof(name), "Move %zu", i);
+		tick_filter_create(&filters[i], parent, name, settings, true);
+		obs_data_release(settings);
+	}
+
+	const uint64_t interval = 1000000000ULL / 60;
+	fake_obs_set_video_frame_time(FRAME_BASE);
+	for (size_t i = 0; i < count; i++) {
+		float t;
+		tick_filter_tick(&filters[i], 0.0f, &t);
+		move_filter_start(&filters[i].move_filter);
+	}
+
+	const uint64_t alloc_calls = fake_obs_alloc_calls();
+	uint64_t produced = 0;
+	uint64_t elapsed = 0;
+	uint64_t best = UINT64_MAX;
+	for (uint64_t frame = 1; frame <= BENCH_FRAMES; frame++) {
+		fake_obs_set_video_frame_time(FRAME_BASE + frame * interval + rng_next() % (interval / 4));
+		const uint64_t start = now_ns();
+		for (size_t i = 0; i < count; i++) {
+			float t;
+			if (tick_filter_tick(&filters[i], (float)interval / 1000000000.0f, &t))
+				produced++;
+		}
+		const uint64_t frame_ns = now_ns() - start;
+		elapsed += frame_ns;
+		if (frame_ns < best)
+			best = frame_ns;
+	}
+	const uint64_t tick_allocs = fake_obs_alloc_calls() - alloc_calls;
+
+	bool ok = true;
+	if (produced != (uint64_t)count * BENCH_FRAMES) {
+		fprintf(stderr, "%zu filters: %" PRIu64 " of %" PRIu64 " ticks produced a t\n", count, produced,
+			(uint64_t)count * BENCH_FRAMES);
+		ok = false;
+	}
+	if (tick_allocs) {
+		fprintf(stderr, "%zu filters: ticks made %" PRIu64 " allocations\n", count, tick_allocs);
+		ok = false;
+	}
+	printf("%6zu filters: %.1f ns per tick, %.1f us per frame (best %.1f us), %" PRIu64 " allocations%s\n", count,
+	       (double)elapsed / (double)(count * BENCH_FRAMES), (double)elapsed / BENCH_FRAMES / 1000.0, (double)best / 1000.0,
+	       tick_allocs, ok ? "" : " FAILED");
+
+	for (size_t i = 0; i < count; i++)
+		move_filter_destroy(&filters[i].move_filter);
+	free(filters);
+	fake_obs_reset();
+	if (bnum_allocs() != allocs) {
+		fprintf(stderr, "%zu filters: %ld allocations leaked\n", count, bnum_allocs() - allocs);
+		ok = false;
+	}
+	return ok;
+}
+
+int main(int argc, char **argv)
+{
+	const char *curves_dir = NULL;
+	bool ok = true;
+	size_t sizes = 0;
+
+	pthread_mutex_init(&udp_servers_mutex, NULL);
+	move_filter_hotkeys_load();
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--curves") == 0 && i + 1 < argc)
+			curves_dir = argv[++i];
+	}
+	for (size_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++)
+		ok = run_scenario(&scenarios[i], curves_dir) && ok;
+	for (size_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++) {
+		if (scenarios[i].loop_mode == LOOP_MODE_PING_PONG)
+			ok = run_restart(&scenarios[i]) && ok;
+	}
+	ok = run_turn_around() && ok;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--curves") == 0) {
+			i++;
+			continue;
+		}
+		const size_t count = (size_t)strtoull(argv[i], NULL, 10);
+		if (!count) {
+			fprintf(stderr, "usage: %s [--curves dir] [filters...]\n", argv[0]);
+			return 2;
+		}
+		ok = bench(count) && ok;
+		sizes++;
+	}
+	if (!sizes)
+		ok = bench(10000) && ok;
+
+	move_filter_hotkeys_unload();
+	pthread_mutex_destroy(&udp_servers_mutex);
+	return ok ? 0 : 1;
+}